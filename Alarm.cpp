@@ -4,9 +4,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.1c
+ * @version  1.7
  * @created  22.1.2013
- * @update   04.06.2016 (Ergänzungen und Änderungen von A. Mueller)
+ * @update   19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
@@ -17,81 +17,26 @@
  * V 1.1b: - Kleinere Codeoptimierungen
  *         - Abfrage, ob Schlummermodus aktiv wurde hinzugefügt.
  * V 1.1c: - Funktionen für AlarmShowTimer hierher verlagert.
+ * V 1.2:  - Schlummerzeit kommt von den Settings (setSnoozeMinutes) statt aus dem EEPROM.
+ *         - Schlummermodus kann nach einem Neustart fortgesetzt werden (resumeSnooze).
+ * V 1.3:  - Melodien sind Ereignisfolgen (MelodyStream) und werden vom MelodyPlayer
+ *           im Timer1-Interrupt gespielt. Das Abspielen in pollAlarm() entfaellt.
+ * V 1.4:  - Ob eine Weckzeit erreicht ist, sagt der Zeitplan (Schedule). Ausschalten
+ *           des Wecktons laesst den Wecker scharf (fuer wiederkehrende Weckzeiten).
+ * V 1.5:  - pollLed() wird im Takt ALARM_LED_TICK aufgerufen (TaskScheduler) und zaehlt
+ *           die Aufrufe statt millis() zu vergleichen.
+ * V 1.6:  - Ein/Aus gilt nur fuer die Weckzeit aus dem Menue. Sie klingelt wieder nur
+ *           einmal, Ausschalten oder Ablauf des Wecktons schaltet sie ab.
+ * V 1.7:  - Die Weckmelodien stehen in AlarmMelodies.h (von tools/melodycheck.cpp geprueft).
  */
 #include "Alarm.h"
+#include "MelodyPlayer.h"
+#include "AlarmMelodies.h"
 
 //#define DEBUG
 #include "Debug.h"
 
-/*
- * Eigene Weckmelodien
- * *** 1. Eigene Tonfolgen definieren (in einem Feld melodyCustomX[].
- * *** 2. Gesamtzahl der eigenen Melodien in _numberOfCustomMelodies eintragen.
- * *** 3. Eigene Tonfolgen in Funktion registerAllCustomMelodies() registrieren. 
- */
- 
-// BEGINN der Definition der eigenen Melodien
-    /*
-     *  *** 1 ***
-     */
-    // Eigene Melodien werden nach folgendem Schema angegeben:
-    // Dauer: Ton aus (in ms), Dauer: Ton aus (in ms), wie oft die beiden vorherigen Werte gespielt werden (= Wiederholungen + 1)
-    // Beispiel: 500, 200, 4 (500ms Ton an, 200ms kein Ton, Tonfolge wird 3 Mal wiederholt, also 4 Mal gespielt)
-    const unsigned int melodyCustom1[] PROGMEM = {500, 200, 1, 100, 100, 3, 0, 1000, 1};
-    const unsigned int melodyCustom2[] PROGMEM = {500, 500, 10, 250, 250, 25, 100, 100, 1000};
-
-    /*
-     * *** 2 ***
-     */
-    const byte _numberOfCustomMelodies = 2; // Anzahl der eigenen Melodien eintragen
-
-    /*
-     * *** 3 ****
-     */
-    void Alarm::registerAllCustomMelodies() { // Hier die eigenen Melodien registrieren
-        registerCustomMelody(melodyCustom1, sizeof(melodyCustom1) / sizeof(unsigned int));
-        registerCustomMelody(melodyCustom2, sizeof(melodyCustom2) / sizeof(unsigned int));
-    }
-// ENDE der Definition der eigenen Melodien
-
-
-
-const unsigned int *_pCustomMelodiesArray[_numberOfCustomMelodies];
-byte _lengthOfCustomMelodies[_numberOfCustomMelodies];
-
-/*
- * Standardmelodien
- */
-const unsigned int melodies[][7] PROGMEM = {
-     /*
-      * { 
-      *   Dauer: Ton an (wiederholt) in ms,
-      *   Dauer: Ton aus (wiederholt) in ms,
-      *   Anzahl Wiederholungen der beiden vorherigen Werte,
-      *   Dauer: Ton an (wiederholt) in ms,
-      *   Dauer: Ton aus (wiederholt) in ms,
-      *   Anzahl Spielhäufigkeit der beiden vorherigen Werte (= Wiederholungen + 1),
-      *   Anzahl Spielhäufigkeit der kompletten Tonfolge (= Gesamtwiederholungen + 1),
-      * }
-      */ 
-     // Ton wird schneller
-     {200, 2800, 1, 0, 0, 1,  5},
-     {200, 1300, 1, 0, 0, 1, 10},
-     {200, 800,  1, 0, 0, 1, 15},
-     {200, 300,  1, 0, 0, 1, 30},
-     {100, 200,  1, 0, 0, 1, 40},
-     {100, 100,  1, 0, 0, 1, 60},
-     {0, 1000, 1, 200, 800, 1, 1}
-
-     // Alternative Definition: Ton kommt immer öfter
-//     {200, 100,  1, 0, 1700, 1, 10},
-//     {200, 100,  2, 0, 1500, 1, 10},
-//     {200, 100,  3, 0, 1100, 1, 10},
-//     {200, 100,  4, 0,  800, 1, 10},
-//     {200, 100,  1, 0,    0, 1, 30},
-//     {0, 1000, 1, 200, 1800, 1, 1}
-
-};
+#define ALARM_MAX_MELODY (sizeof(alarmMelodies) / sizeof(alarmMelodies[0]) - 1)
 
 /**
  * Konstruktor.
@@ -99,29 +44,20 @@ const unsigned int melodies[][7] PROGMEM = {
  * @param speakerPin Der Pin, an dem der Lautsprecher oder Buzzer haengt.
  */
 Alarm::Alarm(byte minutes, byte hours) : TimeStamp(minutes, hours) {
-    _lastLedChange = 0;
-    _posCustomMelodiesArray = 0;
-    registerAllCustomMelodies();
+    _ledTicks = 0;
+    _snoozeMinutes = SNOOZE_TIME_IN_MINUTES;
+    _melody = 0;
+    _isEnable = false;
+    _isOnce = false;
     deactivate();
 }
 
 void Alarm::speakerPin(byte speakerPin) {
-    _speakerPin = speakerPin;
-    pinMode(_speakerPin, OUTPUT);
-}
-
-/**
- * Eigene Melodien in die Liste verfügbarer
- * und auswählebarer Melodien mit aufnehmen
- */
-void Alarm::registerCustomMelody(const unsigned int *pCustomMelody, byte length) {
-    _pCustomMelodiesArray[_posCustomMelodiesArray] = pCustomMelody;
-    _lengthOfCustomMelodies[_posCustomMelodiesArray] = length;
-    _posCustomMelodiesArray++;
+    melodyPlayer.begin(speakerPin);
 }
 
 /**
- * Steuert das Leucht-/Blinkverhalten der Alarm-LED
+ * Steuert das Leucht-/Blinkverhalten der Alarm-LED. Wird alle ALARM_LED_TICK ms aufgerufen.
  */
 boolean Alarm::pollLed(boolean isStdModeAlarm) { 
     byte _ledBlinkMode;
@@ -143,15 +79,15 @@ boolean Alarm::pollLed(boolean isStdModeAlarm) {
                 _ledState = true;
                 break;
         case 2: // Langsames Blinken waehrend Alarmzeit eingestellt wird
-                if (millis() - _lastLedChange >= (unsigned long) 1000 / ALARM_LED_FREQ_SET_ALARM) {
+                if (++_ledTicks >= 1000 / ALARM_LED_TICK / ALARM_LED_FREQ_SET_ALARM) {
                     _ledState = !_ledState;
-                    _lastLedChange = millis();
+                    _ledTicks = 0;
                 }
                 break;
         case 3: // Schnelles Blinken waehrend Snooze aktiv
-                if (millis() - _lastLedChange >= (unsigned long) 1000 / ALARM_LED_FREQ_SNOOZE) {
+                if (++_ledTicks >= 1000 / ALARM_LED_TICK / ALARM_LED_FREQ_SNOOZE) {
                     _ledState = !_ledState;
-                    _lastLedChange = millis();
+                    _ledTicks = 0;
                 }
                 break;
     }
@@ -163,9 +99,9 @@ void Alarm::toggleEnable() {
 }
 
 void Alarm::setEnable(boolean isEnable) {
-    _isEnable = isEnable;
-    if (!_isEnable)
+    if (!isEnable)
         deactivate();
+    _isEnable = isEnable;
 }
 
 boolean Alarm::isEnable() {
@@ -176,133 +112,43 @@ boolean Alarm::isEnable() {
  * Steuert das Verhalten des Alarms:
  * Aktivierung und Deaktivierung des Alarms und
  * Umschalten auf Snooze
+ *
+ * @param isDue TRUE, wenn der Zeitplan gerade eine Weckzeit gemeldet hat.
+ *        isOnce TRUE, wenn darunter die Weckzeit aus dem Menue ist. Dann wird
+ *        der Wecker nach dem Weckton abgeschaltet.
  */
-void Alarm::pollAlarm(unsigned int rtcMinutesOfDay) {
-    // Wenn Alarm aktiv, spiele Weckmelodie
+void Alarm::pollAlarm(boolean isDue, boolean isOnce) {
+    // Die Weckmelodie spielt der MelodyPlayer im Hintergrund.
     if (_isActive) {
-        playAlarmMelody();
         // Gesamtalarmdauer überschritten -> Alarm abschalten
         if (millis() - _alarmDuration >= (unsigned long) MAX_BUZZ_TIME_IN_MINUTES * 60000) {
             deactivate();
         }
     } else {
-        if (!_isSnooze)
-            // Prüfen, ob Weckzeit erreicht ist -> Alarm aktivieren
-            if ((getMinutesOfDay() == rtcMinutesOfDay) || (getMinutesOf12HoursDay() == rtcMinutesOfDay))
-                activate();
+        if (!_isSnooze && isDue) {
+            _isOnce = isOnce;
+            activate();
+        }
     }
     // Wenn Snooze-Modus aktiv, prüfe ob Snooze-Zeit abgelaufen ist 
-    // EEPROM.read(18) ist etwas hacky, aber da hier eh nicht mehr weiterentwickelt wird der geringste Aufwand
-    if (_isSnooze && (millis() - _snoozeTimer >= (unsigned long) EEPROM.read(18) * 60 * 1000)) {
+    if (_isSnooze && (millis() - _snoozeTimer >= (unsigned long) _snoozeMinutes * 60 * 1000)) {
         activate();   
         DEBUG_PRINTLN(F("Snooze-Alarm"));
     }
 }
 
-/**
- * Hilfsfunktion für die Funktion playAlarmMelody()
- */
-void Alarm::alarmMelodySubRepeat(const unsigned int *pMelody) {
-    if ( !((_melodyStep + 1) % 3) ) {
-          _melodySubIteration++;
-          if (_melodySubIteration >= pgm_read_word_near(&pMelody[_melodyStep])) {
-              _melodyStep++;
-              _melodySubIteration = 0;
-          } else {
-              _melodyStep -= 2;
-          }
-    }    
-}
-
-/**
- * Spielt den aktuellen Ton der ausgewählten Melodie
- * oder macht entsprechend lange Pause
- */
-void Alarm::playAlarmMelody() {
-    unsigned int _buzzStep;
-
-    if (_melody)
-        _localMelody = _melody - 1;
-
-    // Abspielen der Standardmelodien
-    if (_localMelody < sizeof(melodies)/sizeof(melodies[0])) {
-        // Einzelwiederholung (Ton an, Ton aus)
-        alarmMelodySubRepeat(melodies[_localMelody]);
-        
-        // Gesamtwiederholung der kompletten Tonfolge
-        if (_melodyStep == (sizeof(melodies[0])/sizeof(melodies[0][0])-1)) {
-            // Übergang zur nächsten Melodie, wenn a) Melodie 0 ausgewählt und b) Anzahl an Wiederholungen erfüllt
-            if (!_melody) {
-                _melodyIteration++;
-                if (_melodyIteration >= pgm_read_word_near(&melodies[_localMelody][_melodyStep])) {
-                    _localMelody++;
-                    if (_localMelody >= sizeof(melodies)/sizeof(melodies[0]))
-                        _localMelody--;
-                    _melodyIteration = 0;
-                }
-            }
-            _melodyStep = 0;
-        }  
-        _buzzStep = pgm_read_word_near(&melodies[_localMelody][_melodyStep]);
-    }
-    // Abspielen der eigenen Melodien
-    else {
-        if (_numberOfCustomMelodies) {                
-            _posCustomMelodiesArray = _localMelody - sizeof(melodies)/sizeof(melodies[0]);
-            // Einzelwiederholung (Ton an, Ton aus)
-            alarmMelodySubRepeat(_pCustomMelodiesArray[_posCustomMelodiesArray]);
-            
-            if (_melodyStep >= _lengthOfCustomMelodies[_posCustomMelodiesArray])
-                _melodyStep = 0;
-            _buzzStep = pgm_read_word_near(&_pCustomMelodiesArray[_posCustomMelodiesArray][_melodyStep]);
-
-/* 
- * Alternative für statische Angabe von individuellen Melodien 
- * (kein register erforderlich, damit etwas weniger Code, dafür aber mehr Aufwand für Anwender)
- */
-//        const byte _caseStart = sizeof(melodies)/sizeof(melodies[0]);
-//        switch(_melody) {
-//            case (_caseStart + 0): 
-//                    alarmMelodySubRepeat(melodyCustom1);
-//
-//                    if (_melodyStep >= sizeof(melodyCustom1)/sizeof(melodyCustom1[0]))
-//                        _melodyStep = 0;
-//                    _buzzStep = melodyCustom1[_melodyStep];
-//                    break;
-//        }
-
-        }
-    }
-
-    if (_turnBuzzOnNextCycle) {
-        _turnBuzzOnNextCycle = false;
-        if (_buzzStep > 0)
-            buzz(true);
-    }
-    
-    if (millis() - _buzzCycle >= _buzzStep) {
-        _lastBuzzState = !_lastBuzzState;
-        if (_lastBuzzState)
-            _turnBuzzOnNextCycle = true;
-        else
-            buzz(false);            
-        _buzzCycle = millis();
-        _melodyStep++;
-    }
-}
-
 byte Alarm::getAlarmMelody() {
     return _melody;
 }
 
 void Alarm::setAlarmMelody(byte melody) {
     _melody = melody;
-    if (_melody > (sizeof(melodies)/sizeof(melodies[0]) + _numberOfCustomMelodies))
+    if (_melody > ALARM_MAX_MELODY)
         _melody = 0;
 }
 
 void Alarm::incAlarmMelody() {
-    if (_melody < (sizeof(melodies)/sizeof(melodies[0]) + _numberOfCustomMelodies))
+    if (_melody < ALARM_MAX_MELODY)
         _melody++;
 }
 
@@ -316,40 +162,44 @@ void Alarm::decAlarmMelody() {
  * 
  */
 void Alarm::activateSnooze() {
-    deactivate();
+    _isActive = false;
+    melodyPlayer.stop();
     _snoozeTimer = millis();
-    _isEnable = true;
     _isSnooze = true;
 }
 
 /**
- * Ist der Wecker im Schlummermodus?
+ * Den Schlummermodus nach einem Neustart fortsetzen.
  *
- * @return TRUE, wenn der Schlummermodus aktiv ist.
- *         FALSE, wenn der Schlummermodus ausgeschaltet ist.
+ * @param elapsedMinutes Wie lange schlummert der Wecker schon?
  */
-boolean Alarm::isSnooze() {
-    return _isSnooze;
+void Alarm::resumeSnooze(unsigned int elapsedMinutes) {
+    activateSnooze();
+    _snoozeTimer -= (unsigned long) elapsedMinutes * 60000;
 }
 
 /**
- * Den Weckton einschalten.
+ * Wie lange schlummert der Wecker schon (in Minuten)?
+ */
+unsigned int Alarm::getSnoozeElapsedMinutes() {
+    return (millis() - _snoozeTimer) / 60000;
+}
+
+/**
+ * Die Schlummerzeit in Minuten (kommt aus den Settings).
+ */
+void Alarm::setSnoozeMinutes(byte snoozeMinutes) {
+    _snoozeMinutes = snoozeMinutes;
+}
+
+/**
+ * Ist der Wecker im Schlummermodus?
  *
- * @param: on - TRUE, der Ton wird eingeschaltet.
- *              FALSE, der Ton wird ausgeschaltet.
+ * @return TRUE, wenn der Schlummermodus aktiv ist.
+ *         FALSE, wenn der Schlummermodus ausgeschaltet ist.
  */
-void Alarm::buzz(boolean on) {
-#ifdef SPEAKER_IS_BUZZER
-    if (on)
-        digitalWrite(_speakerPin, HIGH);
-    else
-        digitalWrite(_speakerPin, LOW);
-#else
-    if (on)
-        tone(_speakerPin, SPEAKER_FREQUENCY);
-    else
-        noTone(_speakerPin);
-#endif
+boolean Alarm::isSnooze() {
+    return _isSnooze;
 }
 
 /**
@@ -368,26 +218,24 @@ boolean Alarm::isActive() {
 void Alarm::activate() {
     _isActive = true;
     _isSnooze = false;
-    _turnBuzzOnNextCycle = true;
-    _lastBuzzState = true;
-    _melodyIteration = 0;
-    _melodySubIteration = 0;
-    _melodyStep = 0;
-    _localMelody = 0;
-    _buzzCycle = millis();
-    _alarmDuration = _buzzCycle;
+    _alarmDuration = millis();
+    melodyPlayer.play((const uint16_t*) pgm_read_word_near(&alarmMelodies[_melody]));
     DEBUG_PRINTLN(F("Alarm aktiviert"));
 }
 
 /**
- * Den Wecker ausschalten.
+ * Den Weckton (und den Schlummermodus) ausschalten. Kam er von der Weckzeit
+ * aus dem Menue, wird der Wecker abgeschaltet, die weiteren Weckzeiten des
+ * Zeitplans bleiben scharf.
  */
 void Alarm::deactivate() {
-    _isEnable = false;
+    if (_isOnce) {
+        _isEnable = false;
+        _isOnce = false;
+    }
     _isActive = false;
     _isSnooze = false;
-    _lastBuzzState = false;
-    buzz(false);
+    melodyPlayer.stop();
     DEBUG_PRINTLN(F("Alarm deaktiviert"));
 }
 
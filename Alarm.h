@@ -4,9 +4,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.1c
+ * @version  1.6
  * @created  22.1.2013
- * @update   04.06.2016 (Ergänzungen und Änderungen von A. Mueller)
+ * @update   19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
@@ -17,6 +17,16 @@
  * V 1.1b: - Kleinere Codeoptimierungen
  *         - Abfrage, ob Schlummermodus aktiv wurde hinzugefügt.
  * V 1.1c: - Funktionen für AlarmShowTimer hierher verlagert.
+ * V 1.2:  - Schlummerzeit kommt von den Settings (setSnoozeMinutes) statt aus dem EEPROM.
+ *         - Schlummermodus kann nach einem Neustart fortgesetzt werden (resumeSnooze).
+ * V 1.3:  - Melodien sind Ereignisfolgen (MelodyStream) und werden vom MelodyPlayer
+ *           im Timer1-Interrupt gespielt. Das Abspielen in pollAlarm() entfaellt.
+ * V 1.4:  - Ob eine Weckzeit erreicht ist, sagt der Zeitplan (Schedule). Ausschalten
+ *           des Wecktons laesst den Wecker scharf (fuer wiederkehrende Weckzeiten).
+ * V 1.5:  - pollLed() wird im Takt ALARM_LED_TICK aufgerufen (TaskScheduler) und zaehlt
+ *           die Aufrufe statt millis() zu vergleichen.
+ * V 1.6:  - Ein/Aus gilt nur fuer die Weckzeit aus dem Menue. Sie klingelt wieder nur
+ *           einmal, Ausschalten oder Ablauf des Wecktons schaltet sie ab.
  */
 #ifndef ALARM_H
 #define ALARM_H
@@ -26,6 +36,9 @@
 #include "TimeStamp.h"
 #include <EEPROM.h>
 
+// In diesem Abstand (ms) wird pollLed() aufgerufen.
+#define ALARM_LED_TICK 100
+
 class Alarm : public TimeStamp {
 public:
     Alarm(byte minutes, byte hours);
@@ -33,7 +46,7 @@ public:
     void speakerPin(byte speakerPin);
     
     boolean pollLed(boolean isStdModeAlarm = false);
-    void pollAlarm(unsigned int rtcMinutesOfDay); 
+    void pollAlarm(boolean isDue, boolean isOnce);
     
     byte getAlarmMelody();
     void setAlarmMelody(byte melody);
@@ -45,44 +58,34 @@ public:
     boolean isEnable();
     void deactivate();
     void activateSnooze();
+    void resumeSnooze(unsigned int elapsedMinutes);
     boolean isSnooze();
+    unsigned int getSnoozeElapsedMinutes();
+    void setSnoozeMinutes(byte snoozeMinutes);
     
     boolean isActive();
 
-    void buzz(boolean on);
-
     void updateShowAlarmTimer(boolean isModeAlarm);
     boolean getShowAlarmTimer();
     void resetShowAlarmTimer();
 
 private:
-    void registerAllCustomMelodies();
-    void registerCustomMelody(const unsigned int *pCustomMelody, byte length);
-    void alarmMelodySubRepeat(const unsigned int *pMelody);
-    void playAlarmMelody();
     void activate();
 
-    byte _speakerPin;
     boolean _ledState;
     
     boolean _isEnable;
     boolean _isActive;
     boolean _isSnooze;
+    // Der Weckton kommt von der Weckzeit aus dem Menue (einmalig).
+    boolean _isOnce;
     
     unsigned long _alarmDuration;
     unsigned long _snoozeTimer;
-    unsigned long _lastLedChange;
-    unsigned long _buzzCycle;
-
-    boolean _lastBuzzState;
-    boolean _turnBuzzOnNextCycle;
+    byte _snoozeMinutes;
+    byte _ledTicks;
     
     byte _melody;
-    byte _localMelody;
-    byte _melodyStep;
-    byte _melodySubIteration;
-    byte _melodyIteration; 
-    byte _posCustomMelodiesArray;
 
     byte showAlarmTimer;
 };
@@ -0,0 +1,64 @@
+/**
+ * AlarmMelodies
+ * Die Weckmelodien. Die Melodien sind Folgen von MELODY_TONE(ms), MELODY_REST(ms)
+ * und MELODY_REPEAT(Anzahl, zurueck) (siehe MelodyStream.h). Mit
+ * MELODY_REPEAT(0, zurueck) spielt die Melodie endlos.
+ * Die Datei wird nur von Alarm.cpp eingebunden und von tools/melodycheck.cpp,
+ * das die Melodien auf dem PC abspielt und prueft.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt (aus Alarm.cpp).
+ */
+#ifndef ALARMMELODIES_H
+#define ALARMMELODIES_H
+
+#include "MelodyStream.h"
+
+// Melodie 0: Ton wird schneller (jede Stufe wird Anzahl Mal gespielt, die letzte endlos)
+const uint16_t melodyFaster[] PROGMEM = {
+    MELODY_TONE(200), MELODY_REST(2800), MELODY_REPEAT(5, 2),
+    MELODY_TONE(200), MELODY_REST(1300), MELODY_REPEAT(10, 2),
+    MELODY_TONE(200), MELODY_REST(800), MELODY_REPEAT(15, 2),
+    MELODY_TONE(200), MELODY_REST(300), MELODY_REPEAT(30, 2),
+    MELODY_TONE(100), MELODY_REST(200), MELODY_REPEAT(40, 2),
+    MELODY_TONE(100), MELODY_REST(100), MELODY_REPEAT(60, 2),
+    MELODY_REST(1000), MELODY_TONE(200), MELODY_REST(800), MELODY_REPEAT(0, 3)
+};
+
+// Melodien 1 bis 7: die einzelnen Stufen endlos
+const uint16_t melodyStep1[] PROGMEM = {MELODY_TONE(200), MELODY_REST(2800), MELODY_REPEAT(0, 2)};
+const uint16_t melodyStep2[] PROGMEM = {MELODY_TONE(200), MELODY_REST(1300), MELODY_REPEAT(0, 2)};
+const uint16_t melodyStep3[] PROGMEM = {MELODY_TONE(200), MELODY_REST(800), MELODY_REPEAT(0, 2)};
+const uint16_t melodyStep4[] PROGMEM = {MELODY_TONE(200), MELODY_REST(300), MELODY_REPEAT(0, 2)};
+const uint16_t melodyStep5[] PROGMEM = {MELODY_TONE(100), MELODY_REST(200), MELODY_REPEAT(0, 2)};
+const uint16_t melodyStep6[] PROGMEM = {MELODY_TONE(100), MELODY_REST(100), MELODY_REPEAT(0, 2)};
+const uint16_t melodyStep7[] PROGMEM = {MELODY_REST(1000), MELODY_TONE(200), MELODY_REST(800), MELODY_REPEAT(0, 3)};
+
+// BEGINN der Definition der eigenen Melodien
+// Eigene Melodien hier definieren und unten in alarmMelodies[] eintragen.
+const uint16_t melodyCustom1[] PROGMEM = {
+    MELODY_TONE(500), MELODY_REST(200),
+    MELODY_TONE(100), MELODY_REST(100), MELODY_REPEAT(3, 2),
+    MELODY_REST(1000), MELODY_REPEAT(0, 6)
+};
+const uint16_t melodyCustom2[] PROGMEM = {
+    MELODY_TONE(500), MELODY_REST(500), MELODY_REPEAT(10, 2),
+    MELODY_TONE(250), MELODY_REST(250), MELODY_REPEAT(25, 2),
+    MELODY_TONE(100), MELODY_REST(100), MELODY_REPEAT(100, 2), MELODY_REPEAT(10, 3),
+    MELODY_REPEAT(0, 10)
+};
+// ENDE der Definition der eigenen Melodien
+
+const uint16_t* const alarmMelodies[] PROGMEM = {
+    melodyFaster,
+    melodyStep1, melodyStep2, melodyStep3, melodyStep4, melodyStep5, melodyStep6, melodyStep7,
+    melodyCustom1, melodyCustom2
+};
+
+#endif
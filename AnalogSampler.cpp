@@ -0,0 +1,176 @@
+/**
+ * AnalogSampler
+ * Liest die analogen Eingaenge im Hintergrund. Der ADC wird vom Ueberlauf
+ * des Timer0 (alle 1,024ms) gestartet, die fertige Wandlung landet im
+ * ADC-Interrupt. Dort wird pro Kanal ein Median aus 3 Werten gebildet und
+ * mit einem Festkomma-Tiefpass (IIR) geglaettet. Die Abfrage ist dann nur
+ * noch ein Lesen der Variablen, loop() wartet nie auf den ADC.
+ * Die Kanaele werden reihum gewandelt.
+ *
+ * Solange der AnalogSampler laeuft, darf analogRead() nicht benutzt werden.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "AnalogSampler.h"
+#include <avr/interrupt.h>
+
+// #define DEBUG
+#include "Debug.h"
+
+AnalogSampler analogSampler;
+
+ISR(ADC_vect) {
+    analogSampler.onConversion(ADC);
+}
+
+/**
+ * Einen analogen Eingang anmelden.
+ *
+ * @param pin Der Pin (A0..A7).
+ * @param filterShift Staerke des Tiefpasses. Jeder neue Wert geht mit
+ *                    1/2^filterShift ein (0 = ungefiltert).
+ */
+void AnalogSampler::addChannel(byte pin, byte filterShift) {
+    if ((_channelForPin(pin) != 0xFF) || (_count >= ANALOG_SAMPLER_MAX_CHANNELS)) {
+        return;
+    }
+    _pin[_count] = pin;
+    _filterShift[_count] = filterShift;
+    _samples[_count] = 0;
+    _count++;
+}
+
+/**
+ * Den ADC starten. Ausloeser ist der Ueberlauf von Timer0,
+ * der fuer millis() ohnehin laeuft.
+ */
+void AnalogSampler::begin() {
+    if (_count == 0) {
+        return;
+    }
+    _current = 0;
+    _selectChannel(0);
+    // Ausloeser: Timer/Counter0 Overflow
+    ADCSRB = _BV(ADTS2);
+    // Einschalten, Auto-Trigger, Interrupt, Vorteiler 128 (125kHz bei 16MHz)
+    ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADIF) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+}
+
+/**
+ * Gibt es schon einen Wert fuer den Pin?
+ */
+boolean AnalogSampler::isReady(byte pin) {
+    byte channel = _channelForPin(pin);
+    return (channel != 0xFF) && (_samples[channel] != 0);
+}
+
+/**
+ * Der gefilterte Wert (0..1023).
+ */
+unsigned int AnalogSampler::getValue(byte pin) {
+    byte channel = _channelForPin(pin);
+    if (channel == 0xFF) {
+        return 0;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    unsigned int val = _filtered[channel];
+    SREG = oldSREG;
+    return (val + 32) >> 6;
+}
+
+/**
+ * Der letzte ungefilterte Wert (0..1023), z. B. fuer Flanken.
+ */
+unsigned int AnalogSampler::getRaw(byte pin) {
+    byte channel = _channelForPin(pin);
+    if (channel == 0xFF) {
+        return 0;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    unsigned int val = _raw[channel][0];
+    SREG = oldSREG;
+    return val;
+}
+
+/**
+ * Eine Wandlung ist fertig (im ADC-Interrupt). Die naechste Wandlung
+ * startet erst mit dem naechsten Timer0-Ueberlauf, der Kanal kann also
+ * hier gefahrlos umgeschaltet werden.
+ */
+void AnalogSampler::onConversion(unsigned int sample) {
+    byte c = _current;
+    _raw[c][2] = _raw[c][1];
+    _raw[c][1] = _raw[c][0];
+    _raw[c][0] = sample;
+
+    if (_samples[c] < 3) {
+        // Ohne Vorgeschichte direkt uebernehmen, dann ist kein Einschwingen noetig.
+        _samples[c]++;
+        _filtered[c] = sample << 6;
+    } else {
+        // Median aus 3 gegen Ausreisser...
+        unsigned int a = _raw[c][0];
+        unsigned int b = _raw[c][1];
+        unsigned int m = _raw[c][2];
+        if (a > b) {
+            unsigned int t = a;
+            a = b;
+            b = t;
+        }
+        if (m < a) {
+            m = a;
+        } else if (m > b) {
+            m = b;
+        }
+        // ...und Tiefpass: f += (m - f) / 2^shift
+        unsigned int target = m << 6;
+        unsigned int f = _filtered[c];
+        if (target > f) {
+            f += (target - f) >> _filterShift[c];
+        } else {
+            f -= (f - target) >> _filterShift[c];
+        }
+        _filtered[c] = f;
+    }
+
+    c++;
+    if (c >= _count) {
+        c = 0;
+    }
+    if (c != _current) {
+        _current = c;
+        _selectChannel(c);
+    }
+}
+
+/**
+ * Den Kanal eines Pins suchen (0xFF = nicht angemeldet).
+ */
+byte AnalogSampler::_channelForPin(byte pin) {
+    for (byte i = 0; i < _count; i++) {
+        if (_pin[i] == pin) {
+            return i;
+        }
+    }
+    return 0xFF;
+}
+
+/**
+ * Den Multiplexer auf einen Kanal stellen (Referenz AVcc).
+ */
+void AnalogSampler::_selectChannel(byte channel) {
+    byte pin = _pin[channel];
+    if (pin >= A0) {
+        pin -= A0;
+    }
+    ADMUX = _BV(REFS0) | (pin & 0x07);
+}
@@ -0,0 +1,59 @@
+/**
+ * AnalogSampler
+ * Liest die analogen Eingaenge im Hintergrund. Der ADC wird vom Ueberlauf
+ * des Timer0 (alle 1,024ms) gestartet, die fertige Wandlung landet im
+ * ADC-Interrupt. Dort wird pro Kanal ein Median aus 3 Werten gebildet und
+ * mit einem Festkomma-Tiefpass (IIR) geglaettet. Die Abfrage ist dann nur
+ * noch ein Lesen der Variablen, loop() wartet nie auf den ADC.
+ * Die Kanaele werden reihum gewandelt.
+ *
+ * Solange der AnalogSampler laeuft, darf analogRead() nicht benutzt werden.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef ANALOGSAMPLER_H
+#define ANALOGSAMPLER_H
+
+#include "Arduino.h"
+
+#define ANALOG_SAMPLER_MAX_CHANNELS 3
+
+class AnalogSampler {
+public:
+    void addChannel(byte pin, byte filterShift);
+    void begin();
+
+    boolean isReady(byte pin);
+    unsigned int getValue(byte pin);
+    unsigned int getRaw(byte pin);
+
+    // Nur fuer die Interrupt-Routine
+    void onConversion(unsigned int sample);
+
+private:
+    // Kein Konstruktor: das Objekt ist dann schon vor allen anderen globalen
+    // Objekten mit 0 initialisiert und addChannel() kann aus deren Konstruktoren
+    // aufgerufen werden.
+    byte _pin[ANALOG_SAMPLER_MAX_CHANNELS];
+    byte _filterShift[ANALOG_SAMPLER_MAX_CHANNELS];
+    volatile unsigned int _raw[ANALOG_SAMPLER_MAX_CHANNELS][3];
+    // Gefilterter Wert mit 6 Nachkommabits (0..1023 << 6)
+    volatile unsigned int _filtered[ANALOG_SAMPLER_MAX_CHANNELS];
+    volatile byte _samples[ANALOG_SAMPLER_MAX_CHANNELS];
+    byte _count;
+    byte _current;
+
+    byte _channelForPin(byte pin);
+    void _selectChannel(byte channel);
+};
+
+extern AnalogSampler analogSampler;
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * BinaryLog
+ * Schreibt Log-Eintraege (Nummer, Zeit, Argumente) als kurze Binaer-Datensaetze
+ * in den Sendepuffer von Serial, den der Interrupt der UART im Hintergrund
+ * leert. Passt ein Eintrag nicht mehr in den Puffer, wird er verworfen und
+ * gezaehlt, die Anzahl kommt mit dem naechsten Eintrag (LOG_DROPPED). So
+ * blockiert das Loggen nie. Die Texte stehen in LogMessages.h, nicht im Flash.
+ *
+ * Datensatz: LOG_SYNC, Nummer, Zeit (millis(), 16 Bit), Laenge, Argumente.
+ * LOG_SYNC kommt in Text nicht vor, Text-Ausgaben (DEBUG_PRINT) koennen also
+ * dazwischen stehen.
+ *
+ * Ohne DEBUG_BINARY_LOG werden die Eintraege wie bisher als Text ausgegeben.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "BinaryLog.h"
+
+BinaryLog binaryLog;
+
+#ifndef DEBUG_BINARY_LOG
+/**
+ * Die Texte, nur fuer die Ausgabe als Text.
+ */
+#define LOG_MESSAGE(id, text) const char id##_TEXT[] PROGMEM = text;
+#include "LogMessages.h"
+#undef LOG_MESSAGE
+
+const char* const logTexts[] PROGMEM = {
+#define LOG_MESSAGE(id, text) id##_TEXT,
+#include "LogMessages.h"
+#undef LOG_MESSAGE
+};
+#endif
+
+BinaryLog::BinaryLog() {
+    _dropped = 0;
+}
+
+/**
+ * Einen Eintrag schreiben. Die Argumente sind 16 Bit (int) oder Bytes, siehe LogMessages.h.
+ */
+void BinaryLog::write(byte id, const void* data, byte length) {
+#ifdef DEBUG_BINARY_LOG
+    byte needed = LOG_HEADER_LENGTH + length;
+    if (_dropped) {
+        needed += LOG_HEADER_LENGTH + sizeof(_dropped);
+    }
+    if (Serial.availableForWrite() < needed) {
+        if (_dropped < 0xFFFF) {
+            _dropped++;
+        }
+        return;
+    }
+    if (_dropped) {
+        _put(LOG_DROPPED, &_dropped, sizeof(_dropped));
+        _dropped = 0;
+    }
+    _put(id, data, length);
+#else
+    _print(id, (const byte*) data, length);
+#endif
+}
+
+/**
+ * Wie viele Eintraege seit dem letzten gemeldeten Verwerfen verloren sind.
+ */
+word BinaryLog::getDropped() {
+    return _dropped;
+}
+
+void BinaryLog::_put(byte id, const void* data, byte length) {
+    word now = millis();
+    Serial.write(LOG_SYNC);
+    Serial.write(id);
+    Serial.write(lowByte(now));
+    Serial.write(highByte(now));
+    Serial.write(length);
+    Serial.write((const uint8_t*) data, length);
+}
+
+/**
+ * Den Eintrag als Text ausgeben (ohne DEBUG_BINARY_LOG).
+ */
+void BinaryLog::_print(byte id, const byte* data, byte length) {
+#ifndef DEBUG_BINARY_LOG
+    const char* text = (const char*) pgm_read_ptr_near(&logTexts[id]);
+    byte pos = 0;
+    char c;
+    while ((c = pgm_read_byte_near(text++))) {
+        if (c != '%') {
+            Serial.print(c);
+            continue;
+        }
+        c = pgm_read_byte_near(text++);
+        int arg = 0;
+        if ((c == 'd') || (c == 'u') || (c == 'x')) {
+            if (pos + 1 < length) {
+                arg = data[pos] | (data[pos + 1] << 8);
+            }
+            pos += 2;
+        }
+        switch (c) {
+            case 'd':
+                Serial.print(arg);
+                break;
+            case 'u':
+                Serial.print((word) arg);
+                break;
+            case 'x':
+                Serial.print((word) arg, HEX);
+                break;
+            case 'W':
+                for (; pos + 1 < length; pos += 2) {
+                    Serial.print((word) (data[pos] | (data[pos + 1] << 8)));
+                    Serial.print(' ');
+                }
+                break;
+            case 'B':
+                for (; pos < length; pos++) {
+                    Serial.print(data[pos], HEX);
+                    Serial.print(' ');
+                }
+                break;
+            case 'P':
+                for (; pos < length; pos++) {
+                    for (byte i = 0; i < 8; i++) {
+                        Serial.print((data[pos] >> i) & 1);
+                    }
+                }
+                break;
+            case 0:
+                return;
+            default:
+                Serial.print(c);
+                break;
+        }
+    }
+    Serial.println();
+#endif
+}
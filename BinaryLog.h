@@ -0,0 +1,60 @@
+/**
+ * BinaryLog
+ * Schreibt Log-Eintraege (Nummer, Zeit, Argumente) als kurze Binaer-Datensaetze
+ * in den Sendepuffer von Serial, den der Interrupt der UART im Hintergrund
+ * leert. Passt ein Eintrag nicht mehr in den Puffer, wird er verworfen und
+ * gezaehlt, die Anzahl kommt mit dem naechsten Eintrag (LOG_DROPPED). So
+ * blockiert das Loggen nie. Die Texte stehen in LogMessages.h, nicht im Flash.
+ *
+ * Datensatz: LOG_SYNC, Nummer, Zeit (millis(), 16 Bit), Laenge, Argumente.
+ * LOG_SYNC kommt in Text nicht vor, Text-Ausgaben (DEBUG_PRINT) koennen also
+ * dazwischen stehen.
+ *
+ * Ohne DEBUG_BINARY_LOG werden die Eintraege wie bisher als Text ausgegeben.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef BINARYLOG_H
+#define BINARYLOG_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+#define LOG_SYNC          0xFE
+#define LOG_HEADER_LENGTH 5
+
+/**
+ * Die Nummern der Eintraege.
+ */
+enum {
+#define LOG_MESSAGE(id, text) id,
+#include "LogMessages.h"
+#undef LOG_MESSAGE
+    LOG_MESSAGES
+};
+
+class BinaryLog {
+public:
+    BinaryLog();
+
+    void write(byte id, const void* data, byte length);
+
+    word getDropped();
+
+private:
+    word _dropped;
+
+    void _put(byte id, const void* data, byte length);
+    void _print(byte id, const byte* data, byte length);
+};
+
+extern BinaryLog binaryLog;
+
+#endif
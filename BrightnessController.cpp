@@ -0,0 +1,128 @@
+/**
+ * BrightnessController
+ * Fuehrt die Helligkeit des Displays zeitbasiert auf einen Sollwert (LDR oder
+ * manuelle Helligkeit) nach. Die Geschwindigkeit ist in Prozent pro Sekunde
+ * begrenzt, kleine Abweichungen werden weich angefahren. Gerechnet wird in
+ * Festkomma (1/256 Prozent). Vor dem LED-Treiber kann eine Kennlinie liegen,
+ * die die Prozentwerte an das Helligkeitsempfinden anpasst (BRIGHTNESS_PERCEPTUAL_CURVE).
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.3
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Groessere Aenderungen des Sollwerts kommen in den EventTrace.
+ * V 1.2:  - needsUpdate() entfaellt, den Takt (LDR_CHECK_RATE) gibt der TaskScheduler vor.
+ * V 1.3:  - Die Kennlinie (BRIGHTNESS_PERCEPTUAL_CURVE) ist nicht mehr Default, sie
+ *           macht kleine Stufen gleich und gespeicherte Helligkeiten dunkler.
+ */
+#include "BrightnessController.h"
+#include "EventTrace.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+// Ab dieser Aenderung des Sollwerts (Prozent) wird er in den EventTrace eingetragen
+#define BRIGHTNESS_TRACE_STEP 5
+
+/**
+ * Initialisierung.
+ *
+ * @param ledDriver Der LED-Treiber, der die Helligkeit bekommt.
+ */
+BrightnessController::BrightnessController(LedDriver* ledDriver) {
+    _ledDriver = ledDriver;
+    _current = 0;
+    _output = 0xFF;
+    _lastUpdate = 0;
+    _tracedTarget = 0;
+}
+
+/**
+ * Die Helligkeit ohne Uebergang setzen (beim Start).
+ */
+void BrightnessController::begin(byte brightnessInPercent) {
+    _current = (unsigned int) brightnessInPercent << 8;
+    _lastUpdate = millis();
+    _write();
+}
+
+/**
+ * Einen Schritt Richtung Sollwert machen, alle LDR_CHECK_RATE ms (der Abstand
+ * haengt davon ab, wie teuer setBrightness() fuer den LED-Treiber ist). Der Schritt ist proportional zur
+ * Abweichung (Zeitkonstante BRIGHTNESS_SMOOTHING_MS), aber hoechstens
+ * BRIGHTNESS_SLEW_RATE Prozent pro Sekunde und mindestens 1/256 Prozent.
+ *
+ * @param targetInPercent Der Sollwert.
+ */
+void BrightnessController::update(byte targetInPercent) {
+    unsigned long now = millis();
+    unsigned long dt = now - _lastUpdate;
+    _lastUpdate = now;
+    if (dt > 1000) {
+        dt = 1000;
+    }
+
+    if (abs((int) targetInPercent - (int) _tracedTarget) >= BRIGHTNESS_TRACE_STEP) {
+        _tracedTarget = targetInPercent;
+        TRACE(TRACE_BRIGHTNESS, targetInPercent);
+    }
+
+    unsigned int target = (unsigned int) targetInPercent << 8;
+    if (target == _current) {
+        return;
+    }
+    unsigned int diff = (target > _current) ? (target - _current) : (_current - target);
+
+    unsigned long step = ((unsigned long) diff * dt) / BRIGHTNESS_SMOOTHING_MS;
+    unsigned long maxStep = ((unsigned long) BRIGHTNESS_SLEW_RATE * 256 * dt) / 1000;
+    if (step > maxStep) {
+        step = maxStep;
+    }
+    if (step == 0) {
+        step = 1;
+    }
+    if (step > diff) {
+        step = diff;
+    }
+
+    if (target > _current) {
+        _current += step;
+    } else {
+        _current -= step;
+    }
+    _write();
+}
+
+/**
+ * Die aktuelle Helligkeit in Prozent (vor der Kennlinie).
+ */
+byte BrightnessController::getBrightness() {
+    return (_current + 128) >> 8;
+}
+
+/**
+ * Den Ist-Wert ueber die Kennlinie an den LED-Treiber geben,
+ * aber nur, wenn sich etwas geaendert hat.
+ */
+void BrightnessController::_write() {
+    unsigned int percent = (_current + 128) >> 8;
+#ifdef BRIGHTNESS_PERCEPTUAL_CURVE
+    // Quadratische Kennlinie (Gamma 2), kleine Werte bleiben sichtbar.
+    unsigned int out = (percent * percent + 99) / 100;
+#else
+    unsigned int out = percent;
+#endif
+    if (out != _output) {
+        _output = out;
+        DEBUG_PRINT(F("Brightness: "));
+        DEBUG_PRINT(percent);
+        DEBUG_PRINT(F(" -> "));
+        DEBUG_PRINTLN(out);
+        DEBUG_FLUSH();
+        _ledDriver->setBrightness(out);
+    }
+}
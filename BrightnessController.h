@@ -0,0 +1,50 @@
+/**
+ * BrightnessController
+ * Fuehrt die Helligkeit des Displays zeitbasiert auf einen Sollwert (LDR oder
+ * manuelle Helligkeit) nach. Die Geschwindigkeit ist in Prozent pro Sekunde
+ * begrenzt, kleine Abweichungen werden weich angefahren. Gerechnet wird in
+ * Festkomma (1/256 Prozent). Vor dem LED-Treiber kann eine Kennlinie liegen,
+ * die die Prozentwerte an das Helligkeitsempfinden anpasst (BRIGHTNESS_PERCEPTUAL_CURVE).
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.3
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Groessere Aenderungen des Sollwerts kommen in den EventTrace.
+ * V 1.2:  - needsUpdate() entfaellt, den Takt (LDR_CHECK_RATE) gibt der TaskScheduler vor.
+ * V 1.3:  - Die Kennlinie (BRIGHTNESS_PERCEPTUAL_CURVE) ist nicht mehr Default, sie
+ *           macht kleine Stufen gleich und gespeicherte Helligkeiten dunkler.
+ */
+#ifndef BRIGHTNESSCONTROLLER_H
+#define BRIGHTNESSCONTROLLER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "LedDriver.h"
+
+class BrightnessController {
+public:
+    BrightnessController(LedDriver* ledDriver);
+
+    void begin(byte brightnessInPercent);
+    void update(byte targetInPercent);
+
+    byte getBrightness();
+
+private:
+    LedDriver* _ledDriver;
+    // Ist-Wert in 1/256 Prozent
+    unsigned int _current;
+    byte _output;
+    unsigned long _lastUpdate;
+    // Der zuletzt in den EventTrace eingetragene Sollwert
+    byte _tracedTarget;
+
+    void _write();
+};
+
+#endif
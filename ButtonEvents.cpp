@@ -0,0 +1,254 @@
+/**
+ * ButtonEvents
+ * Interrupt-gesteuerte Tastenabfrage. Die Tasten werden per Pin-Change-Interrupt
+ * entprellt und legen Ereignisse (Druecken, Loslassen, langer Druck, Wiederholung)
+ * mit Zeitstempel in eine Warteschlange, die loop() abarbeitet. Die Fernbedienung
+ * legt ihre Tasten in dieselbe Warteschlange.
+ * Fuer langen Druck, Wiederholung und das Ende der Entprellzeit laeuft ein 1ms-Takt
+ * (Timer0 Compare B), aber nur solange eine Taste gedrueckt ist oder prellt.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - addButton() meldet, ob der Pin-Change-Interrupt angemeldet wurde.
+ */
+#include "ButtonEvents.h"
+#include "PinChangeInterrupt.h"
+#include <avr/interrupt.h>
+
+// #define DEBUG
+#include "Debug.h"
+
+// Zustand einer Taste (_flags)
+#define BUTTON_FLAG_DOWN     0x01 // entprellter Zustand: gedrueckt
+#define BUTTON_FLAG_SETTLING 0x02 // innerhalb der Entprellzeit, Flanken werden ignoriert
+#define BUTTON_FLAG_LONG     0x04 // langer Druck wurde schon gemeldet
+#define BUTTON_FLAG_LOCKED   0x08 // bis zum Loslassen keine Ereignisse mehr
+
+static ButtonEvents* _buttonEventsInstance;
+
+static void _buttonEventsPinChange() {
+    _buttonEventsInstance->onPinChange();
+}
+
+/**
+ * Der 1ms-Takt. Timer0 laeuft ohnehin fuer millis(),
+ * hier wird nur der Compare-B-Interrupt dazugeschaltet.
+ */
+ISR(TIMER0_COMPB_vect) {
+    if (_buttonEventsInstance != 0) {
+        _buttonEventsInstance->onTick();
+    }
+}
+
+/**
+ * Initialisierung.
+ */
+ButtonEvents::ButtonEvents() {
+    _count = 0;
+    _head = 0;
+    _tail = 0;
+}
+
+/**
+ * Eine Taste anmelden.
+ *
+ * @param  button: die Nummer der Taste (0..BUTTON_EVENTS_MAX_BUTTONS-1)
+ *         pin: der Pin, an dem der Taster haengt
+ *         pressedAgainst: wogegen schaltet der Taster? (HIGH/LOW)
+ * @return TRUE, wenn der Pin-Change-Interrupt fuer den Pin angemeldet ist.
+ */
+boolean ButtonEvents::addButton(byte button, byte pin, byte pressedAgainst) {
+    _inputRegister[button] = portInputRegister(digitalPinToPort(pin));
+    _bitMask[button] = digitalPinToBitMask(pin);
+    _pressedAgainst[button] = pressedAgainst;
+    _flags[button] = 0;
+    if (pressedAgainst == HIGH) {
+        pinMode(pin, INPUT);
+    } else {
+        pinMode(pin, INPUT_PULLUP);
+    }
+    if (button >= _count) {
+        _count = button + 1;
+    }
+    _buttonEventsInstance = this;
+    return attachPinChangeInterrupt(pin, _buttonEventsPinChange);
+}
+
+/**
+ * Eine Tastenkombination anmelden. Sie wird gedrueckt, wenn die eine Taste
+ * gedrueckt wird, waehrend die andere schon gedrueckt ist. Danach folgt
+ * noch das normale Ereignis der zweiten Taste.
+ *
+ * @param  button: die Nummer der Tastenkombination
+ *         button1, button2: die Nummern der beiden Tasten
+ */
+void ButtonEvents::addCombination(byte button, byte button1, byte button2) {
+    _bitMask[button] = 0;
+    _button1[button] = button1;
+    _button2[button] = button2;
+    _flags[button] = 0;
+    if (button >= _count) {
+        _count = button + 1;
+    }
+}
+
+/**
+ * Das naechste Ereignis aus der Warteschlange holen.
+ * Ereignisse gesperrter Tasten werden verworfen.
+ *
+ * @return false, wenn die Warteschlange leer ist.
+ */
+boolean ButtonEvents::read(ButtonEvent* event) {
+    while (_tail != _head) {
+        *event = _queue[_tail];
+        _tail = (_tail + 1) & (BUTTON_EVENTS_QUEUE_SIZE - 1);
+        if ((event->type == BUTTON_EVENT_REMOTE) || (event->type == BUTTON_EVENT_RELEASE) || !(_flags[event->button] & BUTTON_FLAG_LOCKED)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Ein Ereignis aus loop() heraus einreihen (z. B. eine Taste der Fernbedienung).
+ */
+void ButtonEvents::push(byte button, byte type) {
+    uint8_t oldSREG = SREG;
+    cli();
+    _push(button, type, millis());
+    SREG = oldSREG;
+}
+
+/**
+ * Ist die Taste (entprellt) gerade gedrueckt?
+ */
+boolean ButtonEvents::isDown(byte button) {
+    return _flags[button] & BUTTON_FLAG_DOWN;
+}
+
+/**
+ * Taste bis zum Loslassen sperren (ersetzt Button::lock()).
+ */
+void ButtonEvents::lock(byte button) {
+    uint8_t oldSREG = SREG;
+    cli();
+    if (_flags[button] & BUTTON_FLAG_DOWN) {
+        _flags[button] |= BUTTON_FLAG_LOCKED;
+    }
+    SREG = oldSREG;
+}
+
+/**
+ * Pin-Change-Interrupt: alle Tasten ausserhalb der Entprellzeit pruefen.
+ */
+void ButtonEvents::onPinChange() {
+    unsigned int now = millis();
+    for (byte i = 0; i < _count; i++) {
+        if ((_bitMask[i] != 0) && !(_flags[i] & BUTTON_FLAG_SETTLING)) {
+            _check(i, now);
+        }
+    }
+}
+
+/**
+ * 1ms-Takt: Ende der Entprellzeit, langer Druck und Wiederholung.
+ * Schaltet sich ab, wenn keine Taste mehr gedrueckt ist.
+ */
+void ButtonEvents::onTick() {
+    unsigned int now = millis();
+    boolean busy = false;
+    for (byte i = 0; i < _count; i++) {
+        if (_bitMask[i] == 0) {
+            continue;
+        }
+        if ((_flags[i] & BUTTON_FLAG_SETTLING) && (now - _lastEdge[i] >= BUTTON_DEBOUNCE_TIME)) {
+            // Entprellzeit vorbei, den Pin noch einmal ansehen, falls
+            // waehrenddessen losgelassen (oder gedrueckt) wurde.
+            _flags[i] &= ~BUTTON_FLAG_SETTLING;
+            _check(i, now);
+        }
+        if ((_flags[i] & BUTTON_FLAG_DOWN) && !(_flags[i] & BUTTON_FLAG_LOCKED)) {
+            if (!(_flags[i] & BUTTON_FLAG_LONG) && (now - _pressTime[i] >= BUTTON_LONG_PRESS_TIME)) {
+                _flags[i] |= BUTTON_FLAG_LONG;
+                _push(i, BUTTON_EVENT_LONG, now);
+            }
+            if ((now - _pressTime[i] >= BUTTON_REPEAT_DELAY) && (now - _lastRepeat[i] >= BUTTON_REPEAT_RATE)) {
+                _lastRepeat[i] = now;
+                _push(i, BUTTON_EVENT_REPEAT, now);
+            }
+        }
+        if (_flags[i] & (BUTTON_FLAG_DOWN | BUTTON_FLAG_SETTLING)) {
+            busy = true;
+        }
+    }
+    if (!busy) {
+        _armTick(false);
+    }
+}
+
+/**
+ * Eine Taste lesen und bei geaendertem Zustand das Ereignis erzeugen.
+ * Die erste Flanke zaehlt sofort, danach wird BUTTON_DEBOUNCE_TIME lang
+ * nicht mehr auf die Taste geschaut.
+ */
+void ButtonEvents::_check(byte button, unsigned int now) {
+    boolean down = ((*_inputRegister[button] & _bitMask[button]) ? HIGH : LOW) == _pressedAgainst[button];
+    if (down == ((_flags[button] & BUTTON_FLAG_DOWN) != 0)) {
+        return;
+    }
+
+    _lastEdge[button] = now;
+    _armTick(true);
+    if (down) {
+        _flags[button] = BUTTON_FLAG_DOWN | BUTTON_FLAG_SETTLING;
+        _pressTime[button] = now;
+        _lastRepeat[button] = now;
+        // Tastenkombinationen vor dem Ereignis der Taste melden
+        for (byte i = 0; i < _count; i++) {
+            if ((_bitMask[i] == 0)
+                && (((_button1[i] == button) && (_flags[_button2[i]] & BUTTON_FLAG_DOWN))
+                    || ((_button2[i] == button) && (_flags[_button1[i]] & BUTTON_FLAG_DOWN)))) {
+                _push(i, BUTTON_EVENT_PRESS, now);
+            }
+        }
+        _push(button, BUTTON_EVENT_PRESS, now);
+    } else {
+        _flags[button] = BUTTON_FLAG_SETTLING;
+        _push(button, BUTTON_EVENT_RELEASE, now);
+    }
+}
+
+/**
+ * Ein Ereignis einreihen (mit gesperrten Interrupts). Ist die Warteschlange
+ * voll, geht das Ereignis verloren.
+ */
+void ButtonEvents::_push(byte button, byte type, unsigned int time) {
+    byte next = (_head + 1) & (BUTTON_EVENTS_QUEUE_SIZE - 1);
+    if (next != _tail) {
+        _queue[_head].button = button;
+        _queue[_head].type = type;
+        _queue[_head].time = time;
+        _head = next;
+    }
+}
+
+/**
+ * Den 1ms-Takt ein- oder ausschalten.
+ */
+void ButtonEvents::_armTick(boolean on) {
+    if (on) {
+        if (!(TIMSK0 & _BV(OCIE0B))) {
+            OCR0B = 0x80;
+            TIFR0 = _BV(OCF0B);
+            TIMSK0 |= _BV(OCIE0B);
+        }
+    } else {
+        TIMSK0 &= ~_BV(OCIE0B);
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * ButtonEvents
+ * Interrupt-gesteuerte Tastenabfrage. Die Tasten werden per Pin-Change-Interrupt
+ * entprellt und legen Ereignisse (Druecken, Loslassen, langer Druck, Wiederholung)
+ * mit Zeitstempel in eine Warteschlange, die loop() abarbeitet. Die Fernbedienung
+ * legt ihre Tasten in dieselbe Warteschlange.
+ * Fuer langen Druck, Wiederholung und das Ende der Entprellzeit laeuft ein 1ms-Takt
+ * (Timer0 Compare B), aber nur solange eine Taste gedrueckt ist oder prellt.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - addButton() meldet, ob der Pin-Change-Interrupt angemeldet wurde.
+ */
+#ifndef BUTTON_EVENTS_H
+#define BUTTON_EVENTS_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+#define BUTTON_EVENT_PRESS    1
+#define BUTTON_EVENT_RELEASE  2
+#define BUTTON_EVENT_LONG     3
+#define BUTTON_EVENT_REPEAT   4
+// Taste der Fernbedienung, button ist dann ein REMOTE_BUTTON_*
+#define BUTTON_EVENT_REMOTE   5
+
+// Anzahl Tasten inkl. Tastenkombinationen
+#define BUTTON_EVENTS_MAX_BUTTONS 6
+// Laenge der Warteschlange, muss eine Zweierpotenz sein
+#define BUTTON_EVENTS_QUEUE_SIZE  16
+
+struct ButtonEvent {
+    byte button;
+    byte type;
+    // untere 16 Bit von millis()
+    unsigned int time;
+};
+
+class ButtonEvents {
+public:
+    ButtonEvents();
+
+    boolean addButton(byte button, byte pin, byte pressedAgainst);
+    void addCombination(byte button, byte button1, byte button2);
+
+    boolean read(ButtonEvent* event);
+    void push(byte button, byte type);
+
+    boolean isDown(byte button);
+    void lock(byte button);
+
+    // Nur fuer die Interrupt-Routinen
+    void onPinChange();
+    void onTick();
+
+private:
+    // Taste
+    volatile uint8_t* _inputRegister[BUTTON_EVENTS_MAX_BUTTONS];
+    byte _bitMask[BUTTON_EVENTS_MAX_BUTTONS];
+    byte _pressedAgainst[BUTTON_EVENTS_MAX_BUTTONS];
+    // Tastenkombination (_bitMask == 0): die beiden Tasten
+    byte _button1[BUTTON_EVENTS_MAX_BUTTONS];
+    byte _button2[BUTTON_EVENTS_MAX_BUTTONS];
+
+    volatile byte _flags[BUTTON_EVENTS_MAX_BUTTONS];
+    volatile unsigned int _lastEdge[BUTTON_EVENTS_MAX_BUTTONS];
+    volatile unsigned int _pressTime[BUTTON_EVENTS_MAX_BUTTONS];
+    volatile unsigned int _lastRepeat[BUTTON_EVENTS_MAX_BUTTONS];
+    byte _count;
+
+    ButtonEvent _queue[BUTTON_EVENTS_QUEUE_SIZE];
+    volatile byte _head;
+    volatile byte _tail;
+
+    void _push(byte button, byte type, unsigned int time);
+    void _check(byte button, unsigned int now);
+    void _armTick(boolean on);
+};
+
+#endif
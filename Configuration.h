@@ -64,8 +64,8 @@
 // nicht immer alle ein. Dies verhindert das Glimmen bei richtiger Verdrahtung. (Standard: ausgeschaltet)
 //#define USE_INDIVIDUAL_CATHODES
 
-// Ist ein DCF77-Empfänger eingebaut? Dann wird eine Menüseite zur Anzeige der vergangenen Stunden und Minuten
-// seit der letzten erfolgreichen DCF-Synchronisation im Menü EXT_MODE_DCF_SYNC angezeigt (Standard: eingeschaltet)
+// Ist ein DCF77-Empfänger eingebaut? Dann läuft im Menü EXT_MODE_DCF_SYNC die Quelle (DCF oder GPS) und die Zeit
+// in Stunden und Minuten seit der letzten erfolgreichen Synchronisation als Text durch (Standard: eingeschaltet)
 #define DCF77_SENSOR_EXISTS
 
 // Diese Option aktiviert die Datumsanzeige. (Standard: eingeschaltet)
@@ -73,6 +73,10 @@
 #define DATE_ENABLE
 // Mit dieser Option wird zusätzlich zum Tag noch der Monat angezeigt. (Standard: ausgeschaltet)
 //#define DATE_MONTH_SHOW
+// Mit dieser Option laeuft das ganze Datum (TT.MM.JJJJ) als Text durch. (Standard: ausgeschaltet)
+//#define DATE_SCROLL
+// Wie schnell laeuft ein Text durch (in ms pro Spalte)? (Standard: 80)
+#define TEXT_SCROLL_SPEED 80
 
 // Zeitdauer (in s) bis automatisch von der Sekunden- und Datumsanzeige zurück auf die Uhrzeit gesprungen wird.
 // Eine Dauer von 0 bedeutet: Kein automatischer Rücksprung. (Standard: 10)
@@ -93,9 +97,9 @@
 // Hinweis: Diese Einstellung ist nur bei richtig eingestelltem Datum (z.B. via DCF77) sinnvoll. 
 #define EVENTDAY
 
-// Ist in der Ereignisse.h als erstes Ereignis (Eintrag 0) der Neujahrscountdown hinterlegt, kann mit deser
+// Verwendet in der Ereignisse.h der Neujahrscountdown das Symbol 0, kann mit deser
 // Einstellung die Jahreszahl des neuen Jahres automatisch berechnet und angezeigt werden. (Standard: eingeschaltet)
-// Hinweis: Einstellung nur wählen, wenn Eintrag 0 tatsächlich der Neujahrscountdown ist!
+// Hinweis: Einstellung nur wählen, wenn Symbol 0 nur vom Neujahrscountdown verwendet wird!
 #define EVENTDAY_CALCULATE_NEW_YEARS_EVE
 
 // Zeigt einen Countdown (und am Ende ein blinkendes Symbol) zu einem Ereignis an. (Standard: eingeschaltet)
@@ -112,6 +116,54 @@
 // FPS im Debug-Modus anzeigen (Standard: eingeschaltet).
 //#define FPS_SHOW_DEBUG
 
+// Laufzeiten der Abschnitte von loop() messen: Minimum, Maximum, Mittelwert und
+// Histogramm (Zweierpotenzen ab 64 us) je Abschnitt, zusammen ca. 150 Byte RAM.
+// Anzeige im Menue (EXT_MODE_PROFILER): H+ waehlt den Abschnitt, M+ gibt alle
+// Abschnitte ueber Serial aus und beginnt neu. (Standard: ausgeschaltet)
+//#define LOOP_PROFILER
+
+// Log-Eintraege (LOG0..LOG3 in Debug.h) binaer statt als Text ausgeben: Die Texte
+// (LogMessages.h) kommen nicht in den Flash und es wird nie auf Serial gewartet.
+// Passt ein Eintrag nicht in den Sendepuffer, wird er verworfen und gezaehlt.
+// Lesbar mit tools/logdecoder.py. (Standard: ausgeschaltet)
+//#define DEBUG_BINARY_LOG
+
+// Die letzten Ereignisse (ausgefallener Sekundentakt, DCF77-Minuten, IR, Tasten, Modi,
+// Helligkeit, Reset) in einem Ringpuffer mit TRACE_RECORDS Eintraegen zu 4 Byte festhalten.
+// Anzeige im Menue (EXT_MODE_TRACE): H+ blaettert zurueck, M+ gibt alle Eintraege
+// ueber Serial aus. Mit TRACE_NOINIT ueberlebt der Puffer einen Reset (z. B. durch
+// den Watchdog), solange die Spannung bleibt. (Standard: ausgeschaltet)
+//#define TRACE_ENABLE
+#define TRACE_RECORDS 16
+//#define TRACE_NOINIT
+// Zusaetzlich jedes DCF77-Bit eintragen (ein Eintrag pro Sekunde, verdraengt die
+// anderen Ereignisse schnell, nur zur Fehlersuche am Empfang). (Standard: ausgeschaltet)
+//#define TRACE_DCF_BITS
+
+// Kommandozeile ueber Serial (SERIAL_SPEED, Zeilenende CR oder LF), '?' zeigt die
+// Kommandos: Zeit und Datum stellen, Einstellungen lesen und schreiben, Zeitplan,
+// DCF77 neu synchronisieren, Statistiken. Es wird nie auf Zeichen gewartet.
+// (Standard: ausgeschaltet)
+//#define SERIAL_CONSOLE
+
+// Bei dunkler Anzeige (Nacht, Blank, DCF-Blank) schlaeft der ATmega zwischen den
+// Durchlaeufen von loop() bis zum naechsten Interrupt (Modus IDLE, Timer0 weckt
+// spaetestens nach 1ms). Der Anteil der Schlafzeit steht in der Ausgabe von 'I'
+// (SERIAL_CONSOLE). (Standard: ausgeschaltet)
+//#define SLEEP_ENABLE
+
+// Schneller Start: Die Zeit steht kurz nach dem Einschalten. Das Blinken der
+// Status-LEDs als 'Hello' und die Infos in setup() gibt es nur, wenn beim
+// Einschalten die Mode-Taste gedrueckt ist, sonst kommen die Infos nach dem ersten
+// Bild. Die Zeit bis zum ersten Bild steht in den Infos. (Standard: ausgeschaltet)
+//#define FAST_BOOT
+
+// Zeit vom GPS-Empfaenger (NMEA-Saetze RMC/ZDA an RX, GPS_SERIAL_SPEED) statt oder
+// zusaetzlich zum DCF77-Empfaenger. Belegt den Empfang von Serial, geht also nicht
+// zusammen mit SERIAL_CONSOLE. Einstellungen unten bei 'GPS-Empfaenger'.
+// (Standard: ausgeschaltet)
+//#define GPS_ENABLE
+
 
 /*
  * Wortwecker-Funktionen
@@ -123,6 +175,9 @@
 
 // Hat der 5-Tasten-Wortwecker einen Näherungssensor eingebaut? (Standard: eingeschaltet)
 #define WW_5_BUTTONS_NEAR_SENSOR_ENABLE
+// Pin des Näherungssensors und Stärke des Tiefpasses (AnalogSampler, 2 = schnell, damit eine Bewegung sofort erkannt wird).
+#define PIN_NEAR_SENSOR A1
+#define NEAR_SENSOR_FILTER_SHIFT 2
 
 // Zeitdauer in ms, die das Display mindestens an bleibt, wenn eine Bewegung vom Näherungssensor detektiert wurde. (Standard: 4000)
 // #define WW_5_BUTTONS_NEAR_SENSOR_DELAY 4000
@@ -153,6 +208,8 @@
  * - SNOOZE_TIME_IN_MINUTES: Wie lange der Alarm des Weckers schlummert bis er erneut ertönt. (Standard: 5)
  * - ALARM_LED_FREQ_SET_ALARM: Blinkfrequenz in Hz bei Einstellen des Alarms. (Standard: 1)
  * - ALARM_LED_FREQ_SNOOZE: Blinkfrequenz in Hz im Snooze-Modus. (Standard: 2)
+ * Die Weckmelodie spielt der MelodyPlayer im Interrupt von Timer1 (siehe MelodyPlayer.h).
+ * SPEAKER_FREQUENCY wird dabei auf hoechstens 8191 Hz begrenzt.
  */
 #define SPEAKER_FREQUENCY 200000
 #define MAX_BUZZ_TIME_IN_MINUTES 10
@@ -192,6 +249,14 @@
  */
 #define DS1307
 // #define DS3231
+/*
+ * Haeufig wechselnde Werte (LDR-Grenzen, letzte DCF77-Synchronisation,
+ * Schlummermodus, Nachtsperre) im batteriegepufferten RAM der DS1307
+ * statt im EEPROM halten. Die DS3231 hat kein solches RAM.
+ */
+#ifdef DS1307
+    #define RTC_NVRAM_HOT_VALUES
+#endif
 
 /*
  * Welche Fernbedienung soll benutzt werden?
@@ -200,6 +265,35 @@
 // #define REMOTE_SPARKFUN
 // #define REMOTE_MOONCANDLES
 // #define REMOTE_LUNARTEC
+/*
+ * Welche IR-Protokolle soll der Empfaenger dekodieren? Nur die hier gewaehlten Dekoder
+ * werden uebersetzt und beim Empfang geprueft.
+ * Sparkfun, Mooncandles und Lunartec senden NEC-Codes. Fuer eine eigene Fernbedienung den passenden
+ * Schalter setzen: IR_DECODE_NEC, IR_DECODE_SONY, IR_DECODE_SANYO, IR_DECODE_MITSUBISHI, IR_DECODE_RC5,
+ * IR_DECODE_RC6, IR_DECODE_PANASONIC, IR_DECODE_LG, IR_DECODE_JVC, IR_DECODE_SAMSUNG, IR_DECODE_HASH
+ * (IR_DECODE_HASH bildet einen Hash-Wert fuer unbekannte Protokolle).
+ */
+#if defined(REMOTE_SPARKFUN) || defined(REMOTE_MOONCANDLES) || defined(REMOTE_LUNARTEC)
+#define IR_DECODE_NEC
+#endif
+/*
+ * Die Uhr sendet nicht. Den IR-Sender (IRsend) nur bei Bedarf einschalten.
+ * Default: ausgeschaltet
+ */
+// #define IR_SEND_ENABLE
+/*
+ * Lernmodus fuer die Fernbedienung: Im erweiterten Menue (TEST, Anzeige "IR" und Tastennummer)
+ * wird der naechste empfangene Code der angezeigten Taste (REMOTE_BUTTON_*, 0 = Code vergessen)
+ * zugeordnet. Mit H+/M+ wird die Taste gewaehlt. Die angelernten Codes liegen im EEPROM ab
+ * IR_LEARN_EEPROM_START (1 + IR_LEARN_MAX_CODES * 5 Bytes).
+ * Default: eingeschaltet
+ */
+#define IR_LEARN_ENABLE
+#define IR_LEARN_EEPROM_START 64
+#define IR_LEARN_MAX_CODES 8
+#ifdef REMOTE_NO_REMOTE
+    #undef IR_LEARN_ENABLE
+#endif
 
 
 /*
@@ -239,6 +333,25 @@
  */
 // #define OPTIMIZED_FOR_DARKNESS
 
+// ------------------ EEPROM ---------------------
+/*
+ * Die Einstellungen liegen als Journal (SettingsJournal) im EEPROM, jeder
+ * geaenderte Wert wird als neuer Eintrag angehaengt. Der Bereich sollte
+ * moeglichst gross sein, dann wird jede Zelle entsprechend seltener beschrieben.
+ * Die alten Einstellungen ab Adresse 0 werden beim ersten Start uebernommen.
+ * Default: 128 bis 1024 (Ende des EEPROM beim ATmega328)
+ */
+#define SETTINGS_JOURNAL_EEPROM_START 128
+#define SETTINGS_JOURNAL_EEPROM_END 1024
+#define SETTINGS_JOURNAL_MAX_INDEX 64
+/*
+ * Anzahl der Eintraege im Zeitplan (Schedule): die vier Nachtzeiten, die
+ * Weckzeit aus dem Menue und weitere Weckzeiten. Jeder Eintrag belegt vier
+ * Werte im Journal ab Index 32. Hoechstens 8.
+ * Default: 8
+ */
+#define SCHEDULE_ENTRIES 8
+
 // ------------------ Tasten ---------------------
 /*
  * Die Zeit in Millisekunden, innerhalb derer Prellungen der Taster nicht als Druecken zaehlen.
@@ -246,6 +359,35 @@
  * Default: 300
  */
 #define BUTTON_THRESHOLD 300
+/*
+ * Die Tasten, der IR-Empfaenger und der Sekundenimpuls des GPS-Empfaengers
+ * laufen ueber die Pin-Change-Interrupts (PinChangeInterrupt). Die Firmware
+ * belegt die Vektoren PCINT0 (Bit 0: Pins 8-13), PCINT1 (Bit 1: A0-A5) und
+ * PCINT2 (Bit 2: Pins 0-7) der hier angegebenen Ports selbst. Andere
+ * Bibliotheken mit eigenen Pin-Change-Interrupts (z. B. SoftwareSerial)
+ * gehen nur an Ports, die hier fehlen. Pro Port koennen sich hoechstens
+ * zwei Routinen den Interrupt teilen, sonst gibt es eine Meldung ueber Serial.
+ * Default: 0x07 (alle drei Ports)
+ */
+#define PCINT_PORTS 0x07
+/*
+ * Die Tasten werden per Pin-Change-Interrupt abgefragt (ButtonEvents).
+ * Entprellzeit in Millisekunden nach jeder Flanke.
+ * Default: 30
+ */
+#define BUTTON_DEBOUNCE_TIME 30
+/*
+ * Ab wieviel Millisekunden gilt ein Druck als langer Druck?
+ * Default: 1000
+ */
+#define BUTTON_LONG_PRESS_TIME 1000
+/*
+ * Nach wieviel Millisekunden beginnt die Tastenwiederholung und in welchem Abstand
+ * wird dann wiederholt?
+ * Default: 600 und BUTTON_THRESHOLD
+ */
+#define BUTTON_REPEAT_DELAY 600
+#define BUTTON_REPEAT_RATE BUTTON_THRESHOLD
 
 // ------------------ DCF77-Empfaenger ---------------------
 /*
@@ -296,6 +438,14 @@
  * Default: 30  (sinnvoll: 10 - 300)
  */
 #define MYDCF77_DRIFT_CORRECTION_TIME 30
+/*
+ * Den Empfaenger nach einer Synchronisation abschalten, bis der TimeArbiter
+ * wieder eine braucht (TIME_ARBITER_RESYNC_MINUTES). Spart Strom, der Empfaenger
+ * braucht aber nach dem Einschalten ein paar Minuten. Nicht zusammen mit
+ * WW_5_BUTTONS_ENABLE_NEARSENSOR_A0.
+ * Default: ausgeschaltet.
+ */
+//#define DCF77_POWER_SAVE
 /*
  * Ist das Signal invertiert (z.B. ELV-Empfaenger)?
  * Default: ausgeschaltet.
@@ -324,6 +474,59 @@
 #ifdef LED_DRIVER_LPD8806
 #define MYDCF77_MEANSTARTVALUE 1280
 #endif
+// ------------------ GPS-Empfaenger ---------------------
+/*
+ * Die Geschwindigkeit des Empfaengers (ersetzt SERIAL_SPEED).
+ * Default: 9600
+ */
+#define GPS_SERIAL_SPEED 9600
+/*
+ * GPS liefert UTC. Die Abweichung der Ortszeit (ohne Sommerzeit) in Stunden.
+ * Default: 1 (MEZ)
+ */
+#define GPS_UTC_OFFSET 1
+/*
+ * Europaeische Sommerzeit (letzter Sonntag im Maerz bis letzter Sonntag im Oktober).
+ * Default: eingeschaltet.
+ */
+#define GPS_EU_DST
+/*
+ * Die Gueltigkeit der Zeit steht nur im RMC-Satz. Kommt so lange (in
+ * Millisekunden) nach dem Start kein RMC, wird auch ZDA allein uebernommen
+ * (nur fuer Empfaenger, die kein RMC schicken). Die Zeit kann dann aus der Uhr
+ * des Empfaengers ohne Fix stammen, z. B. kurz nach dessen Neustart. Der
+ * TimeArbiter prueft sie zwar, sicher ist aber nur RMC mit Status 'A'.
+ * Sobald einmal ein RMC kam, gilt ZDA allein nicht mehr.
+ * Default: ausgeschaltet.
+ */
+//#define GPS_RMC_TIMEOUT 5000
+/*
+ * Der Sekundenimpuls (PPS) des Empfaengers, z. B. am Pin des DCF77-Empfaengers,
+ * wenn keiner verbaut ist. Ohne PPS wird die Zeit beim Empfang des Satzes
+ * uebernommen (einige 100ms spaet).
+ * Default: ausgeschaltet.
+ */
+//#define GPS_PPS_PIN PIN_DCF77_SIGNAL
+
+// ------------------ Zeitquellen (TimeArbiter) ---------------------
+/*
+ * So lange (in Minuten) nach einer Synchronisation gilt die RTC als richtig,
+ * groessere Abweichungen einer Quelle sind dann Ausreisser.
+ * Default: 1440 (ein Tag)
+ */
+#define TIME_ARBITER_TRUST_MINUTES 1440
+/*
+ * Ab dieser Abweichung (in Sekunden) zur RTC ist ein Sample ein Ausreisser.
+ * Default: 90
+ */
+#define TIME_ARBITER_MAX_OFFSET 90
+/*
+ * Nach so vielen Minuten ohne Synchronisation wird wieder eine gebraucht
+ * (DCF77_POWER_SAVE).
+ * Default: 60
+ */
+#define TIME_ARBITER_RESYNC_MINUTES 60
+
 // ------------------ Lichtabhaengiger Widerstand ---------------------
 /*
  * Sollen die Grenzwerte vom LDR automatisch angepasst werden? Bei einem Neustart der QlockTwo kann
@@ -351,10 +554,18 @@
  * #define LDR_MEAN_COUNT 32
  */
 /*
- * Der Hysterese-Threshold.
- * Default: 50
+ * Der LDR wird im Hintergrund gelesen (AnalogSampler) und mit einem Tiefpass
+ * geglaettet. Jeder neue Wert geht mit 1/2^LDR_FILTER_SHIFT ein. Bei 6 und
+ * einem weiteren analogen Kanal liegt die Zeitkonstante bei ca. 130ms.
+ * Default: 6
+ */
+#define LDR_FILTER_SHIFT 6
+/*
+ * Der Hysterese-Threshold. Da der Wert schon gefiltert ist,
+ * reicht ein kleiner Wert gegen das Pendeln zwischen zwei Stufen.
+ * Default: 8
  */
-#define LDR_HYSTERESE 50
+#define LDR_HYSTERESE 8
 /*
  * Die LDR-Werte werden auf Prozent gemappt.
  * Hier koennen diese Werte beschnitten werden,
@@ -364,11 +575,29 @@
 #define LDR_MIN_PERCENT 0
 #define LDR_MAX_PERCENT 100
 /*
- * LDR-Check-Raten. Dieser Wert beeinflusst, wie schnell
- * sich die Displayhelligkeit an neue LDR-Werte anpasst
- * und ist vom LedDriver abhaengig.
- * Der Wert ist der Threshold in Millisekunden, bevor eine
- * neue Anpassung stattfindet.
+ * Die Helligkeit folgt dem LDR (bzw. der manuellen Helligkeit) mit hoechstens
+ * BRIGHTNESS_SLEW_RATE Prozent pro Sekunde (BrightnessController).
+ * Default: 25
+ */
+#define BRIGHTNESS_SLEW_RATE 25
+/*
+ * Zeitkonstante in Millisekunden, mit der kleine Abweichungen weich angefahren werden.
+ * Default: 500
+ */
+#define BRIGHTNESS_SMOOTHING_MS 500
+/*
+ * Die Prozentwerte ueber eine quadratische Kennlinie an den LED-Treiber geben,
+ * damit die Stufen dem Helligkeitsempfinden entsprechen. Die Treiber bekommen
+ * nur ganze Prozent, deshalb fallen 1..10% auf 1% zusammen, und eine
+ * gespeicherte Helligkeit wirkt dunkler als ohne Kennlinie (50% -> 25%).
+ * Default: ausgeschaltet
+ */
+//#define BRIGHTNESS_PERCEPTUAL_CURVE
+/*
+ * LDR-Check-Raten. Der Wert ist der Abstand in Millisekunden zwischen
+ * zwei Anpassungen der Helligkeit und ist vom LedDriver abhaengig
+ * (wie teuer ist setBrightness()?). Die Geschwindigkeit der Anpassung
+ * haengt davon nicht mehr ab (BRIGHTNESS_SLEW_RATE).
  */
 #ifdef LED_DRIVER_DEFAULT
 #define LDR_CHECK_RATE 1
@@ -5,9 +5,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.8b
+ * @version  1.9
  * @created  19.3.2011
- * @updated  22.05.2016 (Ergänzungen und Änderungen von A. Mueller)
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.1:  - Fehler in der Initialisierung behoben.
@@ -20,6 +20,7 @@
  * V 1.8:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
  * V 1.8a: - Datum wird jetzt ebenfalls geprüft (via getMinutesOfCentury())
  * V 1.8b: - Kleine Codeoptimierung
+ * V 1.9:  - clear() verwirft die gesammelten Samples (neue Synchronisation).
  */
 #include "DCF77Helper.h"
 
@@ -31,10 +32,22 @@
  * der Samples zum Anfang nicht stimmt.
  */
 DCF77Helper::DCF77Helper() {
+    for (byte i = 0; i < DCF77HELPER_MAX_SAMPLES; i++) {
+        _zeitstempelDcf77[i] = new TimeStamp(0, 0, 0, 0, 0, 0);
+        _zeitstempelRtc[i] = new TimeStamp(0, 0, 0, 0, 0, 0);
+    }
+    clear();
+}
+
+/**
+ * Die Samples wieder 'falsch' vorbelegen, erst die naechsten
+ * DCF77HELPER_MAX_SAMPLES Telegramme stellen dann die Uhr.
+ */
+void DCF77Helper::clear() {
     _cursor = 0;
     for (byte i = 0; i < DCF77HELPER_MAX_SAMPLES; i++) {
-        _zeitstempelDcf77[i] = new TimeStamp(i, i, i, i, i, i);
-        _zeitstempelRtc[i] = new TimeStamp(100, 0, 0, 0, 0, 0);
+        _zeitstempelDcf77[i]->set(i, i, i, i, i, i);
+        _zeitstempelRtc[i]->set(100, 0, 0, 0, 0, 0);
     }
 }
 
@@ -5,9 +5,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.8b
+ * @version  1.9
  * @created  19.3.2011
- * @updated  22.05.2016 (Ergänzungen und Änderungen von A. Mueller)
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.1:  - Fehler in der Initialisierung behoben.
@@ -20,6 +20,7 @@
  * V 1.8:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
  * V 1.8a: - Datum wird jetzt ebenfalls geprüft (via getMinutesOfCentury())
  * V 1.8b: - Kleine Codeoptimierung
+ * V 1.9:  - clear() verwirft die gesammelten Samples (neue Synchronisation).
  */
 #ifndef DCF77HELPER_H
 #define DCF77HELPER_H
@@ -34,6 +35,7 @@ public:
 
     void addSample(TimeStamp* dcf77, TimeStamp* rtc);
     boolean samplesOk();
+    void clear();
 
 private:
     byte _cursor;
@@ -4,24 +4,45 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.1
+ * @version  1.2
  * @created  21.1.2013
- * @updated  8.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
  * V 1.1:  - Zwei Argumente zugelassen.
+ * V 1.2:  - Log-Eintraege mit Nummer (LOG0..LOG3, LOG_BYTES, Texte in LogMessages.h),
+ *           mit DEBUG_BINARY_LOG binaer und ohne zu blockieren (BinaryLog).
  */
 #ifdef DEBUG
+    #include "BinaryLog.h"
+
     #define DEBUG_PRINT(x) Serial.print(x)
     #define DEBUG_PRINT2(x, y) Serial.print(x, y)
     #define DEBUG_PRINTLN(x) Serial.println(x)
     #define DEBUG_PRINTLN2(x, y) Serial.println(x, y)
-    #define DEBUG_FLUSH() Serial.flush()
+    #ifdef DEBUG_BINARY_LOG
+        // Der Puffer wird im Hintergrund geleert, warten verfaelscht nur das Timing.
+        #define DEBUG_FLUSH()
+    #else
+        #define DEBUG_FLUSH() Serial.flush()
+    #endif
+
+    #define LOG0(id) binaryLog.write(id, NULL, 0)
+    #define LOG1(id, a) do { int _logArgs[] = {(int) (a)}; binaryLog.write(id, _logArgs, sizeof(_logArgs)); } while (0)
+    #define LOG2(id, a, b) do { int _logArgs[] = {(int) (a), (int) (b)}; binaryLog.write(id, _logArgs, sizeof(_logArgs)); } while (0)
+    #define LOG3(id, a, b, c) do { int _logArgs[] = {(int) (a), (int) (b), (int) (c)}; binaryLog.write(id, _logArgs, sizeof(_logArgs)); } while (0)
+    #define LOG_BYTES(id, data, length) binaryLog.write(id, data, length)
 #else
     #define DEBUG_PRINT(x)
     #define DEBUG_PRINT2(x, y)
     #define DEBUG_PRINTLN(x)
     #define DEBUG_PRINTLN2(x, y)
     #define DEBUG_FLUSH()
+
+    #define LOG0(id)
+    #define LOG1(id, a)
+    #define LOG2(id, a, b)
+    #define LOG3(id, a, b, c)
+    #define LOG_BYTES(id, data, length)
 #endif
@@ -6,13 +6,15 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Andreas Müller / raffix _AT_ web _DOT_ de
- * @version  1.2
+ * @version  1.4
  * @created  13.03.2016
- * @updated  05.06.2016
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.1:  - Startzeit und -dauer für einen Countdown hinzugefügt.
  * V 1.2:  - Startzeit eines Countdown geändert in die Zielzeit..
+ * V 1.3:  - Feiertage für die Nachtschaltung hinzugefügt.
+ * V 1.4:  - Symbole gepackt (14 Byte) in eigener Tabelle, bewegliche Ereignisse (Ostern, n-ter Wochentag).
  */
 #ifndef EREIGNISSE_H
 #define EREIGNISSE_H
@@ -20,45 +22,26 @@
 #include <avr/pgmspace.h>
 
 /*
- * Beispiel für einen Eintrag:
- * 1,1,1,1,0,0,15
- * -- Symbol in der Datumsanzeige --
- * Die ersten beiden Ziffern (1,1) geben an, dass am 01.01. das
- * definierte Symbol ganztägig in der Datumsanzeige angezeigt wird.
- * Die restlichen 5 Zahlen sind nur für den Countdown relevant.
- * -- Countdown --
- * Neujahrs-Countdown 15 Minuten lang:
- * Die letzten 5 Ziffern (1,1,0,0,15) bedeuten, der Countdown soll
- * 15 Minuten vor dem 01.01. um 0:00 Uhr beginnen. 0:00 Uhr ist also
- * die Zielzeit. Der Countdown startet folglich am 31.12. um 23:45 Uhr.
- * Ist der Countdown beendet, wird das definierte Symbol blinkend
- * COUNTDOWN_BLINK_DURATION Sekunden lang angezeigt.
- * Die Zeit ist in der Configuration.h anpassbar.
+ * Die Symbole sind 11 Spalten x 10 Zeilen. Sie werden mit EVENT_SYMBOL() zu
+ * 14 Byte (110 Bit, Zeile fuer Zeile, niedrigstes Bit zuerst) gepackt.
+ * Die Ereignisse verweisen ueber die Nummer auf ein Symbol, so kann ein Symbol
+ * fuer mehrere Ereignisse verwendet werden.
+ * Symbol 0 ist fuer Neujahr reserviert: Ist EVENTDAY_CALCULATE_NEW_YEARS_EVE
+ * definiert, wird statt des Symbols die Jahreszahl angezeigt.
  */
-struct EventdayObject {
-  byte day;
-  byte month;
-  // countdown* gibt an, wohin der Countdown zählen soll
-  byte countdownDay;
-  byte countdownMonth;
-  byte countdownHour;
-  byte countdownMinute;
-  // Wie lange soll der Countdown laufen?
-  byte countdownMinutes;
-  int symbol[10];
-};
+#define EVENT_SYMBOL_BYTES 14
 
-const EventdayObject eventdayObject[] PROGMEM = {
-    { 1,
-      1,
-      1,
-      1,
-      0,
-      0,
-      15,
-      {
-        // Wird automatisch berechnet, sofern in Configuration.h so definiert.
-        0b00000000000,
+#define EVENT_SYMBOL_BYTE(row, nextRow, shift) ((byte) ((((unsigned long) (row)) | (((unsigned long) (nextRow)) << 11)) >> (shift)))
+#define EVENT_SYMBOL(r0, r1, r2, r3, r4, r5, r6, r7, r8, r9) { \
+    EVENT_SYMBOL_BYTE(r0, r1, 0), EVENT_SYMBOL_BYTE(r0, r1, 8), EVENT_SYMBOL_BYTE(r1, r2, 5), \
+    EVENT_SYMBOL_BYTE(r2, r3, 2), EVENT_SYMBOL_BYTE(r2, r3, 10), EVENT_SYMBOL_BYTE(r3, r4, 7), \
+    EVENT_SYMBOL_BYTE(r4, r5, 4), EVENT_SYMBOL_BYTE(r5, r6, 1), EVENT_SYMBOL_BYTE(r5, r6, 9), \
+    EVENT_SYMBOL_BYTE(r6, r7, 6), EVENT_SYMBOL_BYTE(r7, r8, 3), EVENT_SYMBOL_BYTE(r8, r9, 0), \
+    EVENT_SYMBOL_BYTE(r8, r9, 8), EVENT_SYMBOL_BYTE(r9, 0, 5) }
+
+const byte eventSymbols[][EVENT_SYMBOL_BYTES] PROGMEM = {
+    // 0: Neujahr (wird automatisch berechnet, sofern in Configuration.h so definiert)
+    EVENT_SYMBOL(
         0b00000000000,
         0b00000000000,
         0b00000000000,
@@ -68,17 +51,10 @@ const EventdayObject eventdayObject[] PROGMEM = {
         0b00000000000,
         0b00000000000,
         0b00000000000,
-      }
-    }
-    ,
-    { 2,
-      5,
-      2,
-      5,
-      0,
-      0,
-      15,
-      {
+        0b00000000000
+    ),
+    // 1: Herz
+    EVENT_SYMBOL(
         0b00000000000,
         0b00010001000,
         0b00101010100,
@@ -89,38 +65,22 @@ const EventdayObject eventdayObject[] PROGMEM = {
         0b00001010000,
         0b00000100000,
         0b00000000000
-      }
-    }
-    ,
-    { 6,
-	    5,
-      6,
-      5,
-      0,
-      0,
-      15,
-	    {
-        0b00000000000,
-        0b00000000000,
-	      0b00100100100,
-       	0b00010101000,
+    ),
+    // 2: Blume
+    EVENT_SYMBOL(
+        0b00000000000,
+        0b00000000000,
+        0b00100100100,
+        0b00010101000,
         0b00001110000,
         0b00000100000,
         0b00000100000,
         0b00000100000,
         0b00000000000,
         0b00000000000
-	    }
-    }
-    ,
-    { 5,
-      6,
-      5,
-      6,
-      0,
-      0,
-      15,
-      {
+    ),
+    // 3: Krone
+    EVENT_SYMBOL(
         0b00000000000,
         0b00000000000,
         0b00100000100,
@@ -131,17 +91,9 @@ const EventdayObject eventdayObject[] PROGMEM = {
         0b00001110000,
         0b00000000000,
         0b00000001110
-      }
-    }
-    ,
-    { 23,
-	    8,
-      23,
-      8,
-      0,
-      0,
-      15,
-	    {
+    ),
+    // 4: Gesicht
+    EVENT_SYMBOL(
         0b00000000000,
         0b00010101000,
         0b00010101000,
@@ -152,8 +104,99 @@ const EventdayObject eventdayObject[] PROGMEM = {
         0b00010001000,
         0b00001110000,
         0b00000000000
-	    }
-    }
+    ),
+    // 5: Osterei
+    EVENT_SYMBOL(
+        0b00000000000,
+        0b00001110000,
+        0b00011111000,
+        0b00111111100,
+        0b00100000100,
+        0b01111111110,
+        0b01000000010,
+        0b00111111100,
+        0b00011111000,
+        0b00000000000
+    )
+};
+
+/*
+ * Beispiel für einen Eintrag:
+ * 1,1,1,1,0,0,15,0
+ * -- Symbol in der Datumsanzeige --
+ * Die ersten beiden Ziffern (1,1) geben an, dass am 01.01. das
+ * Symbol (letzte Zahl, hier 0) ganztägig in der Datumsanzeige angezeigt wird.
+ * Die Zahlen dazwischen sind nur für den Countdown relevant.
+ * -- Countdown --
+ * Neujahrs-Countdown 15 Minuten lang:
+ * Die Ziffern (1,1,0,0,15) bedeuten, der Countdown soll
+ * 15 Minuten vor dem 01.01. um 0:00 Uhr beginnen. 0:00 Uhr ist also
+ * die Zielzeit. Der Countdown startet folglich am 31.12. um 23:45 Uhr.
+ * Ist der Countdown beendet, wird das definierte Symbol blinkend
+ * COUNTDOWN_BLINK_DURATION Sekunden lang angezeigt.
+ * Die Zeit ist in der Configuration.h anpassbar.
+ */
+struct EventdayObject {
+  byte day;
+  byte month;
+  // countdown* gibt an, wohin der Countdown zählen soll
+  byte countdownDay;
+  byte countdownMonth;
+  byte countdownHour;
+  byte countdownMinute;
+  // Wie lange soll der Countdown laufen?
+  byte countdownMinutes;
+  // Nummer des Symbols in eventSymbols[]
+  byte symbol;
+};
+
+const EventdayObject eventdayObject[] PROGMEM = {
+    { 1,  1,  1,  1, 0, 0, 15, 0},
+    { 2,  5,  2,  5, 0, 0, 15, 1},
+    { 6,  5,  6,  5, 0, 0, 15, 2},
+    { 5,  6,  5,  6, 0, 0, 15, 3},
+    {23,  8, 23,  8, 0, 0, 15, 4}
+};
+
+/*
+ * Bewegliche Ereignisse. Das Datum wird einmal im Jahr berechnet.
+ * EVENT_RULE_EASTER:      arg = Tage nach Ostersonntag (z.B. -2 = Karfreitag, 49 = Pfingstsonntag).
+ * EVENT_RULE_NTH_WEEKDAY: arg = der wievielte Wochentag im Monat (1..4, 5 = der letzte),
+ *                         weekday = 1 (Montag) .. 7 (Sonntag).
+ * Der Countdown (countdownMinutes > 0) zählt bis zum berechneten Tag um countdownHour:countdownMinute.
+ * Es muss mindestens ein Eintrag vorhanden sein.
+ */
+#define EVENT_RULE_EASTER      0
+#define EVENT_RULE_NTH_WEEKDAY 1
+
+struct EventRule {
+  byte rule;
+  char arg;
+  byte month;
+  byte weekday;
+  byte countdownHour;
+  byte countdownMinute;
+  byte countdownMinutes;
+  byte symbol;
+};
+
+const EventRule eventRules[] PROGMEM = {
+    // Ostersonntag
+    {EVENT_RULE_EASTER,      0, 0, 0, 0, 0, 0, 5},
+    // Muttertag (zweiter Sonntag im Mai)
+    {EVENT_RULE_NTH_WEEKDAY, 2, 5, 7, 0, 0, 0, 1}
+};
+
+/*
+ * Feiertage (Tag, Monat). An diesen Tagen gelten für die Nachtschaltung
+ * die Zeiten des Sonntags.
+ */
+const byte holidays[][2] PROGMEM = {
+    { 1,  1},
+    { 1,  5},
+    { 3, 10},
+    {25, 12},
+    {26, 12}
 };
 
 #endif
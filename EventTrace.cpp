@@ -0,0 +1,167 @@
+/**
+ * EventTrace
+ * Ein Ringpuffer mit den letzten Ereignissen (ausgefallener oder verspaeteter
+ * SQW-Takt, DCF77-Minuten, IR-Rahmen, Tasten, Moduswechsel, Helligkeit, Reset), damit man bei einer Uhr, die sich
+ * seltsam verhaelt, nachsehen kann, was vorher passiert ist.
+ * Ein Eintrag hat 4 Byte: Typ, Abstand zum vorigen Eintrag in ms (16 Bit) und
+ * ein Byte Nutzdaten. add() darf auch in Interrupts aufgerufen werden.
+ * Mit TRACE_NOINIT liegt der Puffer in .noinit und ueberlebt einen Reset
+ * (z. B. durch den Watchdog), solange die Spannung bleibt.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Vom Sekundentakt nur Ausreisser, vom DCF77 eine Zusammenfassung pro Minute
+ *           (einzelne Bits nur mit TRACE_DCF_BITS).
+ *         - Die Ursache des Resets wird vor main() gesichert (optiboot loescht MCUSR).
+ */
+#include "EventTrace.h"
+#include <avr/interrupt.h>
+
+// #define DEBUG
+#include "Debug.h"
+
+// Kennung fuer einen gueltigen Puffer (nach einem Reset in .noinit)
+#define TRACE_MAGIC 0x5A17
+
+#ifdef TRACE_ENABLE
+    #ifdef TRACE_NOINIT
+        EventTrace eventTrace __attribute__((section(".noinit")));
+    #else
+        EventTrace eventTrace;
+    #endif
+
+    /*
+     * Die Ursache des Resets. optiboot liest und loescht MCUSR, bevor der Sketch
+     * startet, und uebergibt den Wert in r2. Ohne Bootloader steht er noch in
+     * MCUSR. Beides muss vor main() gesichert werden (.noinit, weil .bss erst in
+     * .init4 geloescht wird).
+     */
+    byte traceResetCause __attribute__((section(".noinit")));
+    static byte _traceBootloaderCause __attribute__((section(".noinit")));
+
+    // In .init0 ist r2 noch unberuehrt, r1 aber noch nicht 0: nur Assembler.
+    void traceSaveBootloaderCause() __attribute__((naked, used, section(".init0")));
+    void traceSaveBootloaderCause() {
+        __asm__ __volatile__ ("sts %0, r2\n" : "=m" (_traceBootloaderCause));
+    }
+
+    void traceSaveResetCause() __attribute__((naked, used, section(".init3")));
+    void traceSaveResetCause() {
+        traceResetCause = MCUSR;
+        MCUSR = 0;
+        if (!traceResetCause) {
+            traceResetCause = _traceBootloaderCause;
+        }
+    }
+#endif
+
+/**
+ * Die Namen der Typen fuer die Ausgabe ueber Serial...
+ */
+const char traceTypeNames[][7] PROGMEM = {
+    "SQW", "DCF", "IR", "BUTTON", "MODE", "BRIGHT", "RESET", "DCFMIN"
+};
+
+/**
+ * ...und als zwei Staben fuer die Anzeige.
+ */
+const char traceTypeCodes[][2] PROGMEM = {
+    {'S', 'Q'}, {'D', 'C'}, {'I', 'R'}, {'B', 'U'}, {'M', 'O'}, {'B', 'R'}, {'R', 'S'}, {'D', 'M'}
+};
+
+/**
+ * Beim Start: Einen ungueltigen (oder nicht erhaltenen) Puffer loeschen und
+ * den Reset mit seiner Ursache eintragen.
+ *
+ * @param resetCause MCUSR, vor main() gesichert (traceResetCause).
+ */
+void EventTrace::begin(byte resetCause) {
+    if ((_magic != TRACE_MAGIC) || (_next >= TRACE_RECORDS) || (_count > TRACE_RECORDS)) {
+        _magic = TRACE_MAGIC;
+        _next = 0;
+        _count = 0;
+    }
+    _lastTime = millis();
+    add(TRACE_RESET, resetCause);
+}
+
+/**
+ * Ein Ereignis eintragen, der aelteste Eintrag wird ueberschrieben.
+ */
+void EventTrace::add(byte type, byte payload) {
+    uint8_t oldSREG = SREG;
+    cli();
+    unsigned long now = millis();
+    unsigned long delta = now - _lastTime;
+    _lastTime = now;
+    TraceRecord* record = &_records[_next];
+    record->type = type;
+    record->delta = (delta > 0xFFFF) ? 0xFFFF : delta;
+    record->payload = payload;
+    _next++;
+    if (_next >= TRACE_RECORDS) {
+        _next = 0;
+    }
+    if (_count < TRACE_RECORDS) {
+        _count++;
+    }
+    SREG = oldSREG;
+}
+
+byte EventTrace::getCount() {
+    return _count;
+}
+
+/**
+ * Einen Eintrag lesen, age = 0 ist der neueste.
+ */
+boolean EventTrace::getRecord(byte age, TraceRecord* record) {
+    if (age >= _count) {
+        return false;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    *record = _records[(_next + TRACE_RECORDS - 1 - age) % TRACE_RECORDS];
+    SREG = oldSREG;
+    return true;
+}
+
+/**
+ * Der Kurzname (zwei Staben) eines Typs.
+ */
+char EventTrace::getCode(byte type, byte index) {
+    if (type >= TRACE_TYPES) {
+        return '?';
+    }
+    return pgm_read_byte_near(&traceTypeCodes[type][index]);
+}
+
+/**
+ * Alle Eintraege vom aeltesten zum neuesten ueber Serial ausgeben
+ * (Abstand zum vorigen Eintrag in ms, 65535 = laenger).
+ */
+void EventTrace::dump() {
+    Serial.print(F("Event trace, records: "));
+    Serial.println(_count);
+    TraceRecord record;
+    for (byte age = _count; age > 0; age--) {
+        getRecord(age - 1, &record);
+        Serial.print('+');
+        Serial.print(record.delta);
+        Serial.print(' ');
+        if (record.type < TRACE_TYPES) {
+            Serial.print((const __FlashStringHelper*) traceTypeNames[record.type]);
+        } else {
+            Serial.print(record.type);
+        }
+        Serial.print(' ');
+        Serial.println(record.payload);
+    }
+    Serial.flush();
+}
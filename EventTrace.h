@@ -0,0 +1,91 @@
+/**
+ * EventTrace
+ * Ein Ringpuffer mit den letzten Ereignissen (ausgefallener oder verspaeteter
+ * SQW-Takt, DCF77-Minuten, IR-Rahmen, Tasten, Moduswechsel, Helligkeit, Reset), damit man bei einer Uhr, die sich
+ * seltsam verhaelt, nachsehen kann, was vorher passiert ist.
+ * Ein Eintrag hat 4 Byte: Typ, Abstand zum vorigen Eintrag in ms (16 Bit) und
+ * ein Byte Nutzdaten. add() darf auch in Interrupts aufgerufen werden.
+ * Mit TRACE_NOINIT liegt der Puffer in .noinit und ueberlebt einen Reset
+ * (z. B. durch den Watchdog), solange die Spannung bleibt.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Vom Sekundentakt nur Ausreisser, vom DCF77 eine Zusammenfassung pro Minute
+ *           (einzelne Bits nur mit TRACE_DCF_BITS).
+ *         - Die Ursache des Resets wird vor main() gesichert (optiboot loescht MCUSR).
+ */
+#ifndef EVENTTRACE_H
+#define EVENTTRACE_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+// Die Typen und ihre Nutzdaten
+// Sekundentakt der RTC ausserhalb 1s +/- TRACE_SQW_TOLERANCE: Abstand zum
+// vorigen Takt in 10 ms (255 = laenger, also mindestens ein fehlender Takt)
+#define TRACE_SQW         0
+// DCF77-Bit (nur mit TRACE_DCF_BITS): Bit 7 = Wert, Bit 0..6 = Position im Telegramm
+#define TRACE_DCF_BIT     1
+// IR: 0 = Beginn eines Rahmens, sonst Anzahl der Flanken am Ende
+#define TRACE_IR          2
+// Taste: Taste (untere 4 Bit) | Ereignis << 4
+#define TRACE_BUTTON      3
+// Moduswechsel: der neue Modus
+#define TRACE_MODE        4
+// Neuer Sollwert der Helligkeit in Prozent
+#define TRACE_BRIGHTNESS  5
+// Start: MCUSR (Ursache des Resets)
+#define TRACE_RESET       6
+// DCF77-Minutenmarke: Bit 7 = Telegramm gueltig, Bit 0..6 = Anzahl der Bits
+#define TRACE_DCF_MINUTE  7
+#define TRACE_TYPES       8
+
+// Erlaubte Abweichung des Sekundentakts in ms
+#define TRACE_SQW_TOLERANCE 100
+
+#ifndef TRACE_RECORDS
+    #define TRACE_RECORDS 16
+#endif
+
+struct TraceRecord {
+    byte type;
+    word delta;
+    byte payload;
+};
+
+class EventTrace {
+public:
+    void begin(byte resetCause);
+
+    void add(byte type, byte payload);
+
+    byte getCount();
+    boolean getRecord(byte age, TraceRecord* record);
+    char getCode(byte type, byte index);
+
+    void dump();
+
+private:
+    word _magic;
+    TraceRecord _records[TRACE_RECORDS];
+    byte _next;
+    byte _count;
+    unsigned long _lastTime;
+};
+
+#ifdef TRACE_ENABLE
+    extern EventTrace eventTrace;
+    // MCUSR beim Reset, vor main() gesichert
+    extern byte traceResetCause;
+    #define TRACE(type, payload) eventTrace.add(type, payload)
+#else
+    #define TRACE(type, payload)
+#endif
+
+#endif
@@ -4,13 +4,14 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.1
+ * @version  1.2
  * @created  7.2.2015
- * @updated  16.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
  * V 1.1:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
+ * V 1.2:  - Codes als sortierte Tabelle im PROGMEM (IRTranslatorTable).
  */
 #include "IRTranslatorLunartec.h"
 
@@ -46,81 +47,37 @@
 #define LUNBARTEC_BLAUROT_3 0xFF708F
 #define LUNBARTEC_BLAUROT_4 0xFFF00F
 
-void IRTranslatorLunartec::printSignature() {
-    Serial.println(F("Lunartec NX6612-901"));
-}
-
-byte IRTranslatorLunartec::buttonForCode(unsigned long code) {
-    switch (code) {
-        case LUNBARTEC_BRIGHTER:
-            return REMOTE_BUTTON_BRIGHTER;
-        case LUNBARTEC_DARKER:
-            return REMOTE_BUTTON_DARKER;
-        case LUNBARTEC_OFF:
-            return REMOTE_BUTTON_BLANK;
-        case LUNBARTEC_ON:
-            return REMOTE_BUTTON_RESUME;
-        case LUNBARTEC_R:
-            setColor(255, 0, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_G:
-            setColor(0, 255, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_B:
-            setColor(0, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_W:
-            setColor(255, 255, 225);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_FLASH:
-            return REMOTE_BUTTON_MODE;
-        case LUNBARTEC_STROBE:
-            return REMOTE_BUTTON_MINUTE_PLUS;
-        case LUNBARTEC_FADE:
-            return REMOTE_BUTTON_HOUR_PLUS;
-        case LUNBARTEC_SMOOTH:
-            return REMOTE_BUTTON_EXTMODE;
-
-        case LUNBARTEC_ROTGELB_1:
-            setColor(255, 64, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_ROTGELB_2:
-            setColor(255, 128, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_ROTGELB_3:
-            setColor(255, 196, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_ROTGELB_4:
-            setColor(255, 255, 0);
-            return REMOTE_BUTTON_SETCOLOR;
+// Aufsteigend nach Code sortiert (binaere Suche)!
+const IRCode lunartecCodes[] PROGMEM = {
+    { LUNBARTEC_STROBE,      REMOTE_BUTTON_MINUTE_PLUS,   0,   0,   0 },
+    { LUNBARTEC_ROTGELB_2,   REMOTE_BUTTON_SETCOLOR,    255, 128,   0 },
+    { LUNBARTEC_BLAUROT_2,   REMOTE_BUTTON_SETCOLOR,    128,   0, 255 },
+    { LUNBARTEC_GRUENBLAU_4, REMOTE_BUTTON_SETCOLOR,      0, 255, 255 },
+    { LUNBARTEC_SMOOTH,      REMOTE_BUTTON_EXTMODE,       0,   0,   0 },
+    { LUNBARTEC_GRUENBLAU_2, REMOTE_BUTTON_SETCOLOR,      0, 255, 128 },
+    { LUNBARTEC_ROTGELB_4,   REMOTE_BUTTON_SETCOLOR,    255, 255,   0 },
+    { LUNBARTEC_GRUENBLAU_1, REMOTE_BUTTON_SETCOLOR,      0, 255,  64 },
+    { LUNBARTEC_ROTGELB_3,   REMOTE_BUTTON_SETCOLOR,    255, 196,   0 },
+    { LUNBARTEC_FADE,        REMOTE_BUTTON_HOUR_PLUS,     0,   0,   0 },
+    { LUNBARTEC_BLAUROT_1,   REMOTE_BUTTON_SETCOLOR,     64,   0, 255 },
+    { LUNBARTEC_BLAUROT_3,   REMOTE_BUTTON_SETCOLOR,    196,   0, 255 },
+    { LUNBARTEC_GRUENBLAU_3, REMOTE_BUTTON_SETCOLOR,      0, 255, 196 },
+    { LUNBARTEC_B,           REMOTE_BUTTON_SETCOLOR,      0,   0, 255 },
+    { LUNBARTEC_BRIGHTER,    REMOTE_BUTTON_BRIGHTER,      0,   0,   0 },
+    { LUNBARTEC_R,           REMOTE_BUTTON_SETCOLOR,    255,   0,   0 },
+    { LUNBARTEC_W,           REMOTE_BUTTON_SETCOLOR,    255, 255, 225 },
+    { LUNBARTEC_ON,          REMOTE_BUTTON_RESUME,        0,   0,   0 },
+    { LUNBARTEC_FLASH,       REMOTE_BUTTON_MODE,          0,   0,   0 },
+    { LUNBARTEC_DARKER,      REMOTE_BUTTON_DARKER,        0,   0,   0 },
+    { LUNBARTEC_G,           REMOTE_BUTTON_SETCOLOR,      0, 255,   0 },
+    { LUNBARTEC_ROTGELB_1,   REMOTE_BUTTON_SETCOLOR,    255,  64,   0 },
+    { LUNBARTEC_BLAUROT_4,   REMOTE_BUTTON_SETCOLOR,    255,   0, 255 },
+    { LUNBARTEC_OFF,         REMOTE_BUTTON_BLANK,         0,   0,   0 }
+};
 
-        case LUNBARTEC_GRUENBLAU_1:
-            setColor(0, 255, 64);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_GRUENBLAU_2:
-            setColor(0, 255, 128);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_GRUENBLAU_3:
-            setColor(0, 255, 196);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_GRUENBLAU_4:
-            setColor(0, 255, 255);
-            return REMOTE_BUTTON_SETCOLOR;
-
-        case LUNBARTEC_BLAUROT_1:
-            setColor(64, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_BLAUROT_2:
-            setColor(128, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_BLAUROT_3:
-            setColor(196, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
-        case LUNBARTEC_BLAUROT_4:
-            setColor(255, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
+IRTranslatorLunartec::IRTranslatorLunartec() : IRTranslatorTable(lunartecCodes, sizeof(lunartecCodes) / sizeof(IRCode)) {
+}
 
-        default:
-            return REMOTE_BUTTON_UNDEFINED;
-    }
+void IRTranslatorLunartec::printSignature() {
+    Serial.println(F("Lunartec NX6612-901"));
 }
@@ -4,13 +4,14 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.1
+ * @version  1.2
  * @created  7.2.2015
- * @updated  16.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
  * V 1.1:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt..
+ * V 1.2:  - Codes als sortierte Tabelle im PROGMEM (IRTranslatorTable).
  */
 #include "IRTranslatorMooncandles.h"
 
@@ -41,66 +42,31 @@
 #define MOONCANDLES_HELLBLAU      0x1FEB04F
 #define MOONCANDLES_MAGENTA       0x1FE708F
 
-void IRTranslatorMooncandles::printSignature() {
-    Serial.println(F("Mooncandles"));
-}
-
-byte IRTranslatorMooncandles::buttonForCode(unsigned long code) {
-    switch (code) {
-        case MOONCANDLES_ON:
-            return REMOTE_BUTTON_RESUME;
-        case MOONCANDLES_OFF:
-            return REMOTE_BUTTON_BLANK;
-        case MOONCANDLES_MODE:
-            return REMOTE_BUTTON_MODE;
-        case MOONCANDLES_4H:
-            return REMOTE_BUTTON_HOUR_PLUS;
-        case MOONCANDLES_8H:
-            return REMOTE_BUTTON_MINUTE_PLUS;
-        case MOONCANDLES_MULTI_COLOR:
-            return REMOTE_BUTTON_EXTMODE;
-
-        case MOONCANDLES_ROT:
-            setColor(255, 0, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case MOONCANDLES_GRUEN:
-            setColor(0, 255, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case MOONCANDLES_BLAU:
-            setColor(0, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
+// Aufsteigend nach Code sortiert (binaere Suche)!
+const IRCode mooncandlesCodes[] PROGMEM = {
+    { MOONCANDLES_HELLGRUEN,     REMOTE_BUTTON_SETCOLOR,      0, 255,  64 },
+    { MOONCANDLES_ROT,           REMOTE_BUTTON_SETCOLOR,    255,   0,   0 },
+    { MOONCANDLES_WEISS,         REMOTE_BUTTON_SETCOLOR,    255, 255, 255 },
+    { MOONCANDLES_8H,            REMOTE_BUTTON_MINUTE_PLUS,   0,   0,   0 },
+    { MOONCANDLES_ON,            REMOTE_BUTTON_RESUME,        0,   0,   0 },
+    { MOONCANDLES_GELB,          REMOTE_BUTTON_SETCOLOR,    255, 255,   0 },
+    { MOONCANDLES_OFF,           REMOTE_BUTTON_BLANK,         0,   0,   0 },
+    { MOONCANDLES_BLAU,          REMOTE_BUTTON_SETCOLOR,      0,   0, 255 },
+    { MOONCANDLES_MAGENTA,       REMOTE_BUTTON_SETCOLOR,    196,   0, 255 },
+    { MOONCANDLES_MODE,          REMOTE_BUTTON_MODE,          0,   0,   0 },
+    { MOONCANDLES_4H,            REMOTE_BUTTON_HOUR_PLUS,     0,   0,   0 },
+    { MOONCANDLES_HELLERES_BLAU, REMOTE_BUTTON_SETCOLOR,     64,   0, 255 },
+    { MOONCANDLES_GRUEN,         REMOTE_BUTTON_SETCOLOR,      0, 255,   0 },
+    { MOONCANDLES_HELLBLAU,      REMOTE_BUTTON_SETCOLOR,      0, 255, 196 },
+    { MOONCANDLES_MULTI_COLOR,   REMOTE_BUTTON_EXTMODE,       0,   0,   0 },
+    { MOONCANDLES_TUERKIS,       REMOTE_BUTTON_SETCOLOR,      0, 255, 128 },
+    { MOONCANDLES_ORANGE,        REMOTE_BUTTON_SETCOLOR,    255, 128,   0 },
+    { MOONCANDLES_PINK,          REMOTE_BUTTON_SETCOLOR,    128,   0, 255 }
+};
 
-        case MOONCANDLES_ORANGE:
-            setColor(255, 128, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case MOONCANDLES_HELLGRUEN:
-            setColor(0, 255, 64);
-            return REMOTE_BUTTON_SETCOLOR;
-        case MOONCANDLES_HELLERES_BLAU:
-            setColor(64, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
-
-        case MOONCANDLES_GELB:
-            setColor(255, 255, 0);
-            return REMOTE_BUTTON_SETCOLOR;
-        case MOONCANDLES_TUERKIS:
-            setColor(0, 255, 128);
-            return REMOTE_BUTTON_SETCOLOR;
-        case MOONCANDLES_PINK:
-            setColor(128, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
-
-        case MOONCANDLES_WEISS:
-            setColor(255, 255, 255);
-            return REMOTE_BUTTON_SETCOLOR;
-        case MOONCANDLES_HELLBLAU:
-            setColor(0, 255, 196);
-            return REMOTE_BUTTON_SETCOLOR;
-        case MOONCANDLES_MAGENTA:
-            setColor(196, 0, 255);
-            return REMOTE_BUTTON_SETCOLOR;
+IRTranslatorMooncandles::IRTranslatorMooncandles() : IRTranslatorTable(mooncandlesCodes, sizeof(mooncandlesCodes) / sizeof(IRCode)) {
+}
 
-        default:
-            return REMOTE_BUTTON_UNDEFINED;
-    }
+void IRTranslatorMooncandles::printSignature() {
+    Serial.println(F("Mooncandles"));
 }
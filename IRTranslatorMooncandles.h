@@ -4,24 +4,26 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.1
+ * @version  1.2
  * @created  7.2.2015
- * @updated  16.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
  * V 1.1:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt..
+ * V 1.2:  - Codes als sortierte Tabelle im PROGMEM (IRTranslatorTable).
  */
 #ifndef IRTRANSLATORMOONCANDLES_H
 #define IRTRANSLATORMOONCANDLES_H
 
 #include "Arduino.h"
-#include "IRTranslator.h"
+#include "IRTranslatorTable.h"
 
-class IRTranslatorMooncandles : public IRTranslator {
+class IRTranslatorMooncandles : public IRTranslatorTable {
 public:
+    IRTranslatorMooncandles();
+
     void printSignature();
-    byte buttonForCode(unsigned long code);
 };
 
 #endif
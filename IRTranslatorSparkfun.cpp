@@ -4,13 +4,14 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.1
+ * @version  1.2
  * @created  7.2.2015
- * @updated  16.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
  * V 1.1:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
+ * V 1.2:  - Codes als sortierte Tabelle im PROGMEM (IRTranslatorTable).
  */
 #include "IRTranslatorSparkfun.h"
 
@@ -28,29 +29,22 @@
 #define SPARKFUN_RIGHT  0x10EF807F
 #define SPARKFUN_SELECT 0x10EF20DF
 
-void IRTranslatorSparkfun::printSignature() {
-    Serial.println(F("Sparkfun COM-11759"));
+// Aufsteigend nach Code sortiert (binaere Suche)!
+const IRCode sparkfunCodes[] PROGMEM = {
+    { SPARKFUN_DOWN,   REMOTE_BUTTON_DARKER,        0,   0,   0 },
+    { SPARKFUN_LEFT,   REMOTE_BUTTON_HOUR_PLUS,     0,   0,   0 },
+    { SPARKFUN_SELECT, REMOTE_BUTTON_EXTMODE,       0,   0,   0 },
+    { SPARKFUN_C,      REMOTE_BUTTON_MINUTE_PLUS,   0,   0,   0 },
+    { SPARKFUN_B,      REMOTE_BUTTON_HOUR_PLUS,     0,   0,   0 },
+    { SPARKFUN_RIGHT,  REMOTE_BUTTON_MINUTE_PLUS,   0,   0,   0 },
+    { SPARKFUN_UP,     REMOTE_BUTTON_BRIGHTER,      0,   0,   0 },
+    { SPARKFUN_POWER,  REMOTE_BUTTON_TOGGLEBLANK,   0,   0,   0 },
+    { SPARKFUN_A,      REMOTE_BUTTON_MODE,          0,   0,   0 }
+};
+
+IRTranslatorSparkfun::IRTranslatorSparkfun() : IRTranslatorTable(sparkfunCodes, sizeof(sparkfunCodes) / sizeof(IRCode)) {
 }
 
-byte IRTranslatorSparkfun::buttonForCode(unsigned long code) {
-    switch (code) {
-        case SPARKFUN_POWER:
-            return REMOTE_BUTTON_TOGGLEBLANK;
-        case SPARKFUN_A:
-            return REMOTE_BUTTON_MODE;
-        case SPARKFUN_LEFT:
-        case SPARKFUN_B:
-            return REMOTE_BUTTON_HOUR_PLUS;
-        case SPARKFUN_RIGHT:
-        case SPARKFUN_C:
-            return REMOTE_BUTTON_MINUTE_PLUS;
-        case SPARKFUN_UP:
-            return REMOTE_BUTTON_BRIGHTER;
-        case SPARKFUN_DOWN:
-            return REMOTE_BUTTON_DARKER;
-        case SPARKFUN_SELECT:
-            return REMOTE_BUTTON_EXTMODE;
-        default:
-            return REMOTE_BUTTON_UNDEFINED;
-    }
+void IRTranslatorSparkfun::printSignature() {
+    Serial.println(F("Sparkfun COM-11759"));
 }
@@ -0,0 +1,160 @@
+/**
+ * IRTranslatorTable
+ * Tabellengesteuerte Umsetzung von Fernbedienungs-Codes. Eine Fernbedienung
+ * wird nur noch als aufsteigend nach Code sortierte Tabelle im PROGMEM
+ * beschrieben, gesucht wird binaer.
+ * Zusaetzlich koennen unbekannte Codes angelernt werden. Diese liegen im EEPROM.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "IRTranslatorTable.h"
+#include <avr/pgmspace.h>
+#ifdef IR_LEARN_ENABLE
+    #include <EEPROM.h>
+#endif
+
+// #define DEBUG
+#include "Debug.h"
+
+/*
+ * Aufbau der angelernten Codes im EEPROM (ab IR_LEARN_EEPROM_START):
+ * Byte 0: naechster zu ueberschreibender Platz, wenn alle belegt sind.
+ * Danach IR_LEARN_MAX_CODES Plaetze zu je 5 Byte: Code (4 Byte, little endian), Taste.
+ * Ein freier Platz hat die Taste 0xFF (geloeschtes EEPROM) oder REMOTE_BUTTON_UNDEFINED.
+ */
+#define IR_LEARN_SLOT_SIZE 5
+#define IR_LEARN_SLOT_ADDRESS(i) (IR_LEARN_EEPROM_START + 1 + (i) * IR_LEARN_SLOT_SIZE)
+#define IR_LEARN_SLOT_FREE 0xFF
+
+/**
+ * Initialisierung mit der Code-Tabelle der Fernbedienung.
+ *
+ * @param codes Die Tabelle im PROGMEM, aufsteigend nach Code sortiert.
+ * @param count Die Anzahl der Eintraege.
+ */
+IRTranslatorTable::IRTranslatorTable(const IRCode* codes, byte count) {
+    _codes = codes;
+    _count = count;
+}
+
+/**
+ * Die Taste zu einem Code suchen. Erst in den angelernten Codes,
+ * dann binaer in der Tabelle.
+ */
+byte IRTranslatorTable::buttonForCode(unsigned long code) {
+#ifdef IR_LEARN_ENABLE
+    int slot = _learnedSlot(code);
+    if (slot >= 0) {
+        return EEPROM.read(IR_LEARN_SLOT_ADDRESS(slot) + 4);
+    }
+#endif
+
+    byte low = 0;
+    byte high = _count;
+    while (low < high) {
+        byte mid = (low + high) / 2;
+        unsigned long midCode = pgm_read_dword_near(&_codes[mid].code);
+        if (midCode < code) {
+            low = mid + 1;
+        } else if (midCode > code) {
+            high = mid;
+        } else {
+            byte button = pgm_read_byte_near(&_codes[mid].button);
+            if (button == REMOTE_BUTTON_SETCOLOR) {
+                setColor(pgm_read_byte_near(&_codes[mid].red), pgm_read_byte_near(&_codes[mid].green), pgm_read_byte_near(&_codes[mid].blue));
+            }
+            return button;
+        }
+    }
+
+    DEBUG_PRINT(F("Unknown IR code: "));
+    DEBUG_PRINTLN2(code, HEX);
+    return REMOTE_BUTTON_UNDEFINED;
+}
+
+#ifdef IR_LEARN_ENABLE
+/**
+ * Einen Code fuer eine Taste anlernen. Ist der Code schon angelernt, wird
+ * nur die Taste geaendert. Mit REMOTE_BUTTON_UNDEFINED wird der Code vergessen.
+ *
+ * @param code Der empfangene Code.
+ * @param button Die Taste (REMOTE_BUTTON_*, ohne REMOTE_BUTTON_SETCOLOR).
+ */
+void IRTranslatorTable::learnCode(unsigned long code, byte button) {
+    int slot = _learnedSlot(code);
+    if (slot < 0) {
+        if (button == REMOTE_BUTTON_UNDEFINED) {
+            return;
+        }
+        // freien Platz suchen...
+        for (byte i = 0; i < IR_LEARN_MAX_CODES; i++) {
+            byte b = EEPROM.read(IR_LEARN_SLOT_ADDRESS(i) + 4);
+            if ((b == IR_LEARN_SLOT_FREE) || (b == REMOTE_BUTTON_UNDEFINED)) {
+                slot = i;
+                break;
+            }
+        }
+        // ... sonst reihum ueberschreiben.
+        if (slot < 0) {
+            slot = EEPROM.read(IR_LEARN_EEPROM_START) % IR_LEARN_MAX_CODES;
+            EEPROM.write(IR_LEARN_EEPROM_START, (slot + 1) % IR_LEARN_MAX_CODES);
+        }
+        for (byte i = 0; i < 4; i++) {
+            EEPROM.write(IR_LEARN_SLOT_ADDRESS(slot) + i, (code >> (8 * i)) & 0xFF);
+        }
+    }
+    if (EEPROM.read(IR_LEARN_SLOT_ADDRESS(slot) + 4) != button) {
+        EEPROM.write(IR_LEARN_SLOT_ADDRESS(slot) + 4, button);
+    }
+
+    DEBUG_PRINT(F("Learned IR code "));
+    DEBUG_PRINT2(code, HEX);
+    DEBUG_PRINT(F(" as button "));
+    DEBUG_PRINT(button);
+    DEBUG_PRINT(F(" in slot "));
+    DEBUG_PRINTLN(slot);
+}
+
+/**
+ * Wieviele Codes sind angelernt?
+ */
+byte IRTranslatorTable::getLearnedCodesCount() {
+    byte count = 0;
+    for (byte i = 0; i < IR_LEARN_MAX_CODES; i++) {
+        byte b = EEPROM.read(IR_LEARN_SLOT_ADDRESS(i) + 4);
+        if ((b != IR_LEARN_SLOT_FREE) && (b != REMOTE_BUTTON_UNDEFINED)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Den Platz eines angelernten Codes suchen.
+ *
+ * @return Der Platz oder -1, wenn der Code nicht angelernt ist.
+ */
+int IRTranslatorTable::_learnedSlot(unsigned long code) {
+    for (byte i = 0; i < IR_LEARN_MAX_CODES; i++) {
+        byte b = EEPROM.read(IR_LEARN_SLOT_ADDRESS(i) + 4);
+        if ((b == IR_LEARN_SLOT_FREE) || (b == REMOTE_BUTTON_UNDEFINED)) {
+            continue;
+        }
+        unsigned long c = 0;
+        for (byte j = 4; j > 0; j--) {
+            c = (c << 8) | EEPROM.read(IR_LEARN_SLOT_ADDRESS(i) + j - 1);
+        }
+        if (c == code) {
+            return i;
+        }
+    }
+    return -1;
+}
+#endif
@@ -0,0 +1,56 @@
+/**
+ * IRTranslatorTable
+ * Tabellengesteuerte Umsetzung von Fernbedienungs-Codes. Eine Fernbedienung
+ * wird nur noch als aufsteigend nach Code sortierte Tabelle im PROGMEM
+ * beschrieben, gesucht wird binaer.
+ * Zusaetzlich koennen unbekannte Codes angelernt werden. Diese liegen im EEPROM.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef IRTRANSLATORTABLE_H
+#define IRTRANSLATORTABLE_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "IRTranslator.h"
+
+/*
+ * Ein Eintrag der Code-Tabelle. Die Farbe wird nur bei
+ * REMOTE_BUTTON_SETCOLOR ausgewertet.
+ */
+struct IRCode {
+    unsigned long code;
+    byte button;
+    byte red;
+    byte green;
+    byte blue;
+};
+
+class IRTranslatorTable : public IRTranslator {
+public:
+    IRTranslatorTable(const IRCode* codes, byte count);
+
+    byte buttonForCode(unsigned long code);
+
+#ifdef IR_LEARN_ENABLE
+    void learnCode(unsigned long code, byte button);
+    byte getLearnedCodesCount();
+#endif
+
+private:
+    const IRCode* _codes;
+    byte _count;
+
+#ifdef IR_LEARN_ENABLE
+    int _learnedSlot(unsigned long code);
+#endif
+};
+
+#endif
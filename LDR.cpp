@@ -4,9 +4,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.8a
+ * @version  1.9
  * @created  18.3.2012
- * @updated  28.05.2016 (Ergänzungen und Änderungen von A. Mueller)
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.1:  - Optimierung hinsichtlich Speicherbedarf.
@@ -19,6 +19,7 @@
  * V 1.8:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
  * V 1.8a: - Klammerung in Zeile 62 korrigiert.
  *         - Speichern der im LDR_AUTOSCALE-Modus ermittelten _min- und _max-Werte in das EEPROM.
+ * V 1.9:  - Der Wert kommt gefiltert aus dem AnalogSampler (ADC im Hintergrund), kein analogRead() mehr.
  */
 #include "LDR.h"
 
@@ -31,6 +32,7 @@
  * eingemessen werden (LDR_AUTOSCALE).
  * Ansonsten muss man diese Werte im #define-DEBUG-Mode
  * ausmessen und eintragen.
+ * Der Pin wird beim AnalogSampler angemeldet.
  */
 LDR::LDR(byte pin, boolean isInverted, Settings* settings) {
     _pin = pin;
@@ -38,6 +40,7 @@ LDR::LDR(byte pin, boolean isInverted, Settings* settings) {
     _lastValue = 0;
     _outputValue = 0;
     _settings = settings;
+    analogSampler.addChannel(_pin, LDR_FILTER_SHIFT);
 #ifndef LDR_AUTOSCALE
     _min = LDR_MANUAL_MIN;
     _max = LDR_MANUAL_MAX;
@@ -46,6 +49,7 @@ LDR::LDR(byte pin, boolean isInverted, Settings* settings) {
 
 /**
  * Welchen Wert hat der LDR? In Prozent...
+ * Der Wert ist bereits im ADC-Interrupt gefiltert, die Abfrage wartet nicht.
  */
 byte LDR::value() {
     unsigned int rawVal, val;
@@ -54,7 +58,10 @@ byte LDR::value() {
         _max = _settings->getLdrAutoMax();
     #endif
 
-    rawVal = analogRead(_pin);
+    if (!analogSampler.isReady(_pin)) {
+        return _outputValue;
+    }
+    rawVal = analogSampler.getValue(_pin);
     if (_isInverted) {
         rawVal = 1023 - rawVal;
     }
@@ -4,9 +4,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.8a
+ * @version  1.9
  * @created  18.3.2012
- * @updated  28.05.2016 (Ergänzungen und Änderungen von A. Mueller)
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.1:  - Optimierung hinsichtlich Speicherbedarf.
@@ -19,6 +19,7 @@
  * V 1.8:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
  * V 1.8a: - Klammerung in Zeile 62 korrigiert.
  *         - Speichern der im LDR_AUTOSCALE-Modus ermittelten _min- und _max-Werte in das EEPROM.
+ * V 1.9:  - Der Wert kommt gefiltert aus dem AnalogSampler (ADC im Hintergrund), kein analogRead() mehr.
  */
 #ifndef LDR_H
 #define LDR_H
@@ -26,6 +27,7 @@
 #include "Arduino.h"
 #include "Configuration.h"
 #include "Settings.h"
+#include "AnalogSampler.h"
 
 class LDR {
 public:
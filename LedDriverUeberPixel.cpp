@@ -4,9 +4,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.4
+ * @version  1.5
  * @created  18.1.2013
- * @updated  16.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
@@ -15,6 +15,7 @@
  * V 1.2:  - Anpassung auf Helligkeit 0-100%
  * V 1.3:  - Getter fuer Helligkeit nachgezogen.
  * V 1.4:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
+ * V 1.5:  - Mit FAST_BOOT entfaellt der Lauf durch die Eck-LEDs in init() (1s).
  */
 #include "LedDriverUeberPixel.h"
 
@@ -40,6 +41,7 @@ LedDriverUeberPixel::LedDriverUeberPixel(byte data, byte clock, byte load) {
 void LedDriverUeberPixel::init() {
     setBrightness(100);
     wakeUp();
+#ifndef FAST_BOOT
     _ledControl->setLed(0, 6, 5, true); // 1
     delay(250);
     _ledControl->setLed(1, 5, 5, true); // 2
@@ -48,6 +50,7 @@ void LedDriverUeberPixel::init() {
     delay(250);
     _ledControl->setLed(3, 5, 5, true); // 4
     delay(250);
+#endif
 }
 
 void LedDriverUeberPixel::printSignature() {
@@ -4,9 +4,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.4
+ * @version  1.5
  * @created  18.1.2013
- * @updated  16.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
@@ -15,11 +15,13 @@
  * V 1.2:  - Anpassung auf Helligkeit 0-100%
  * V 1.3:  - Getter fuer Helligkeit nachgezogen.
  * V 1.4:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
+ * V 1.5:  - Mit FAST_BOOT entfaellt der Lauf durch die Eck-LEDs in init() (1s).
  */
 #ifndef LED_DRIVER_UEBERPIXEL_H
 #define LED_DRIVER_UEBERPIXEL_H
 
 #include "Arduino.h"
+#include "Configuration.h"
 #include <LedControl.h>
 #include "LedDriver.h"
 
@@ -0,0 +1,46 @@
+/**
+ * LogMessages
+ * Die Texte der Log-Eintraege (LOG0..LOG3, LOG_BYTES in Debug.h).
+ * Die Nummer eines Eintrags ist seine Position in der Liste, neue Eintraege
+ * deshalb nur hinten anfuegen. Mit DEBUG_BINARY_LOG kommen die Texte nicht in
+ * den Flash, tools/logdecoder.py liest sie aus dieser Datei.
+ *
+ * Platzhalter (die Argumente sind 16 Bit, little endian):
+ * %d: mit Vorzeichen, %u: ohne Vorzeichen, %x: hexadezimal,
+ * %W: alle restlichen Argumente (ohne Vorzeichen),
+ * %B: alle restlichen Bytes (hexadezimal), %P: alle restlichen Bytes als Bits (niedrigstes zuerst).
+ *
+ * Die Datei hat absichtlich keinen Include-Schutz, sie wird mit
+ * verschiedenen Definitionen von LOG_MESSAGE() mehrfach eingebunden.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+LOG_MESSAGE(LOG_DROPPED,              "Log: %u Eintraege verworfen.")
+LOG_MESSAGE(LOG_MODE,                 "Mode | nightByTimeLock | nightLock: %u | %u | %u")
+LOG_MESSAGE(LOG_TIME,                 "RTC: %u:%u %u.%u.%u")
+LOG_MESSAGE(LOG_DCF_CAPTURED,         "Captured: %u:%u %u.%u.%u")
+LOG_MESSAGE(LOG_DCF_ENABLE,           "DCF77-Empfaenger aufgeweckt.")
+LOG_MESSAGE(LOG_DCF_DISABLE,          "DCF77-Empfaenger schlafen gelegt.")
+LOG_MESSAGE(LOG_DCF_DRIFT,            "Driftkorrektur erforderlich! Offset: %d")
+LOG_MESSAGE(LOG_DCF_BINS,             "Bins: %W")
+LOG_MESSAGE(LOG_DCF_SIGNAL,           "Drift: %d Average: %u Highcount: %u")
+LOG_MESSAGE(LOG_DCF_BITS,             "Bits (Pointer %u): %P")
+LOG_MESSAGE(LOG_DCF_DECODE,           "Decoding telegram...")
+LOG_MESSAGE(LOG_DCF_CHECK_M,          "Check-bit M failed.")
+LOG_MESSAGE(LOG_DCF_CHECK_S,          "Check-bit S failed.")
+LOG_MESSAGE(LOG_DCF_CHECK_Z,          "Check Z1 != Z2 failed.")
+LOG_MESSAGE(LOG_DCF_CHECK_P1,         "Check-bit P1: minutes failed.")
+LOG_MESSAGE(LOG_DCF_CHECK_P2,         "Check-bit P2: hours failed.")
+LOG_MESSAGE(LOG_DCF_CHECK_P3,         "Check-bit P3: date failed.")
+LOG_MESSAGE(LOG_DCF_TELEGRAM,         "Minutes: %u Hours: %u Date: %u Day of week: %u Month: %u Year: %u")
+LOG_MESSAGE(LOG_DCF_RANGE_MINUTES,    "Minutes out of range.")
+LOG_MESSAGE(LOG_DCF_RANGE_HOURS,      "Hours out of range.")
+LOG_MESSAGE(LOG_DCF_RANGE_DATE,       "Date out of range.")
+LOG_MESSAGE(LOG_DCF_RANGE_MONTH,      "Month out of range.")
@@ -0,0 +1,160 @@
+/**
+ * LoopProfiler
+ * Misst die Laufzeit der Abschnitte von loop() mit micros(). Pro Abschnitt
+ * werden Minimum, Maximum, ein gleitender Mittelwert und ein Histogramm mit
+ * Klassen in Zweierpotenzen gefuehrt (zusammen 14 Byte). So sieht man, welcher
+ * Abschnitt gelegentlich lange braucht und die Anzeige flackern laesst.
+ * Die Abschnitte werden hintereinander gemessen: mark() schliesst den
+ * Abschnitt seit dem letzten begin(), mark() oder skip() ab.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "LoopProfiler.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+/**
+ * Die Namen der Abschnitte fuer die Ausgabe ueber Serial...
+ */
+const char profilerStageNames[][8] PROGMEM = {
+    "LDR", "NEAR", "RTC", "RENDER", "DRIVER", "IR", "BUTTONS", "ALARM", "REFRESH", "DCF"
+};
+
+/**
+ * ...und als zwei Staben fuer die Anzeige.
+ */
+const char profilerStageCodes[][2] PROGMEM = {
+    {'L', 'D'}, {'N', 'S'}, {'R', 'T'}, {'R', 'E'}, {'D', 'R'}, {'I', 'R'}, {'B', 'U'}, {'A', 'L'}, {'R', 'F'}, {'D', 'C'}
+};
+
+LoopProfiler::LoopProfiler() {
+    reset();
+}
+
+/**
+ * Alle Werte loeschen.
+ */
+void LoopProfiler::reset() {
+    for (byte i = 0; i < PROFILER_STAGES; i++) {
+        _stages[i].min = 0xFFFF;
+        _stages[i].max = 0;
+        _stages[i].mean = 0;
+        for (byte j = 0; j < PROFILER_BINS; j++) {
+            _stages[i].bins[j] = 0;
+        }
+    }
+    _loops = 0;
+    _resetTime = millis();
+    _last = micros();
+}
+
+/**
+ * Am Anfang von loop(): Zaehlt den Durchlauf und beginnt den ersten Abschnitt.
+ */
+void LoopProfiler::begin() {
+    if (_loops < 0xFFFF) {
+        _loops++;
+    }
+    _last = micros();
+}
+
+/**
+ * Die Zeit seit dem letzten Abschnitt keinem Abschnitt zurechnen.
+ */
+void LoopProfiler::skip() {
+    _last = micros();
+}
+
+/**
+ * Den Abschnitt abschliessen und seine Laufzeit eintragen.
+ */
+void LoopProfiler::mark(byte stage) {
+    unsigned long now = micros();
+    unsigned long duration = now - _last;
+    _last = now;
+
+    word t = (duration > 0xFFFF) ? 0xFFFF : duration;
+    ProfilerStage* s = &_stages[stage];
+    if (t < s->min) {
+        s->min = t;
+    }
+    if (t > s->max) {
+        s->max = t;
+    }
+    // Gleitender Mittelwert ueber etwa acht Durchlaeufe
+    s->mean += ((long) t - (long) s->mean) / 8;
+
+    byte bin = 0;
+    t >>= PROFILER_BIN_0_SHIFT;
+    while (t && (bin < PROFILER_BINS - 1)) {
+        t >>= 1;
+        bin++;
+    }
+    if (s->bins[bin] == 0xFF) {
+        // Alle Klassen halbieren, belegte Klassen bleiben aber sichtbar
+        for (byte i = 0; i < PROFILER_BINS; i++) {
+            s->bins[i] = (s->bins[i] + 1) >> 1;
+        }
+    }
+    s->bins[bin]++;
+}
+
+word LoopProfiler::getMin(byte stage) {
+    return (_stages[stage].min == 0xFFFF) ? 0 : _stages[stage].min;
+}
+
+word LoopProfiler::getMax(byte stage) {
+    return _stages[stage].max;
+}
+
+word LoopProfiler::getMean(byte stage) {
+    return _stages[stage].mean;
+}
+
+byte LoopProfiler::getBin(byte stage, byte bin) {
+    return _stages[stage].bins[bin];
+}
+
+/**
+ * Der Kurzname (zwei Staben) eines Abschnitts.
+ */
+char LoopProfiler::getCode(byte stage, byte index) {
+    return pgm_read_byte_near(&profilerStageCodes[stage][index]);
+}
+
+/**
+ * Alle Abschnitte ueber Serial ausgeben (Zeiten in us).
+ */
+void LoopProfiler::dump() {
+    unsigned long elapsed = millis() - _resetTime;
+    Serial.print(F("Loop profile, loops/s: "));
+    Serial.println(elapsed ? (unsigned long) _loops * 1000 / elapsed : 0);
+    Serial.println(F("stage    min   max   mean  | <64 <128 <256 <512 <1k <2k <4k >=4k"));
+    for (byte i = 0; i < PROFILER_STAGES; i++) {
+        const __FlashStringHelper* name = (const __FlashStringHelper*) profilerStageNames[i];
+        Serial.print(name);
+        for (byte j = strlen_P(profilerStageNames[i]); j < 9; j++) {
+            Serial.print(' ');
+        }
+        Serial.print(getMin(i));
+        Serial.print(' ');
+        Serial.print(getMax(i));
+        Serial.print(' ');
+        Serial.print(getMean(i));
+        Serial.print(F(" |"));
+        for (byte j = 0; j < PROFILER_BINS; j++) {
+            Serial.print(' ');
+            Serial.print(_stages[i].bins[j]);
+        }
+        Serial.println();
+    }
+    Serial.flush();
+}
@@ -0,0 +1,84 @@
+/**
+ * LoopProfiler
+ * Misst die Laufzeit der Abschnitte von loop() mit micros(). Pro Abschnitt
+ * werden Minimum, Maximum, ein gleitender Mittelwert und ein Histogramm mit
+ * Klassen in Zweierpotenzen gefuehrt (zusammen 14 Byte). So sieht man, welcher
+ * Abschnitt gelegentlich lange braucht und die Anzeige flackern laesst.
+ * Die Abschnitte werden hintereinander gemessen: mark() schliesst den
+ * Abschnitt seit dem letzten begin(), mark() oder skip() ab.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef LOOPPROFILER_H
+#define LOOPPROFILER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+// Die Abschnitte von loop()
+#define PROFILER_STAGE_LDR      0
+#define PROFILER_STAGE_NEAR     1
+#define PROFILER_STAGE_RTC      2
+#define PROFILER_STAGE_RENDER   3
+#define PROFILER_STAGE_DRIVER   4
+#define PROFILER_STAGE_IR       5
+#define PROFILER_STAGE_BUTTONS  6
+#define PROFILER_STAGE_ALARM    7
+#define PROFILER_STAGE_REFRESH  8
+#define PROFILER_STAGE_DCF      9
+#define PROFILER_STAGES         10
+
+// Klasse 0: < 64 us, Klasse n: 32 << n bis 64 << n us, Klasse 7: >= 4096 us
+#define PROFILER_BINS           8
+#define PROFILER_BIN_0_SHIFT    6
+
+struct ProfilerStage {
+    word min;
+    word max;
+    word mean;
+    byte bins[PROFILER_BINS];
+};
+
+class LoopProfiler {
+public:
+    LoopProfiler();
+
+    void reset();
+    void begin();
+    void skip();
+    void mark(byte stage);
+
+    word getMin(byte stage);
+    word getMax(byte stage);
+    word getMean(byte stage);
+    byte getBin(byte stage, byte bin);
+    char getCode(byte stage, byte index);
+
+    void dump();
+
+private:
+    ProfilerStage _stages[PROFILER_STAGES];
+    unsigned long _last;
+    unsigned long _resetTime;
+    word _loops;
+};
+
+#ifdef LOOP_PROFILER
+    extern LoopProfiler loopProfiler;
+    #define PROFILE_BEGIN()     loopProfiler.begin()
+    #define PROFILE_SKIP()      loopProfiler.skip()
+    #define PROFILE_MARK(stage) loopProfiler.mark(stage)
+#else
+    #define PROFILE_BEGIN()
+    #define PROFILE_SKIP()
+    #define PROFILE_MARK(stage)
+#endif
+
+#endif
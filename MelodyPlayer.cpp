@@ -0,0 +1,168 @@
+/**
+ * MelodyPlayer
+ * Spielt eine Melodie (MelodyStream) komplett im Interrupt von Timer1 ab.
+ * Damit haengt das Timing nicht mehr von der Last in loop() ab.
+ * Ein Buzzer (SPEAKER_IS_BUZZER) wird im 1ms-Takt ein- und ausgeschaltet,
+ * einen Lautsprecher schaltet der Interrupt mit der doppelten Tonfrequenz um.
+ *
+ * Timer1 darf nicht anderweitig benutzt werden (z. B. IR_SEND_ENABLE auf
+ * manchen Boards).
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "MelodyPlayer.h"
+#include <avr/interrupt.h>
+
+// #define DEBUG
+#include "Debug.h"
+
+// Hoechstens so viele Ereignisse ohne Dauer pro Interrupt (Schutz vor leeren Endlosschleifen)
+#define MELODY_MAX_EVENTS_PER_TICK 8
+// Darunter laeuft OCR1A ueber
+#define MELODY_MIN_FREQUENCY 31
+
+MelodyPlayer melodyPlayer;
+
+ISR(TIMER1_COMPA_vect) {
+    melodyPlayer.onTick();
+}
+
+/**
+ * Den Pin des Lautsprechers/Buzzers setzen (-1 bzw. 255 = keiner).
+ */
+void MelodyPlayer::begin(byte pin) {
+    _isPlaying = false;
+    _pinMask = 0;
+    if (pin == 255) {
+        return;
+    }
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    _pinPort = portOutputRegister(digitalPinToPort(pin));
+    _pinMask = digitalPinToBitMask(pin);
+}
+
+/**
+ * Eine Melodie (im PROGMEM) von vorne spielen.
+ */
+void MelodyPlayer::play(const uint16_t* melody) {
+    stop();
+    _stream.begin(melody);
+    _frequency = (SPEAKER_FREQUENCY > 0x1FFF) ? 0x1FFF : SPEAKER_FREQUENCY;
+    if (_frequency < MELODY_MIN_FREQUENCY) {
+        _frequency = MELODY_MIN_FREQUENCY;
+    }
+    _toneOn = false;
+    _ticksLeft = 1;
+    _isPlaying = true;
+
+    // Timer1: CTC, Vorteiler 8 (2MHz bei 16MHz)
+    TCCR1A = 0;
+    TCCR1B = _BV(WGM12) | _BV(CS11);
+    _tickRate = 0;
+    _setTickRate(1000);
+    TCNT1 = 0;
+    TIFR1 = _BV(OCF1A);
+    TIMSK1 |= _BV(OCIE1A);
+}
+
+/**
+ * Die Melodie anhalten und den Ton ausschalten.
+ */
+void MelodyPlayer::stop() {
+    TIMSK1 &= ~_BV(OCIE1A);
+    TCCR1B = 0;
+    _isPlaying = false;
+    _toneOn = false;
+    _pin(false);
+}
+
+boolean MelodyPlayer::isPlaying() {
+    return _isPlaying;
+}
+
+/**
+ * Der Takt: Lautsprecher umschalten und die Dauer des Ereignisses abzaehlen.
+ */
+void MelodyPlayer::onTick() {
+#ifndef SPEAKER_IS_BUZZER
+    if (_toneOn && (_pinMask != 0)) {
+        *_pinPort ^= _pinMask;
+    }
+#endif
+    _ticksLeft--;
+    if (_ticksLeft == 0) {
+        _advance();
+    }
+}
+
+/**
+ * Das naechste Ereignis der Melodie beginnen.
+ */
+void MelodyPlayer::_advance() {
+    uint16_t argument;
+    for (byte i = 0; i < MELODY_MAX_EVENTS_PER_TICK; i++) {
+        byte event = _stream.next(&argument);
+        if (event == MELODY_EVENT_FREQUENCY) {
+            _frequency = (argument < MELODY_MIN_FREQUENCY) ? MELODY_MIN_FREQUENCY : argument;
+            continue;
+        }
+        if (event == MELODY_EVENT_END) {
+            stop();
+            return;
+        }
+        if (argument == 0) {
+            continue;
+        }
+        _toneOn = (event == MELODY_EVENT_TONE);
+#ifdef SPEAKER_IS_BUZZER
+        // Der Buzzer macht den Ton selbst, es reicht der ms-Takt.
+        _pin(_toneOn);
+        _ticksLeft = argument;
+#else
+        _pin(false);
+        if (_toneOn) {
+            // Zwei Ticks pro Schwingung
+            _setTickRate(2 * _frequency);
+            _ticksLeft = (uint32_t) argument * 2 * _frequency / 1000;
+            if (_ticksLeft == 0) {
+                _ticksLeft = 1;
+            }
+        } else {
+            _setTickRate(1000);
+            _ticksLeft = argument;
+        }
+#endif
+        return;
+    }
+    stop();
+}
+
+/**
+ * Die Interrupt-Rate setzen (Ticks pro Sekunde).
+ */
+void MelodyPlayer::_setTickRate(uint16_t rate) {
+    if (rate != _tickRate) {
+        _tickRate = rate;
+        OCR1A = (F_CPU / 8) / rate - 1;
+        TCNT1 = 0;
+    }
+}
+
+void MelodyPlayer::_pin(boolean on) {
+    if (_pinMask == 0) {
+        return;
+    }
+    if (on) {
+        *_pinPort |= _pinMask;
+    } else {
+        *_pinPort &= ~_pinMask;
+    }
+}
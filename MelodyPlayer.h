@@ -0,0 +1,56 @@
+/**
+ * MelodyPlayer
+ * Spielt eine Melodie (MelodyStream) komplett im Interrupt von Timer1 ab.
+ * Damit haengt das Timing nicht mehr von der Last in loop() ab.
+ * Ein Buzzer (SPEAKER_IS_BUZZER) wird im 1ms-Takt ein- und ausgeschaltet,
+ * einen Lautsprecher schaltet der Interrupt mit der doppelten Tonfrequenz um.
+ *
+ * Timer1 darf nicht anderweitig benutzt werden (z. B. IR_SEND_ENABLE auf
+ * manchen Boards).
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef MELODYPLAYER_H
+#define MELODYPLAYER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "MelodyStream.h"
+
+class MelodyPlayer {
+public:
+    void begin(byte pin);
+
+    void play(const uint16_t* melody);
+    void stop();
+    boolean isPlaying();
+
+    // Nur fuer die Interrupt-Routine
+    void onTick();
+
+private:
+    MelodyStream _stream;
+    volatile uint8_t* _pinPort;
+    byte _pinMask;
+
+    volatile boolean _isPlaying;
+    boolean _toneOn;
+    uint16_t _frequency;
+    uint16_t _tickRate;
+    uint32_t _ticksLeft;
+
+    void _advance();
+    void _setTickRate(uint16_t rate);
+    void _pin(boolean on);
+};
+
+extern MelodyPlayer melodyPlayer;
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * MelodyStream
+ * Liest eine Melodie, die als Folge von 16-Bit-Ereignissen im PROGMEM liegt.
+ * Siehe MelodyStream.h.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - next() bricht fehlerhafte Wiederholungen ab (zurueck 0, vor den Anfang
+ *           oder ohne hoerbares Ereignis), statt im Interrupt haengenzubleiben.
+ */
+#include "MelodyStream.h"
+
+/**
+ * Eine Melodie von vorne beginnen.
+ */
+void MelodyStream::begin(const uint16_t* melody) {
+    _melody = melody;
+    _position = 0;
+    _depth = 0;
+    _silent = 0;
+}
+
+/**
+ * Das naechste hoerbare Ereignis bekommen. Wiederholungen werden
+ * hier aufgeloest. Laeuft im Interrupt, deshalb hoechstens
+ * MELODY_MAX_SILENT_EVENTS Durchlaeufe ohne hoerbares Ereignis.
+ *
+ * @param argument Dauer in ms (Ton, Pause) bzw. Frequenz in Hz.
+ * @return MELODY_EVENT_* (MELODY_EVENT_END auch bei einer fehlerhaften Melodie)
+ */
+byte MelodyStream::next(uint16_t* argument) {
+    while (_silent < MELODY_MAX_SILENT_EVENTS) {
+        uint16_t event = MELODY_READ(&_melody[_position]);
+        _silent++;
+        switch (event >> 14) {
+            case 0:
+                _position++;
+                *argument = event & 0x3FFF;
+                if (*argument) {
+                    _silent = 0;
+                }
+                return MELODY_EVENT_TONE;
+            case 1:
+                _position++;
+                *argument = event & 0x3FFF;
+                if (*argument) {
+                    _silent = 0;
+                }
+                return MELODY_EVENT_REST;
+            case 2: {
+                byte count = (event >> 6) & 0xFF;
+                byte back = event & 0x3F;
+                if ((back == 0) || (back > _position)) {
+                    // fehlerhafte Wiederholung
+                    _silent = MELODY_MAX_SILENT_EVENTS;
+                    return MELODY_EVENT_END;
+                }
+                if (count == 0) {
+                    // endlos
+                    _position -= back;
+                } else if ((_depth > 0) && (_repeatPosition[_depth - 1] == _position)) {
+                    // diese Wiederholung laeuft schon
+                    _repeatCount[_depth - 1]--;
+                    if (_repeatCount[_depth - 1] == 0) {
+                        _depth--;
+                        _position++;
+                    } else {
+                        _position -= back;
+                    }
+                } else if ((count > 1) && (_depth < MELODY_MAX_NESTING)) {
+                    _repeatPosition[_depth] = _position;
+                    _repeatCount[_depth] = count - 1;
+                    _depth++;
+                    _position -= back;
+                } else {
+                    _position++;
+                }
+                break;
+            }
+            default:
+                if (event == MELODY_END) {
+                    return MELODY_EVENT_END;
+                }
+                _position++;
+                *argument = event & 0x1FFF;
+                return MELODY_EVENT_FREQUENCY;
+        }
+    }
+    // Wiederholung ohne hoerbares Ereignis
+    return MELODY_EVENT_END;
+}
+
+/**
+ * Eine Melodie als Zeitablauf ausgeben, ohne sie zu spielen (tools/melodycheck.cpp
+ * prueft so die Weckmelodien). Endlose Melodien enden nach maxSteps Schritten,
+ * fehlerhafte ohne hoerbares Ereignis enden in next() (MELODY_MAX_SILENT_EVENTS).
+ *
+ * @param frequency Die Tonhoehe am Anfang.
+ * @return Anzahl der Schritte in trace.
+ */
+uint16_t MelodyStream::render(const uint16_t* melody, uint16_t frequency, MelodyTraceStep* trace, uint16_t maxSteps) {
+    MelodyStream stream;
+    uint32_t time = 0;
+    uint16_t steps = 0;
+    uint16_t argument;
+
+    stream.begin(melody);
+    while (steps < maxSteps) {
+        byte event = stream.next(&argument);
+        if (event == MELODY_EVENT_END) {
+            break;
+        }
+        if (event == MELODY_EVENT_FREQUENCY) {
+            frequency = argument;
+            continue;
+        }
+        trace[steps].start = time;
+        trace[steps].duration = argument;
+        trace[steps].frequency = (event == MELODY_EVENT_TONE) ? frequency : 0;
+        trace[steps].event = event;
+        time += argument;
+        steps++;
+    }
+    return steps;
+}
@@ -0,0 +1,85 @@
+/**
+ * MelodyStream
+ * Liest eine Melodie, die als Folge von 16-Bit-Ereignissen im PROGMEM liegt.
+ * Die oberen Bits sind der Befehl, der Rest das Argument:
+ *
+ *   MELODY_TONE(ms)             Ton fuer ms Millisekunden (1..16383)
+ *   MELODY_REST(ms)             Pause fuer ms Millisekunden (1..16383)
+ *   MELODY_REPEAT(count, back)  die letzten back Ereignisse (1..63) insgesamt
+ *                               count Mal spielen (1..255), 0 = endlos
+ *   MELODY_FREQUENCY(hz)        Tonhoehe der folgenden Toene (1..8191 Hz)
+ *   MELODY_END                  Ende
+ *
+ * Wiederholungen duerfen bis MELODY_MAX_NESTING tief verschachtelt sein.
+ * Kommt nach MELODY_MAX_SILENT_EVENTS Ereignissen kein hoerbares (Ton oder
+ * Pause mit Dauer), gilt die Melodie als fehlerhaft und endet, ebenso bei
+ * einer Wiederholung mit zurueck = 0 oder vor den Anfang.
+ * Die Klasse kennt keine Hardware. Sie laeuft im Interrupt des MelodyPlayer
+ * und genauso auf dem PC (render()), um eine Melodie als Zeitablauf zu pruefen.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - next() bricht fehlerhafte Wiederholungen ab (zurueck 0, vor den Anfang
+ *           oder ohne hoerbares Ereignis), statt im Interrupt haengenzubleiben.
+ */
+#ifndef MELODYSTREAM_H
+#define MELODYSTREAM_H
+
+#ifdef ARDUINO
+    #include "Arduino.h"
+    #include <avr/pgmspace.h>
+    #define MELODY_READ(p) pgm_read_word_near(p)
+#else
+    #include <stdint.h>
+    typedef uint8_t byte;
+    #define PROGMEM
+    #define MELODY_READ(p) (*(p))
+#endif
+
+#define MELODY_TONE(ms)             ((uint16_t) (0x0000 | (ms)))
+#define MELODY_REST(ms)             ((uint16_t) (0x4000 | (ms)))
+#define MELODY_REPEAT(count, back)  ((uint16_t) (0x8000 | ((count) << 6) | (back)))
+#define MELODY_FREQUENCY(hz)        ((uint16_t) (0xC000 | (hz)))
+#define MELODY_END                  ((uint16_t) 0xE000)
+
+#define MELODY_EVENT_TONE      0
+#define MELODY_EVENT_REST      1
+#define MELODY_EVENT_FREQUENCY 2
+#define MELODY_EVENT_END       3
+
+#define MELODY_MAX_NESTING 3
+#define MELODY_MAX_SILENT_EVENTS 32
+
+/*
+ * Ein Schritt im Zeitablauf von render().
+ */
+struct MelodyTraceStep {
+    uint32_t start;
+    uint16_t duration;
+    uint16_t frequency;
+    byte event;
+};
+
+class MelodyStream {
+public:
+    void begin(const uint16_t* melody);
+    byte next(uint16_t* argument);
+
+    static uint16_t render(const uint16_t* melody, uint16_t frequency, MelodyTraceStep* trace, uint16_t maxSteps);
+
+private:
+    const uint16_t* _melody;
+    uint16_t _position;
+    byte _depth;
+    byte _silent;
+    uint16_t _repeatPosition[MELODY_MAX_NESTING];
+    byte _repeatCount[MELODY_MAX_NESTING];
+};
+
+#endif
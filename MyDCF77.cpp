@@ -12,9 +12,9 @@
  * @mc       Arduino/RBBB
  * @autor    Andreas Mueller
  *           Vorlage von: Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.5
+ * @version  2.1
  * @created  21.3.2016
- * @updated  04.06.2016
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:   * Signalauswertealgoritmus komplett neu geschrieben! *
@@ -33,16 +33,23 @@
  *          - Größere Codeoptimierung
  *          - Änderung an den Funktionen getDcf77LastSuccessSyncMinutes() und setDcf77LastSuccessSyncMinutes()
  * V 1.5:   - Seltene Initialisierungsfehler behoben.
+ * V 1.6:   - Analoges Signal kommt aus dem AnalogSampler statt von analogRead().
+ * V 1.7:   - getDcf77SuccessSync() eingefuehrt (Sichern im RAM der Echtzeituhr).
+ * V 1.8:   - Debug-Ausgaben als Log-Eintraege (LogMessages.h), der Signalgraph als Bins und gepackte Bits.
+ *          - Die Bits werden in den EventTrace eingetragen.
+ * V 1.9:   - poll() sammelt nur noch die Zustaende, newCycle() ist oeffentlich und wird
+ *            vom TaskScheduler alle (1s / MYDCF77_SIGNAL_BINS) aufgerufen.
+ * V 2.0:   - getDecodeErrors() zaehlt die verworfenen Telegramme (fuer den TimeArbiter).
+ * V 2.1:   - Im EventTrace eine Zusammenfassung pro Minute, die Bits nur mit TRACE_DCF_BITS.
  */
 #include "MyDCF77.h"
+#include "EventTrace.h"
 
 //#define DEBUG
 #include "Debug.h"
 
-// Anzeige des Signalgraphen, nur wenn auch DEBUG gesetzt
+// Ausgabe des Signals (Bins und Bits) jede Sekunde, nur wenn auch DEBUG gesetzt
 #define DEBUG_SIGNAL
-// Höhe des Signalgraphen, wenn DEBUG_SIGNAL gesetzt (Default: 40)
-#define DEBUG_SIGNAL_VIS_HEIGHT 40
 
 byte MyDCF77::DCF77Factors[] = {1, 2, 4, 8, 10, 20, 40, 80};
 
@@ -53,6 +60,9 @@ MyDCF77::MyDCF77(byte signalPin, byte statusLedPin, byte dcf77PonPin) : TimeStam
     _signalPin = signalPin;
 #ifndef MYDCF77_SIGNAL_IS_ANALOG
     pinMode(_signalPin, INPUT);
+#else
+    // ungefiltert, es geht um die Flanken
+    analogSampler.addChannel(_signalPin, 0);
 #endif
 
     _statusLedPin = statusLedPin;
@@ -62,10 +72,10 @@ MyDCF77::MyDCF77(byte signalPin, byte statusLedPin, byte dcf77PonPin) : TimeStam
     _dcf77PonPin = dcf77PonPin;
 
     _nPolls = 0;
+    _decodeErrors = 0;
     _bitsPointer = 0;
     _binsPointer = 0;
     _binsOffset = 0;
-    _dcf77LastCycle = 0;
 }
 
 /**
@@ -82,14 +92,12 @@ void MyDCF77::statusLed(boolean on) {
 void MyDCF77::enable(boolean on) {
     if (on && !_enable) {
         _enable = on;
-        DEBUG_PRINTLN(F("DCF77-Empfaenger aufgeweckt."));
-        DEBUG_FLUSH();
+        LOG0(LOG_DCF_ENABLE);
         digitalWrite(_dcf77PonPin, LOW);
     }
     if (!on && _enable) {
         _enable = on;
-        DEBUG_PRINTLN(F("DCF77-Empfaenger schlafen gelegt."));
-        DEBUG_FLUSH();
+        LOG0(LOG_DCF_DISABLE);
         digitalWrite(_dcf77PonPin, HIGH);
     }
 }
@@ -101,9 +109,9 @@ boolean MyDCF77::signal(boolean signalIsInverted) {
     boolean val;
 #ifdef MYDCF77_SIGNAL_IS_ANALOG
     if (signalIsInverted) {
-        val = analogRead(_signalPin) < MYDCF77_ANALOG_SIGNAL_TRESHOLD;
+        val = analogSampler.getRaw(_signalPin) < MYDCF77_ANALOG_SIGNAL_TRESHOLD;
     } else {
-        val = analogRead(_signalPin) > MYDCF77_ANALOG_SIGNAL_TRESHOLD;
+        val = analogSampler.getRaw(_signalPin) > MYDCF77_ANALOG_SIGNAL_TRESHOLD;
     }
 #else
     if (signalIsInverted) {
@@ -118,9 +126,7 @@ boolean MyDCF77::signal(boolean signalIsInverted) {
 /**
  * Aufsammeln der Zustaende des DCF77-Signals.
  */
-boolean MyDCF77::poll(boolean signalIsInverted) {
-    boolean retVal = false;
-   
+void MyDCF77::poll(boolean signalIsInverted) {
     if (_binsPointer >= 0) {
         _nPolls++;            
         if (signal(signalIsInverted)) {
@@ -135,18 +141,11 @@ boolean MyDCF77::poll(boolean signalIsInverted) {
             _toggleSignal = false;   
         }     
     }
-
-    if (micros() - _dcf77LastCycle >= 1000000/MYDCF77_SIGNAL_BINS) {
-        _dcf77LastCycle += 1000000/MYDCF77_SIGNAL_BINS;
-        retVal = newCycle();
-    }
-       
-    return retVal;
 }
 
 /**
  * Der ( 1 / MYDCF77_SIGNAL_BINS )-ste Teil einer Sekunde startet.
- * Muss von einem externen Zeitgeber, z. B. einer RTC, aufgerufen werden.
+ * Muss von einem externen Zeitgeber (TaskScheduler) aufgerufen werden.
  *
  * Diese Funktion setzt updateFromDCF77 auf eine Zeitdauer, die abgewartet
  * wird, bevor die Funktion poll() (siehe oben) WAHR zurückgibt.
@@ -190,9 +189,12 @@ boolean MyDCF77::newCycle() {
         } else {
             _bits[_bitsPointer] = 0;
         }
+        #ifdef TRACE_DCF_BITS
+            TRACE(TRACE_DCF_BIT, _bitsPointer | (_bits[_bitsPointer] << 7));
+        #endif
 
-        #ifdef DEBUG_SIGNAL
-            outputSignal(average, imax, isum);
+        #if defined(DEBUG) && defined(DEBUG_SIGNAL)
+            outputSignal(average, isum);
         #endif
 
         _bitsPointer++;
@@ -201,7 +203,11 @@ boolean MyDCF77::newCycle() {
         }
 
         if (!isum) {
-            if (decode()) {
+            boolean ok = decode();
+            if (_enable) {
+                TRACE(TRACE_DCF_MINUTE, _bitsPointer | (ok << 7));
+            }
+            if (ok) {
               /*
                * Signal befindet sich zentriert im Sekundenintervall, 
                * daher 500ms mit dem Einstellen der Uhr warten.
@@ -229,9 +235,7 @@ boolean MyDCF77::newCycle() {
         _binsPointer = _binsOffset;
         
         if (_binsPointer) {
-            DEBUG_PRINT(F("Driftkorrektur erforderlich! Offset: "));
-            DEBUG_PRINTLN((int) _binsPointer);
-            DEBUG_FLUSH();
+            LOG1(LOG_DCF_DRIFT, _binsPointer);
         }            
         _binsOffset = 0;
     }
@@ -248,39 +252,21 @@ boolean MyDCF77::newCycle() {
     return retVal;
 }
 
-void MyDCF77::outputSignal(unsigned int average, unsigned int imax, unsigned int isum) {
-    unsigned long t1 = (unsigned long) imax * 1000 / DEBUG_SIGNAL_VIS_HEIGHT;
-    for (byte i = 0; i < MYDCF77_SIGNAL_BINS; i++ ) {
-        if (i < 10) {
-            DEBUG_PRINT(F("0"));
-        }
-        DEBUG_PRINT(i);
-        DEBUG_PRINT(F(" "));
-        byte signal_height = 0;
-        if (_bins[i])
-            signal_height = (unsigned long) _bins[i] * 1000 / t1;
-        for (byte j = 0; j < signal_height; j++) {
-            DEBUG_PRINT("-");
-        }
-        DEBUG_PRINTLN();
+void MyDCF77::outputSignal(unsigned int average, unsigned int isum) {
+    LOG_BYTES(LOG_DCF_BINS, _bins, sizeof(_bins));
+    LOG3(LOG_DCF_SIGNAL, _binsOffset, average, isum);
+    // Der Zeiger und die Bits, je acht in einem Byte
+    byte bits[2 + (MYDCF77_TELEGRAMMLAENGE + 7) / 8];
+    bits[0] = _bitsPointer;
+    for (byte i = 1; i < sizeof(bits); i++) {
+        bits[i] = 0;
     }
-    DEBUG_PRINT(F("Drift: "));
-    DEBUG_PRINT((int) _binsOffset);
-    DEBUG_PRINT(F(" Average: "));
-    DEBUG_PRINT(average);
-    DEBUG_PRINT(F(" Highcount: "));
-    DEBUG_PRINTLN(isum);
-    for (byte i = 0; i < MYDCF77_TELEGRAMMLAENGE; i++) {      
-        DEBUG_PRINT(F(" "));
-        DEBUG_PRINT(_bits[i]);
-        if (i == _bitsPointer) {
-          DEBUG_PRINT(".");
+    for (byte i = 0; i < MYDCF77_TELEGRAMMLAENGE; i++) {
+        if (_bits[i]) {
+            bits[2 + i / 8] |= 1 << (i % 8);
         }
     }
-    DEBUG_PRINT(" ");
-    DEBUG_PRINTLN(_bitsPointer);
-    DEBUG_PRINTLN();
-    DEBUG_FLUSH();
+    LOG_BYTES(LOG_DCF_BITS, bits, sizeof(bits));
 }
 
 #ifdef DCF77_SENSOR_EXISTS
@@ -298,8 +284,23 @@ void MyDCF77::outputSignal(unsigned int average, unsigned int imax, unsigned int
     void MyDCF77::setDcf77SuccessSync(TimeStamp* _rtc) {
         _dcf77LastSyncTime.set(_rtc);
     }
+
+    /*
+     * Zeitpunkt der letzten erfolgreichen DCF-Auswertung bekommen.
+     */
+    TimeStamp* MyDCF77::getDcf77SuccessSync() {
+        return &_dcf77LastSyncTime;
+    }
 #endif
 
+/**
+ * Wie viele Telegramme wegen falscher Pruef- oder Paritaetsbits bzw.
+ * ungueltiger Werte verworfen wurden.
+ */
+word MyDCF77::getDecodeErrors() {
+    return _decodeErrors;
+}
+
 /**
  * Die passende Eckled zum Debuggen bekommen.
  */
@@ -325,25 +326,21 @@ boolean MyDCF77::decode() {
     byte c = 0; // bitcount for checkbit
     boolean ok = true;
 
-    DEBUG_PRINTLN(F("Decoding telegram..."));
-    DEBUG_FLUSH();
+    LOG0(LOG_DCF_DECODE);
 
     if (_bits[0]) {
         ok = false;
-        DEBUG_PRINTLN(F("Check-bit M failed."));
-        DEBUG_FLUSH();
+        LOG0(LOG_DCF_CHECK_M);
     }
 
     if (!_bits[20]) {
         ok = false;
-        DEBUG_PRINTLN(F("Check-bit S failed."));
-        DEBUG_FLUSH();
+        LOG0(LOG_DCF_CHECK_S);
     }
     
     if (_bits[17] == _bits[18]) {
         ok = false;
-        DEBUG_PRINTLN(F("Check Z1 != Z2 failed."));
-        DEBUG_FLUSH();
+        LOG0(LOG_DCF_CHECK_Z);
     }
 
     //
@@ -351,13 +348,9 @@ boolean MyDCF77::decode() {
     //
     c = 0;
     _minutes = decodeHelper(&c, 21, 27);
-    DEBUG_PRINT(F("Minutes: "));
-    DEBUG_PRINTLN(_minutes);
-    DEBUG_FLUSH();
     if ((c + _bits[28]) % 2) {
         ok = false;
-        DEBUG_PRINTLN(F("Check-bit P1: minutes failed."));
-        DEBUG_FLUSH();
+        LOG0(LOG_DCF_CHECK_P1);
     }
 
     //
@@ -365,13 +358,9 @@ boolean MyDCF77::decode() {
     //
     c = 0;
     _hours = decodeHelper(&c, 29, 34);
-    DEBUG_PRINT(F("Hours: "));
-    DEBUG_PRINTLN(_hours);
-    DEBUG_FLUSH();
     if ((c + _bits[35]) % 2) {
         ok = false;
-        DEBUG_PRINTLN(F("Check-bit P2: hours failed."));
-        DEBUG_FLUSH();
+        LOG0(LOG_DCF_CHECK_P2);
     }
 
     //
@@ -379,57 +368,52 @@ boolean MyDCF77::decode() {
     //
     c = 0;
     _date = decodeHelper(&c, 36, 41);
-    DEBUG_PRINT(F("Date: "));
-    DEBUG_PRINTLN(_date);
-    DEBUG_FLUSH();
 
     //
     // day of week
     //
     _dayOfWeek = decodeHelper(&c, 42, 44);
-    DEBUG_PRINT(F("Day of week: "));
-    DEBUG_PRINTLN(_dayOfWeek);
-    DEBUG_FLUSH();
 
     //
     // month
     //
     _month = decodeHelper(&c, 45, 49);
-    DEBUG_PRINT(F("Month: "));
-    DEBUG_PRINTLN(_month);
-    DEBUG_FLUSH();
 
     //
     // year
     //
     _year = decodeHelper(&c, 50, 57);
-    DEBUG_PRINT(F("Year: "));
-    DEBUG_PRINTLN(_year);
-    DEBUG_FLUSH();
+    #ifdef DEBUG
+        int telegram[] = {_minutes, _hours, _date, _dayOfWeek, _month, _year};
+        LOG_BYTES(LOG_DCF_TELEGRAM, telegram, sizeof(telegram));
+    #endif
     if ((c + _bits[58]) % 2) {
         ok = false;
-        DEBUG_PRINTLN(F("Check-bit P3: date failed."));
-        DEBUG_FLUSH();
+        LOG0(LOG_DCF_CHECK_P3);
     }
 
     if (_minutes > 59) {
-        DEBUG_PRINTLN(F("Minutes out of range."));
+        LOG0(LOG_DCF_RANGE_MINUTES);
         ok = false;
     }
     if (_hours > 23) {
-        DEBUG_PRINTLN(F("Hours out of range."));
+        LOG0(LOG_DCF_RANGE_HOURS);
         ok = false;
     }
     if (_date > 31) {
-        DEBUG_PRINTLN(F("Date out of range."));
+        LOG0(LOG_DCF_RANGE_DATE);
         ok = false;
     }
     if (_month > 12) {
-        DEBUG_PRINTLN(F("Month out of range."));
+        LOG0(LOG_DCF_RANGE_MONTH);
         ok = false;
     }
 
     if (!ok) {
+        // Bei ausgeschaltetem Empfaenger ist nur Rauschen zu erwarten.
+        if (_enable) {
+            _decodeErrors++;
+        }
         // discard date...
         _minutes = 0;
         _hours = 0;
@@ -12,9 +12,9 @@
  * @mc       Arduino/RBBB
  * @autor    Andreas Mueller
  *           Vorlage von: Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.5
+ * @version  2.0
  * @created  21.3.2016
- * @updated  04.06.2016
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:   * Signalauswertealgoritmus komplett neu geschrieben! *
@@ -33,6 +33,12 @@
  *          - Größere Codeoptimierung
  *          - Änderung an den Funktionen getDcf77LastSuccessSyncMinutes() und setDcf77LastSuccessSyncMinutes()
  * V 1.5:   - Seltene Initialisierungsfehler behoben.
+ * V 1.6:   - Analoges Signal kommt aus dem AnalogSampler statt von analogRead().
+ * V 1.7:   - getDcf77SuccessSync() eingefuehrt (Sichern im RAM der Echtzeituhr).
+ * V 1.8:   - Debug-Ausgaben als Log-Eintraege (LogMessages.h), der Signalgraph als Bins und gepackte Bits.
+ * V 1.9:   - poll() sammelt nur noch die Zustaende, newCycle() ist oeffentlich und wird
+ *            vom TaskScheduler alle (1s / MYDCF77_SIGNAL_BINS) aufgerufen.
+ * V 2.0:   - getDecodeErrors() zaehlt die verworfenen Telegramme (fuer den TimeArbiter).
  */
 #ifndef MYDCF77_H
 #define MYDCF77_H
@@ -40,6 +46,9 @@
 #include "Arduino.h"
 #include "Configuration.h"
 #include "TimeStamp.h"
+#ifdef MYDCF77_SIGNAL_IS_ANALOG
+    #include "AnalogSampler.h"
+#endif
 
 class MyDCF77 : public TimeStamp {
 
@@ -49,12 +58,15 @@ public:
     void statusLed(boolean on);
     void enable(boolean on);
 
-    boolean poll(boolean signalIsInverted);
+    void poll(boolean signalIsInverted);
+    boolean newCycle();
 
     unsigned long getDcf77LastSuccessSyncMinutes();
     void setDcf77SuccessSync(TimeStamp* _rtc);
+    TimeStamp* getDcf77SuccessSync();
 
     byte getDcf77ErrorCorner();
+    word getDecodeErrors();
 
     boolean signal(boolean signalIsInverted);
 
@@ -74,17 +86,16 @@ private:
     char _binsPointer;
     char _binsOffset;
 
-    unsigned long _dcf77LastCycle;
     // _toggleSignal wird nur für EXT_MODE_DCF_DEBUG benötigt
     boolean _toggleSignal;
     byte _errorCorner;
+    word _decodeErrors;
 
 #ifdef DCF77_SENSOR_EXISTS
     TimeStamp _dcf77LastSyncTime;
 #endif
 
-    boolean newCycle();
-    void outputSignal(unsigned int average, unsigned int imax, unsigned int isum);
+    void outputSignal(unsigned int average, unsigned int isum);
 
     byte decodeHelper(byte *checksum, byte startV, byte endV);
     boolean decode();
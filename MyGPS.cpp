@@ -0,0 +1,380 @@
+/**
+ * MyGPS
+ * Zeit und Datum von einem GPS-Empfaenger (NMEA 0183 ueber Serial) als
+ * Alternative zum DCF77-Empfaenger, z. B. dort, wo DCF77 nicht zu empfangen ist.
+ * Ausgewertet werden $..RMC (nur mit Status 'A' = gueltig) und $..ZDA, andere
+ * Saetze werden ueberlesen. ZDA allein gilt nur mit GPS_RMC_TIMEOUT und nur,
+ * solange seit dem Start kein RMC kam. Die Zeichen werden ohne Zeilenpuffer direkt beim
+ * Lesen zerlegt (Zustandsautomat), die Pruefsumme muss stimmen.
+ * poll() holt pro Durchlauf von loop() nur die schon angekommenen Zeichen
+ * (hoechstens GPS_CHARS_PER_POLL) ab und liefert einmal pro Minute TRUE, dann
+ * steht die Ortszeit (GPS_UTC_OFFSET und ggf. Sommerzeit) im TimeStamp.
+ * Mit enablePps() wird die Zeit erst mit dem naechsten Sekundenimpuls (PPS)
+ * uebernommen, der genauer ist als das Eintreffen des Satzes.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.3
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - PPS nur, wenn der Pin-Change-Interrupt angemeldet werden konnte.
+ * V 1.2:  - Empfaenger, die nur ZDA schicken (GPS_RMC_TIMEOUT).
+ * V 1.3:  - ZDA allein nur noch mit GPS_RMC_TIMEOUT (nicht mehr Default) und nur,
+ *           solange seit dem Start kein RMC kam.
+ */
+#include "MyGPS.h"
+#include "PinChangeInterrupt.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+// Zustaende des Parsers
+#define GPS_STATE_IDLE        0
+#define GPS_STATE_SENTENCE    1
+#define GPS_STATE_CHECKSUM_HI 2
+#define GPS_STATE_CHECKSUM_LO 3
+
+// Die ausgewerteten Saetze
+#define GPS_TYPE_NONE 0
+#define GPS_TYPE_RMC  1
+#define GPS_TYPE_ZDA  2
+
+// Die Werte eines Satzes (_values)
+#define GPS_HOURS   0
+#define GPS_MINUTES 1
+#define GPS_SECONDS 2
+#define GPS_DATE    3
+#define GPS_MONTH   4
+#define GPS_YEAR    5
+#define GPS_NONE    0xFF
+#define GPS_SEEN_ALL 0x3F
+
+static MyGPS* _myGpsInstance;
+
+static void _myGpsPinChange() {
+    _myGpsInstance->onPps();
+}
+
+/**
+ * Initialisierung.
+ */
+MyGPS::MyGPS() {
+    _state = GPS_STATE_IDLE;
+    _type = GPS_TYPE_NONE;
+    _fix = false;
+#ifdef GPS_RMC_TIMEOUT
+    _rmcSeen = false;
+#endif
+    _hasPending = false;
+    _lastMinute = GPS_NONE;
+    _seconds = 0;
+    _checksumErrors = 0;
+    _ppsRegister = 0;
+    _ppsEdge = false;
+}
+
+/**
+ * Den Sekundenimpuls (PPS) des Empfaengers an einem Pin auswerten.
+ *
+ * @return FALSE, wenn der Pin keinen Pin-Change-Interrupt bekommt. Die Saetze
+ *         werden dann wie ohne PPS sofort uebernommen.
+ */
+boolean MyGPS::enablePps(byte ppsPin) {
+    pinMode(ppsPin, INPUT);
+    _ppsRegister = portInputRegister(digitalPinToPort(ppsPin));
+    _ppsMask = digitalPinToBitMask(ppsPin);
+    _ppsLevel = (*_ppsRegister & _ppsMask) != 0;
+    _myGpsInstance = this;
+    if (!attachPinChangeInterrupt(ppsPin, _myGpsPinChange)) {
+        _ppsRegister = 0;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Die angekommenen Zeichen abholen.
+ *
+ * @return TRUE, wenn eine neue Minute empfangen wurde.
+ */
+boolean MyGPS::poll() {
+    boolean result = false;
+    // Zuerst der Impuls, damit er nicht einem erst jetzt gelesenen Satz zugeordnet wird.
+    if (_ppsEdge) {
+        _ppsEdge = false;
+        if (_hasPending && (millis() - _pendingMillis < 1000)) {
+            result = _deliver(_pending, 1);
+        }
+        _hasPending = false;
+    }
+    for (byte i = 0; (i < GPS_CHARS_PER_POLL) && Serial.available(); i++) {
+        if (_parse(Serial.read()) && _endSentence()) {
+            result = true;
+        }
+    }
+    return result;
+}
+
+/**
+ * Ein Zeichen zerlegen.
+ *
+ * @return TRUE, wenn ein Satz mit richtiger Pruefsumme komplett ist.
+ */
+boolean MyGPS::_parse(char c) {
+    if (c == '$') {
+        _state = GPS_STATE_SENTENCE;
+        _checksum = 0;
+        _type = GPS_TYPE_NONE;
+        _field = 0;
+        _pos = 0;
+        _seen = 0;
+        _status = false;
+        return false;
+    }
+    if (_state == GPS_STATE_SENTENCE) {
+        if (c == '*') {
+            _state = GPS_STATE_CHECKSUM_HI;
+            return false;
+        }
+        if (c < ' ') {
+            // Zeilenende ohne Pruefsumme
+            _type = GPS_TYPE_NONE;
+            _state = GPS_STATE_IDLE;
+            return false;
+        }
+        _checksum ^= c;
+        if (c == ',') {
+            if (_field == 0) {
+                if ((_pos == 5) && !memcmp(_tag, "RMC", 3)) {
+                    _type = GPS_TYPE_RMC;
+                } else if ((_pos == 5) && !memcmp(_tag, "ZDA", 3)) {
+                    _type = GPS_TYPE_ZDA;
+                }
+            }
+            _field++;
+            _pos = 0;
+            return false;
+        }
+        if (_field == 0) {
+            // Die ersten beiden Zeichen sind der Sender (GP, GN, GL...)
+            if ((_pos >= 2) && (_pos < 5)) {
+                _tag[_pos - 2] = c;
+            }
+        } else if ((_type == GPS_TYPE_RMC) && (_field == 2)) {
+            _status = (c == 'A');
+        } else {
+            byte target = _target();
+            if (target != GPS_NONE) {
+                if ((c < '0') || (c > '9')) {
+                    _type = GPS_TYPE_NONE;
+                } else if (_pos & 1) {
+                    _values[target] += c - '0';
+                    _seen |= 1 << target;
+                } else {
+                    _values[target] = (c - '0') * 10;
+                }
+            }
+        }
+        if (_pos < 0xFF) {
+            _pos++;
+        }
+        return false;
+    }
+    if ((_state == GPS_STATE_CHECKSUM_HI) || (_state == GPS_STATE_CHECKSUM_LO)) {
+        byte digit;
+        if ((c >= '0') && (c <= '9')) {
+            digit = c - '0';
+        } else if ((c >= 'A') && (c <= 'F')) {
+            digit = c - 'A' + 10;
+        } else {
+            _type = GPS_TYPE_NONE;
+            _state = GPS_STATE_IDLE;
+            return false;
+        }
+        if (_state == GPS_STATE_CHECKSUM_HI) {
+            _receivedChecksum = digit << 4;
+            _state = GPS_STATE_CHECKSUM_LO;
+            return false;
+        }
+        _receivedChecksum |= digit;
+        _state = GPS_STATE_IDLE;
+        if (_receivedChecksum != _checksum) {
+            _checksumErrors++;
+            DEBUG_PRINTLN(F("GPS checksum error."));
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Welcher Wert steht an der aktuellen Stelle des Satzes?
+ *
+ * @return GPS_HOURS..GPS_YEAR oder GPS_NONE, wenn die Stelle nicht gebraucht wird.
+ */
+byte MyGPS::_target() {
+    byte start;
+    byte count;
+    byte skip = 0;
+    if ((_type == GPS_TYPE_RMC) && (_field == 1)) {
+        // hhmmss.ss
+        start = GPS_HOURS;
+        count = 3;
+    } else if ((_type == GPS_TYPE_RMC) && (_field == 9)) {
+        // ddmmyy
+        start = GPS_DATE;
+        count = 3;
+    } else if (_type == GPS_TYPE_ZDA) {
+        // hhmmss.ss,dd,mm,yyyy
+        switch (_field) {
+            case 1:
+                start = GPS_HOURS;
+                count = 3;
+                break;
+            case 2:
+                start = GPS_DATE;
+                count = 1;
+                break;
+            case 3:
+                start = GPS_MONTH;
+                count = 1;
+                break;
+            case 4:
+                start = GPS_YEAR;
+                count = 1;
+                skip = 2;
+                break;
+            default:
+                return GPS_NONE;
+        }
+    } else {
+        return GPS_NONE;
+    }
+    if ((_pos < skip) || (_pos - skip >= count * 2)) {
+        return GPS_NONE;
+    }
+    return start + (_pos - skip) / 2;
+}
+
+/**
+ * Ein Satz ist komplett und die Pruefsumme stimmt.
+ *
+ * @return TRUE, wenn eine neue Minute uebernommen wurde.
+ */
+boolean MyGPS::_endSentence() {
+    if (_type == GPS_TYPE_NONE) {
+        return false;
+    }
+    // ZDA hat keinen Status, ohne gueltigen RMC kommt die Zeit evtl. nur aus der Uhr des Empfaengers.
+    // Hat der Empfaenger seit dem Start kein RMC geschickt, gilt ZDA allein (nur mit GPS_RMC_TIMEOUT).
+    if (_type == GPS_TYPE_RMC) {
+        _fix = _status;
+#ifdef GPS_RMC_TIMEOUT
+        _rmcSeen = true;
+    } else if (!_rmcSeen && (millis() >= GPS_RMC_TIMEOUT)) {
+        _fix = true;
+#endif
+    }
+    if (!_fix || (_seen != GPS_SEEN_ALL)) {
+        return false;
+    }
+    if ((_values[GPS_HOURS] > 23) || (_values[GPS_MINUTES] > 59) || (_values[GPS_SECONDS] > 59)
+        || (_values[GPS_DATE] < 1) || (_values[GPS_DATE] > 31) || (_values[GPS_MONTH] < 1) || (_values[GPS_MONTH] > 12)) {
+        return false;
+    }
+    if (_ppsRegister) {
+        memcpy(_pending, _values, sizeof(_pending));
+        _pendingMillis = millis();
+        _hasPending = true;
+        return false;
+    }
+    return _deliver(_values, 0);
+}
+
+/**
+ * Die Zeit eines Satzes (UTC) als Ortszeit uebernehmen, aber nur einmal pro Minute.
+ *
+ * @param addSeconds: 1, wenn der Satz beim folgenden Sekundenimpuls uebernommen wird.
+ */
+boolean MyGPS::_deliver(byte* values, byte addSeconds) {
+    byte seconds = values[GPS_SECONDS] + addSeconds;
+    // In der 59. Sekunde nicht, damit die Minute nicht mitgezaehlt werden muss.
+    if ((seconds > 59) || (values[GPS_MINUTES] == _lastMinute)) {
+        return false;
+    }
+    _lastMinute = values[GPS_MINUTES];
+    _seconds = seconds;
+    set(values[GPS_MINUTES], values[GPS_HOURS], values[GPS_DATE], 0, values[GPS_MONTH], values[GPS_YEAR]);
+    char offset = GPS_UTC_OFFSET;
+#ifdef GPS_EU_DST
+    if (_isSummerTime(values)) {
+        offset++;
+    }
+#endif
+    addSubHoursOverflow(offset);
+    DEBUG_PRINT(F("GPS: "));
+    DEBUG_PRINTLN(asString());
+    return true;
+}
+
+/**
+ * Gilt die (europaeische) Sommerzeit? Umgestellt wird am letzten Sonntag im
+ * Maerz bzw. Oktober um 01:00 UTC. Gueltig von 2000 bis 2099.
+ */
+boolean MyGPS::_isSummerTime(byte* values) {
+    byte month = values[GPS_MONTH];
+    if ((month < 3) || (month > 10)) {
+        return false;
+    }
+    if ((month > 3) && (month < 10)) {
+        return true;
+    }
+    byte lastSunday = 31 - ((5 * values[GPS_YEAR] / 4 + ((month == 3) ? 5 : 2)) % 7);
+    if (values[GPS_DATE] != lastSunday) {
+        return (month == 3) == (values[GPS_DATE] > lastSunday);
+    }
+    return (month == 3) == (values[GPS_HOURS] >= 1);
+}
+
+/**
+ * Die Sekunden der zuletzt uebernommenen Zeit.
+ */
+byte MyGPS::getSeconds() {
+    return _seconds;
+}
+
+/**
+ * Wie viele Saetze wegen falscher Pruefsumme verworfen wurden.
+ */
+word MyGPS::getChecksumErrors() {
+    return _checksumErrors;
+}
+
+/**
+ * Zeitpunkt der letzten erfolgreichen Synchronisation (Minuten des Jahrhunderts).
+ */
+unsigned long MyGPS::getGpsLastSuccessSyncMinutes() {
+    return _gpsLastSyncTime.getMinutesOfCentury();
+}
+
+/**
+ * Zeitpunkt der letzten erfolgreichen Synchronisation setzen.
+ */
+void MyGPS::setGpsSuccessSync(TimeStamp* rtc) {
+    _gpsLastSyncTime.set(rtc);
+}
+
+/**
+ * Der Pin-Change-Interrupt des PPS-Pins: die steigende Flanke merken.
+ */
+void MyGPS::onPps() {
+    boolean level = (*_ppsRegister & _ppsMask) != 0;
+    if (level && !_ppsLevel) {
+        _ppsEdge = true;
+    }
+    _ppsLevel = level;
+}
@@ -0,0 +1,98 @@
+/**
+ * MyGPS
+ * Zeit und Datum von einem GPS-Empfaenger (NMEA 0183 ueber Serial) als
+ * Alternative zum DCF77-Empfaenger, z. B. dort, wo DCF77 nicht zu empfangen ist.
+ * Ausgewertet werden $..RMC (nur mit Status 'A' = gueltig) und $..ZDA, andere
+ * Saetze werden ueberlesen. ZDA allein gilt nur mit GPS_RMC_TIMEOUT und nur,
+ * solange seit dem Start kein RMC kam. Die Zeichen werden ohne Zeilenpuffer direkt beim
+ * Lesen zerlegt (Zustandsautomat), die Pruefsumme muss stimmen.
+ * poll() holt pro Durchlauf von loop() nur die schon angekommenen Zeichen
+ * (hoechstens GPS_CHARS_PER_POLL) ab und liefert einmal pro Minute TRUE, dann
+ * steht die Ortszeit (GPS_UTC_OFFSET und ggf. Sommerzeit) im TimeStamp.
+ * Mit enablePps() wird die Zeit erst mit dem naechsten Sekundenimpuls (PPS)
+ * uebernommen, der genauer ist als das Eintreffen des Satzes.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.3
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - PPS nur, wenn der Pin-Change-Interrupt angemeldet werden konnte.
+ * V 1.2:  - Empfaenger, die nur ZDA schicken (GPS_RMC_TIMEOUT).
+ * V 1.3:  - ZDA allein nur noch mit GPS_RMC_TIMEOUT (nicht mehr Default) und nur,
+ *           solange seit dem Start kein RMC kam.
+ */
+#ifndef MYGPS_H
+#define MYGPS_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "TimeStamp.h"
+
+#define GPS_CHARS_PER_POLL 16
+
+#ifndef GPS_UTC_OFFSET
+    #define GPS_UTC_OFFSET 1
+#endif
+
+class MyGPS : public TimeStamp {
+public:
+    MyGPS();
+
+    boolean enablePps(byte ppsPin);
+
+    boolean poll();
+
+    byte getSeconds();
+    word getChecksumErrors();
+
+    unsigned long getGpsLastSuccessSyncMinutes();
+    void setGpsSuccessSync(TimeStamp* rtc);
+
+    void onPps();
+
+private:
+    // Zustand des Parsers
+    byte _state;
+    byte _checksum;
+    byte _receivedChecksum;
+    byte _type;
+    byte _field;
+    byte _pos;
+    char _tag[3];
+
+    // Die Werte des Satzes (UTC), _seen merkt sich die gelesenen
+    byte _values[6];
+    byte _seen;
+    boolean _status;
+    boolean _fix;
+#ifdef GPS_RMC_TIMEOUT
+    boolean _rmcSeen;
+#endif
+
+    // Der letzte gueltige Satz wartet auf den Sekundenimpuls
+    byte _pending[6];
+    boolean _hasPending;
+    unsigned long _pendingMillis;
+    byte _lastMinute;
+    byte _seconds;
+    word _checksumErrors;
+
+    volatile uint8_t* _ppsRegister;
+    byte _ppsMask;
+    boolean _ppsLevel;
+    volatile boolean _ppsEdge;
+
+    TimeStamp _gpsLastSyncTime;
+
+    boolean _parse(char c);
+    byte _target();
+    boolean _endSentence();
+    boolean _deliver(byte* values, byte addSeconds);
+    boolean _isSummerTime(byte* values);
+};
+
+#endif
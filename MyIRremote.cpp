@@ -15,6 +15,7 @@
  *
  * JVC and Panasonic protocol added by Kristian Lauszus (Thanks to zenwheel and other people at the original blog post)
  * LG added by Darryl Smith (based on the JVC protocol)
+ * Edge capture receiver (pin change interrupt instead of 50us timer polling) added for the Qlockthree
  */
 
 #include "MyIRremote.h"
@@ -22,6 +23,11 @@
 
 // Provides ISR
 #include <avr/interrupt.h>
+#ifdef IR_RECV_EDGE_CAPTURE
+#include "PinChangeInterrupt.h"
+#include "EventTrace.h"
+static void irEdgeInterrupt();
+#endif
 
 volatile irparams_t irparams;
 
@@ -73,6 +79,7 @@ int MATCH_SPACE(int measured_ticks, int desired_us) {return MATCH(measured_ticks
 // Debugging versions are in IRremote.cpp
 #endif
 
+#ifdef IR_SEND_ENABLE
 void IRsend::sendNEC(unsigned long data, int nbits)
 {
   enableIROut(38);
@@ -289,6 +296,7 @@ void IRsend::enableIROut(int khz) {
   // The top value for the timer.  The modulation frequency will be SYSCLOCK / 2 / OCR2A.
   TIMER_CONFIG_KHZ(khz);
 }
+#endif
 
 IRrecv::IRrecv(int recvpin)
 {
@@ -297,7 +305,25 @@ IRrecv::IRrecv(int recvpin)
 }
 
 // initialization
-void IRrecv::enableIRIn() {
+#ifdef IR_RECV_EDGE_CAPTURE
+int IRrecv::enableIRIn() {
+  // set pin modes
+  pinMode(irparams.recvpin, INPUT);
+
+  cli();
+  // initialize state machine variables
+  irparams.rcvstate = STATE_IDLE;
+  irparams.rawlen = 0;
+  irparams.lastlevel = (uint8_t)digitalRead(irparams.recvpin);
+  irparams.lastedge = micros();
+
+  sei();  // enable interrupts
+
+  // pin change interrupt on the receiver pin
+  return attachPinChangeInterrupt(irparams.recvpin, irEdgeInterrupt);
+}
+#else
+int IRrecv::enableIRIn() {
   cli();
   // setup pulse clock timer interrupt
   //Prescale /8 (16M/8 = 0.5 microseconds per tick)
@@ -318,7 +344,9 @@ void IRrecv::enableIRIn() {
 
   // set pin modes
   pinMode(irparams.recvpin, INPUT);
+  return 1;
 }
+#endif
 
 // enable/disable blinking of pin 13 on IR processing
 void IRrecv::blink13(int blinkflag)
@@ -328,6 +356,97 @@ void IRrecv::blink13(int blinkflag)
     pinMode(BLINKLED, OUTPUT);
 }
 
+#ifdef IR_RECV_EDGE_CAPTURE
+// Pin change interrupt code to collect raw data (called from the PCINT ISR).
+// Runs only on edges of the port of the receiver pin (roughly 68 times for a NEC frame),
+// instead of 20000 times a second like the timer version below.
+// Widths of alternating SPACE, MARK are recorded in rawbuf, but in
+// microseconds (max. 65535). decode() converts them to 50us ticks once the
+// frame is complete, so the division is not done in the ISR.
+// As in the timer version the first entry is the SPACE before the frame.
+// A SPACE longer than _GAP ends the frame. It is detected here if the next
+// frame starts, otherwise by frameComplete() called from decode().
+static void irEdgeInterrupt()
+{
+  uint8_t irdata = (uint8_t)digitalRead(irparams.recvpin);
+  if (irdata == irparams.lastlevel) {
+    // another pin of the port has changed
+    return;
+  }
+  irparams.lastlevel = irdata;
+
+  unsigned long now = micros();
+  unsigned long width = now - irparams.lastedge;
+  irparams.lastedge = now;
+  if (width > 0xFFFF) {
+    width = 0xFFFF;
+  }
+
+  if (irparams.rawlen >= RAWBUF) {
+    // Buffer overflow
+    irparams.rcvstate = STATE_STOP_US;
+  }
+  switch(irparams.rcvstate) {
+  case STATE_IDLE: // In the middle of a gap
+    if ((irdata == MARK) && (width >= _GAP)) {
+      // gap just ended, record duration and start recording transmission
+      irparams.rawlen = 0;
+      irparams.rawbuf[irparams.rawlen++] = (unsigned int)width;
+      irparams.rcvstate = STATE_MARK;
+      TRACE(TRACE_IR, 0);
+    }
+    break;
+  case STATE_MARK: // MARK ended, record it
+    irparams.rawbuf[irparams.rawlen++] = (unsigned int)width;
+    irparams.rcvstate = STATE_SPACE;
+    break;
+  case STATE_SPACE: // SPACE ended
+    if (width > _GAP) {
+      // big SPACE, the frame was complete before this edge
+      irparams.rcvstate = STATE_STOP_US;
+      TRACE(TRACE_IR, irparams.rawlen);
+    } 
+    else {
+      irparams.rawbuf[irparams.rawlen++] = (unsigned int)width;
+      irparams.rcvstate = STATE_MARK;
+    }
+    break;
+  default: // STATE_STOP(_US): waiting for decode()/resume()
+    break;
+  }
+
+  if (irparams.blinkflag) {
+    if (irdata == MARK) {
+      BLINKLED_ON();  // turn pin 13 LED on
+    } 
+    else {
+      BLINKLED_OFF();  // turn pin 13 LED off
+    }
+  }
+}
+
+// Checks for the trailing gap of a frame, which produces no edge,
+// and converts rawbuf from microseconds to 50us ticks.
+// Returns true, if a complete frame is in rawbuf.
+static boolean frameComplete() {
+  uint8_t oldSREG = SREG;
+  cli();
+  if ((irparams.rcvstate == STATE_SPACE) && (micros() - irparams.lastedge > _GAP)) {
+    irparams.rcvstate = STATE_STOP_US;
+    TRACE(TRACE_IR, irparams.rawlen);
+  }
+  SREG = oldSREG;
+
+  if (irparams.rcvstate == STATE_STOP_US) {
+    // the ISR does not touch rawbuf in this state
+    for (uint8_t i = 0; i < irparams.rawlen; i++) {
+      irparams.rawbuf[i] = (irparams.rawbuf[i] + USECPERTICK / 2) / USECPERTICK;
+    }
+    irparams.rcvstate = STATE_STOP;
+  }
+  return irparams.rcvstate == STATE_STOP;
+}
+#else
 // TIMER2 interrupt code to collect raw data.
 // Widths of alternating SPACE, MARK are recorded in rawbuf.
 // Recorded in ticks of 50 microseconds.
@@ -401,6 +520,7 @@ ISR(TIMER_INTR_NAME)
     }
   }
 }
+#endif
 
 void IRrecv::resume() {
   irparams.rcvstate = STATE_IDLE;
@@ -414,84 +534,94 @@ void IRrecv::resume() {
 // Results of decoding are stored in results
 int IRrecv::decode(decode_results *results) {
   results->rawbuf = irparams.rawbuf;
+#ifdef IR_RECV_EDGE_CAPTURE
+  if (!frameComplete()) {
+    return ERR;
+  }
+  results->rawlen = irparams.rawlen;
+#else
   results->rawlen = irparams.rawlen;
   if (irparams.rcvstate != STATE_STOP) {
     return ERR;
   }
+#endif
+  // Single pass: the header mark is read once and only the protocols
+  // selected at compile time (see Configuration.h) whose header matches
+  // are decoded. Each decoder leaves on the first mismatching interval.
+  int hdr = results->rawbuf[1];
 #ifdef DEBUG
-  Serial.println("Attempting NEC decode");
+  Serial.print("Header mark ticks: ");
+  Serial.println(hdr, DEC);
 #endif
-  if (decodeNEC(results)) {
+  (void)hdr;
+#ifdef IR_DECODE_NEC
+  if (MATCH_MARK(hdr, NEC_HDR_MARK) && decodeNEC(results)) {
     return DECODED;
   }
-/*
-#ifdef DEBUG
-  Serial.println("Attempting Sony decode");
 #endif
-  if (decodeSony(results)) {
+#ifdef IR_DECODE_SONY
+  if (MATCH_MARK(hdr, SONY_HDR_MARK) && decodeSony(results)) {
     return DECODED;
   }
-#ifdef DEBUG
-  Serial.println("Attempting Sanyo decode");
 #endif
-  if (decodeSanyo(results)) {
+#ifdef IR_DECODE_SANYO
+  if (MATCH_MARK(hdr, SANYO_HDR_MARK) && decodeSanyo(results)) {
     return DECODED;
   }
-#ifdef DEBUG
-  Serial.println("Attempting Mitsubishi decode");
 #endif
+#ifdef IR_DECODE_MITSUBISHI
+  // no header mark
   if (decodeMitsubishi(results)) {
     return DECODED;
   }
-#ifdef DEBUG
-  Serial.println("Attempting RC5 decode");
-#endif  
+#endif
+#ifdef IR_DECODE_RC5
+  // no header mark
   if (decodeRC5(results)) {
     return DECODED;
   }
-#ifdef DEBUG
-  Serial.println("Attempting RC6 decode");
-#endif 
-  if (decodeRC6(results)) {
+#endif
+#ifdef IR_DECODE_RC6
+  if (MATCH_MARK(hdr, RC6_HDR_MARK) && decodeRC6(results)) {
     return DECODED;
   }
-#ifdef DEBUG
-    Serial.println("Attempting Panasonic decode");
-#endif 
-    if (decodePanasonic(results)) {
-        return DECODED;
-    }
-#ifdef DEBUG
-    Serial.println("Attempting LG decode");
-#endif 
-    if (decodeLG(results)) {
-        return DECODED;
-    }
-#ifdef DEBUG
-    Serial.println("Attempting JVC decode");
-#endif 
-    if (decodeJVC(results)) {
-        return DECODED;
-    }
-#ifdef DEBUG
-  Serial.println("Attempting SAMSUNG decode");
 #endif
-  if (decodeSAMSUNG(results)) {
+#ifdef IR_DECODE_PANASONIC
+  if (MATCH_MARK(hdr, PANASONIC_HDR_MARK) && decodePanasonic(results)) {
     return DECODED;
   }
+#endif
+#ifdef IR_DECODE_LG
+  if (MATCH_MARK(hdr, LG_HDR_MARK) && decodeLG(results)) {
+    return DECODED;
+  }
+#endif
+#ifdef IR_DECODE_JVC
+  // JVC repeats are sent without header
+  if (decodeJVC(results)) {
+    return DECODED;
+  }
+#endif
+#ifdef IR_DECODE_SAMSUNG
+  if (MATCH_MARK(hdr, SAMSUNG_HDR_MARK) && decodeSAMSUNG(results)) {
+    return DECODED;
+  }
+#endif
+#ifdef IR_DECODE_HASH
   // decodeHash returns a hash on any input.
   // Thus, it needs to be last in the list.
   // If you add any decodes, add them before this.
   if (decodeHash(results)) {
     return DECODED;
   }
-*/
+#endif
   // Throw away and start over
   resume();
   return ERR;
 }
 
 // NECs have a repeat only 4 items long
+#if defined(IR_DECODE_NEC)
 long IRrecv::decodeNEC(decode_results *results) {
   long data = 0;
   int offset = 1; // Skip first space
@@ -539,7 +669,9 @@ long IRrecv::decodeNEC(decode_results *results) {
   results->decode_type = NEC;
   return DECODED;
 }
+#endif
 
+#if defined(IR_DECODE_SONY)
 long IRrecv::decodeSony(decode_results *results) {
   long data = 0;
   if (irparams.rawlen < 2 * SONY_BITS + 2) {
@@ -591,9 +723,11 @@ long IRrecv::decodeSony(decode_results *results) {
   results->decode_type = SONY;
   return DECODED;
 }
+#endif
 
 // I think this is a Sanyo decoder - serial = SA 8650B
 // Looks like Sony except for timings, 48 chars of data and time/space different
+#if defined(IR_DECODE_SANYO)
 long IRrecv::decodeSanyo(decode_results *results) {
   long data = 0;
   if (irparams.rawlen < 2 * SANYO_BITS + 2) {
@@ -655,8 +789,10 @@ long IRrecv::decodeSanyo(decode_results *results) {
   results->decode_type = SANYO;
   return DECODED;
 }
+#endif
 
 // Looks like Sony except for timings, 48 chars of data and time/space different
+#if defined(IR_DECODE_MITSUBISHI)
 long IRrecv::decodeMitsubishi(decode_results *results) {
   // Serial.print("?!? decoding Mitsubishi:");Serial.print(irparams.rawlen); Serial.print(" want "); Serial.println( 2 * MITSUBISHI_BITS + 2);
   long data = 0;
@@ -719,6 +855,7 @@ long IRrecv::decodeMitsubishi(decode_results *results) {
   results->decode_type = MITSUBISHI;
   return DECODED;
 }
+#endif
 
 
 // Gets one undecoded level at a time from the raw buffer.
@@ -728,6 +865,7 @@ long IRrecv::decodeMitsubishi(decode_results *results) {
 // offset and used are updated to keep track of the current position.
 // t1 is the time interval for a single bit in microseconds.
 // Returns -1 for error (measured time interval is not a multiple of t1).
+#if defined(IR_DECODE_RC5) || defined(IR_DECODE_RC6)
 int IRrecv::getRClevel(decode_results *results, int *offset, int *used, int t1) {
   if (*offset >= results->rawlen) {
     // After end of recorded buffer, assume SPACE.
@@ -766,7 +904,9 @@ int IRrecv::getRClevel(decode_results *results, int *offset, int *used, int t1)
 #endif
   return val;   
 }
+#endif
 
+#if defined(IR_DECODE_RC5)
 long IRrecv::decodeRC5(decode_results *results) {
   if (irparams.rawlen < MIN_RC5_SAMPLES + 2) {
     return ERR;
@@ -801,7 +941,9 @@ long IRrecv::decodeRC5(decode_results *results) {
   results->decode_type = RC5;
   return DECODED;
 }
+#endif
 
+#if defined(IR_DECODE_RC6)
 long IRrecv::decodeRC6(decode_results *results) {
   if (results->rawlen < MIN_RC6_SAMPLES) {
     return ERR;
@@ -852,6 +994,9 @@ long IRrecv::decodeRC6(decode_results *results) {
   results->decode_type = RC6;
   return DECODED;
 }
+#endif
+
+#if defined(IR_DECODE_PANASONIC)
 long IRrecv::decodePanasonic(decode_results *results) {
     unsigned long long data = 0;
     int offset = 1;
@@ -885,7 +1030,9 @@ long IRrecv::decodePanasonic(decode_results *results) {
     results->bits = PANASONIC_BITS;
     return DECODED;
 }
+#endif
 
+#if defined(IR_DECODE_LG)
 long IRrecv::decodeLG(decode_results *results) {
     long data = 0;
     int offset = 1; // Skip first space
@@ -929,8 +1076,10 @@ long IRrecv::decodeLG(decode_results *results) {
     results->decode_type = LG;
     return DECODED;
 }
+#endif
 
 
+#if defined(IR_DECODE_JVC)
 long IRrecv::decodeJVC(decode_results *results) {
     long data = 0;
     int offset = 1; // Skip first space
@@ -982,8 +1131,10 @@ long IRrecv::decodeJVC(decode_results *results) {
     results->decode_type = JVC;
     return DECODED;
 }
+#endif
 
 // SAMSUNGs have a repeat only 4 items long
+#if defined(IR_DECODE_SAMSUNG)
 long IRrecv::decodeSAMSUNG(decode_results *results) {
   long data = 0;
   int offset = 1; // Skip first space
@@ -1031,6 +1182,7 @@ long IRrecv::decodeSAMSUNG(decode_results *results) {
   results->decode_type = SAMSUNG;
   return DECODED;
 }
+#endif
 
 /* -----------------------------------------------------------------------
  * hashdecode - decode an arbitrary IR code.
@@ -1049,6 +1201,7 @@ long IRrecv::decodeSAMSUNG(decode_results *results) {
 // Compare two tick values, returning 0 if newval is shorter,
 // 1 if newval is equal, and 2 if newval is longer
 // Use a tolerance of 20%
+#if defined(IR_DECODE_HASH)
 int IRrecv::compare(unsigned int oldval, unsigned int newval) {
   if (newval < oldval * .8) {
     return 0;
@@ -1060,6 +1213,7 @@ int IRrecv::compare(unsigned int oldval, unsigned int newval) {
     return 1;
   }
 }
+#endif
 
 // Use FNV hash algorithm: http://isthe.com/chongo/tech/comp/fnv/#FNV-param
 #define FNV_PRIME_32 16777619
@@ -1069,6 +1223,7 @@ int IRrecv::compare(unsigned int oldval, unsigned int newval) {
  * Hopefully this code is unique for each button.
  * This isn't a "real" decoding, just an arbitrary value.
  */
+#if defined(IR_DECODE_HASH)
 long IRrecv::decodeHash(decode_results *results) {
   // Require at least 6 samples to prevent triggering on noise
   if (results->rawlen < 6) {
@@ -1085,7 +1240,9 @@ long IRrecv::decodeHash(decode_results *results) {
   results->decode_type = UNKNOWN;
   return DECODED;
 }
+#endif
 
+#ifdef IR_SEND_ENABLE
 /* Sharp and DISH support by Todd Treece ( http://unionbridge.org/design/ircommand )
 
 The Dish send function needs to be repeated 4 times, and the Sharp function
@@ -1154,3 +1311,4 @@ void IRsend::sendDISH(unsigned long data, int nbits) {
     data <<= 1;
   }
 }
+#endif
@@ -16,6 +16,17 @@
 #ifndef My_IRremote_h
 #define My_IRremote_h
 
+// The decoded protocols (IR_DECODE_*) and IR_SEND_ENABLE are selected
+// in Configuration.h, derived from the configured remote.
+#include "Configuration.h"
+
+#if !defined(IR_DECODE_NEC) && !defined(IR_DECODE_SONY) && !defined(IR_DECODE_SANYO) && \
+    !defined(IR_DECODE_MITSUBISHI) && !defined(IR_DECODE_RC5) && !defined(IR_DECODE_RC6) && \
+    !defined(IR_DECODE_PANASONIC) && !defined(IR_DECODE_LG) && !defined(IR_DECODE_JVC) && \
+    !defined(IR_DECODE_SAMSUNG) && !defined(IR_DECODE_HASH)
+#define IR_DECODE_NEC
+#endif
+
 // The following are compile-time library options.
 // If you change them, recompile the library.
 // If DEBUG is defined, a lot of debugging output will be printed during decoding.
@@ -63,23 +74,48 @@ public:
   IRrecv(int recvpin);
   void blink13(int blinkflag);
   int decode(decode_results *results);
-  void enableIRIn();
+  // returns 0 if the receiver pin gets no pin change interrupt (IR_RECV_EDGE_CAPTURE)
+  int enableIRIn();
   void resume();
 private:
   // These are called by decode
+#if defined(IR_DECODE_RC5) || defined(IR_DECODE_RC6)
   int getRClevel(decode_results *results, int *offset, int *used, int t1);
+#endif
+#ifdef IR_DECODE_NEC
   long decodeNEC(decode_results *results);
+#endif
+#ifdef IR_DECODE_SONY
   long decodeSony(decode_results *results);
+#endif
+#ifdef IR_DECODE_SANYO
   long decodeSanyo(decode_results *results);
+#endif
+#ifdef IR_DECODE_MITSUBISHI
   long decodeMitsubishi(decode_results *results);
+#endif
+#ifdef IR_DECODE_RC5
   long decodeRC5(decode_results *results);
+#endif
+#ifdef IR_DECODE_RC6
   long decodeRC6(decode_results *results);
+#endif
+#ifdef IR_DECODE_PANASONIC
   long decodePanasonic(decode_results *results);
+#endif
+#ifdef IR_DECODE_LG
   long decodeLG(decode_results *results);
+#endif
+#ifdef IR_DECODE_JVC
   long decodeJVC(decode_results *results);
+#endif
+#ifdef IR_DECODE_SAMSUNG
   long decodeSAMSUNG(decode_results *results);
+#endif
+#ifdef IR_DECODE_HASH
   long decodeHash(decode_results *results);
   int compare(unsigned int oldval, unsigned int newval);
+#endif
 
 } 
 ;
@@ -91,6 +127,7 @@ private:
 #define VIRTUAL
 #endif
 
+#ifdef IR_SEND_ENABLE
 class IRsend
 {
 public:
@@ -115,6 +152,7 @@ public:
   VIRTUAL void space(int usec);
 }
 ;
+#endif
 
 // Some useful constants
 
@@ -73,6 +73,17 @@
   #define IR_USE_TIMER2     // tx = pin 3
 #endif
 
+// Receive backend
+//
+// With IR_RECV_EDGE_CAPTURE the receiver does not poll the pin every 50us
+// with a timer interrupt. Instead a pin change interrupt timestamps every
+// edge with micros() and writes the interval into rawbuf. Nothing runs while
+// the remote is idle. The end of a frame is detected in decode() (or on the
+// first edge of the next frame). Comment it out to get the original
+// Timer2 polling receiver.
+// The pin change vectors are shared with the buttons, see PinChangeInterrupt.h.
+#define IR_RECV_EDGE_CAPTURE
+
 
 
 #ifdef F_CPU
@@ -198,6 +209,8 @@
 #define STATE_MARK     3
 #define STATE_SPACE    4
 #define STATE_STOP     5
+// edge capture only: frame complete, rawbuf still holds microseconds
+#define STATE_STOP_US  6
 
 // information for the interrupt handler
 typedef struct {
@@ -207,6 +220,10 @@ typedef struct {
   unsigned int timer;     // state timer, counts 50uS ticks.
   unsigned int rawbuf[RAWBUF]; // raw data
   uint8_t rawlen;         // counter of entries in rawbuf
+#ifdef IR_RECV_EDGE_CAPTURE
+  uint8_t lastlevel;         // pin level after the last edge
+  unsigned long lastedge;    // micros() of the last edge
+#endif
 } 
 irparams_t;
 
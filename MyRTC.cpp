@@ -4,9 +4,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  2.1
+ * @version  2.3
  * @created  1.3.2011
- * @updated  16.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.1:  - dayOfMonth nach date umbenannt.
@@ -21,9 +21,12 @@
  * V 2.0:  - DS1307 nach MyRTC umbenannt, weil es jetzt nicht mehr nur um die DS1307 geht.
  *         - Getrennte Logik fuer das Rachtencksignal (SQW) eingefuehrt, danke an Erich M.
  * V 2.1:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
+ * V 2.2:  - Zugriff auf das batteriegepufferte RAM der DS1307 (readNvram/writeNvram) mit Pruefsumme.
+ * V 2.3:  - readNvram() ohne leeres endTransmission() nach requestFrom().
  */
 #include <Wire.h> // Wire library fuer I2C
 #include "MyRTC.h"
+#include <util/crc16.h>
 
 // #define DEBUG
 #include "Debug.h"
@@ -149,6 +152,73 @@ void MyRTC::enableSQWOnDS3231() {
     Wire.endTransmission();
 }
 
+/**
+ * Einen Datenblock aus dem RAM der DS1307 lesen.
+ *
+ * @return TRUE, wenn Kennung, Laenge und CRC passen. Sonst (z. B. nach einem
+ *         Batteriewechsel) bleiben die Daten unveraendert.
+ */
+boolean MyRTC::readNvram(byte* data, byte length) {
+    byte buffer[MYRTC_NVRAM_MAX_DATA];
+    if (length > MYRTC_NVRAM_MAX_DATA) {
+        return false;
+    }
+
+    Wire.beginTransmission(_address);
+    Wire.write((uint8_t) MYRTC_NVRAM_ADDRESS);
+    Wire.endTransmission(false);
+    byte count = Wire.requestFrom(_address, length + 3);
+    if (count != length + 3) {
+        // Den Rest verwerfen, requestFrom() hat den Bus schon freigegeben.
+        for (byte i = 0; i < count; i++) {
+            Wire.read();
+        }
+        return false;
+    }
+    byte magic = Wire.read();
+    byte storedLength = Wire.read();
+    for (byte i = 0; i < length; i++) {
+        buffer[i] = Wire.read();
+    }
+    byte crc = Wire.read();
+
+    if ((magic != MYRTC_NVRAM_MAGIC) || (storedLength != length) || (crc != _crc(buffer, length))) {
+        DEBUG_PRINTLN(F("NVRAM: no valid data."));
+        DEBUG_FLUSH();
+        return false;
+    }
+    memcpy(data, buffer, length);
+    return true;
+}
+
+/**
+ * Einen Datenblock in einem Rutsch in das RAM der DS1307 schreiben.
+ * Das RAM hat keine Begrenzung der Schreibzyklen.
+ */
+void MyRTC::writeNvram(byte* data, byte length) {
+    if (length > MYRTC_NVRAM_MAX_DATA) {
+        return;
+    }
+    Wire.beginTransmission(_address);
+    Wire.write((uint8_t) MYRTC_NVRAM_ADDRESS);
+    Wire.write((uint8_t) MYRTC_NVRAM_MAGIC);
+    Wire.write(length);
+    Wire.write(data, length);
+    Wire.write(_crc(data, length));
+    Wire.endTransmission();
+}
+
+/**
+ * CRC-8 (Dallas/Maxim) ueber den Datenblock.
+ */
+byte MyRTC::_crc(byte* data, byte length) {
+    byte crc = MYRTC_NVRAM_MAGIC;
+    for (byte i = 0; i < length; i++) {
+        crc = _crc_ibutton_update(crc, data[i]);
+    }
+    return crc;
+}
+
 /**
  * Konvertierung Dezimal zu "Binary Coded Decimal"
  */
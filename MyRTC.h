@@ -4,9 +4,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  2.1
+ * @version  2.2
  * @created  1.3.2011
- * @updated  16.2.2015
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.1:  - dayOfMonth nach date umbenannt.
@@ -21,6 +21,7 @@
  * V 2.0:  - DS1307 nach MyRTC umbenannt, weil es jetzt nicht mehr nur um die DS1307 geht.
  *         - Getrennte Logik fuer das Rachtencksignal (SQW) eingefuehrt, danke an Erich M.
  * V 2.1:  - Unterstuetzung fuer die alte Arduino-IDE (bis 1.0.6) entfernt.
+ * V 2.2:  - Zugriff auf das batteriegepufferte RAM der DS1307 (readNvram/writeNvram) mit Pruefsumme.
  */
 #ifndef MYRTC_H
 #define MYRTC_H
@@ -28,6 +29,16 @@
 #include "Arduino.h"
 #include "TimeStamp.h"
 
+/*
+ * Die DS1307 hat 56 Byte batteriegepuffertes RAM (0x08..0x3F). Darin liegt ein
+ * Block aus Kennung, Laenge, Daten und CRC. Der Block wird in einem Rutsch
+ * (Wire-Puffer: 32 Byte) geschrieben, die Daten duerfen also hoechstens
+ * MYRTC_NVRAM_MAX_DATA Byte lang sein.
+ */
+#define MYRTC_NVRAM_ADDRESS  0x08
+#define MYRTC_NVRAM_MAGIC    0xB8
+#define MYRTC_NVRAM_MAX_DATA 28
+
 class MyRTC : public TimeStamp {
 public:
     MyRTC(int address, byte statusLedPin);
@@ -40,6 +51,9 @@ public:
     void enableSQWOnDS1307();
     void enableSQWOnDS3231();
 
+    boolean readNvram(byte* data, byte length);
+    void writeNvram(byte* data, byte length);
+
     void setSeconds(byte seconds);
 
     byte getSeconds();
@@ -53,6 +67,7 @@ private:
     byte decToBcd(byte val);
     byte bcdToDec(byte val);
     uint8_t conv2d(const char* p);
+    byte _crc(byte* data, byte length);
 };
 
 #endif
@@ -0,0 +1,162 @@
+/**
+ * NightSchedule
+ * Die Nachtzeiten aus dem Zeitplan (Schedule) als sortierte Liste von
+ * Intervallen (Minuten der Woche, Ende exklusiv).
+ * Ein Nachtfenster ist ein NIGHT_OFF-Eintrag, direkt gefolgt von einem
+ * NIGHT_ON-Eintrag, an den Wochentagen des NIGHT_OFF-Eintrags. Liegt die
+ * Ausschaltzeit nach der Einschaltzeit, beginnt das Fenster am Vorabend.
+ * An Feiertagen gelten die Fenster des Sonntags.
+ *
+ * Der aktuelle Zustand und der naechste Wechsel werden gemerkt, bis dahin
+ * kostet isNight() nur einen Vergleich.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "NightSchedule.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+// Bit des Sonntags in den Wochentagen
+#define NIGHT_SCHEDULE_SUNDAY 0x40
+
+NightSchedule::NightSchedule() {
+    _count = 0;
+    _validLength = 0;
+}
+
+/**
+ * Die Intervalle aus dem Zeitplan neu aufbauen.
+ *
+ * @param holidays Wochentage (Bit 0 = Montag), die Feiertage sind.
+ */
+void NightSchedule::compile(Schedule* schedule, byte holidays) {
+    _count = 0;
+    for (byte i = 0; i + 1 < SCHEDULE_ENTRIES; i++) {
+        if ((schedule->getType(i) != SCHEDULE_TYPE_NIGHT_OFF) || (schedule->getType(i + 1) != SCHEDULE_TYPE_NIGHT_ON)
+            || !schedule->hasFlag(i, SCHEDULE_FLAG_ENABLED)) {
+            continue;
+        }
+        unsigned int off = schedule->getHours(i) * 60 + schedule->getMinutes(i);
+        unsigned int on = schedule->getHours(i + 1) * 60 + schedule->getMinutes(i + 1);
+        if (off == on) {
+            continue;
+        }
+        byte days = schedule->getDays(i);
+        for (byte day = 0; day < 7; day++) {
+            byte dayBit = 1 << day;
+            if (!((holidays & dayBit) ? (days & NIGHT_SCHEDULE_SUNDAY) : (days & dayBit))) {
+                continue;
+            }
+            unsigned int start = day * 24 * 60 + off;
+            unsigned int end = day * 24 * 60 + on;
+            if (off > on) {
+                // Am Vorabend, am Montag also am Sonntagabend
+                start = (start + SCHEDULE_MINUTES_OF_WEEK - 24 * 60) % SCHEDULE_MINUTES_OF_WEEK;
+            }
+            if (start > end) {
+                _add(start, SCHEDULE_MINUTES_OF_WEEK);
+                _add(0, end);
+            } else {
+                _add(start, end);
+            }
+        }
+    }
+    _validLength = 0;
+    DEBUG_PRINT(F("NightSchedule windows: "));
+    DEBUG_PRINTLN(_count);
+}
+
+/**
+ * Ist in dieser Minute der Woche Nacht?
+ */
+boolean NightSchedule::isNight(unsigned int minutesOfWeek) {
+    if ((unsigned int) ((minutesOfWeek + SCHEDULE_MINUTES_OF_WEEK - _validFrom) % SCHEDULE_MINUTES_OF_WEEK) >= _validLength) {
+        _locate(minutesOfWeek);
+    }
+    return _isNight;
+}
+
+/**
+ * Die Minute der Woche, in der sich der Zustand das naechste Mal aendert.
+ * Gilt nach einem Aufruf von isNight().
+ */
+unsigned int NightSchedule::getNextTransition() {
+    return (_validFrom + _validLength) % SCHEDULE_MINUTES_OF_WEEK;
+}
+
+/**
+ * Ein Intervall sortiert einfuegen, ueberlappende zusammenfassen.
+ */
+void NightSchedule::_add(unsigned int start, unsigned int end) {
+    byte i = 0;
+    while ((i < _count) && (_start[i] < start)) {
+        i++;
+    }
+    // Mit dem Vorgaenger zusammenfassen?
+    if ((i > 0) && (_end[i - 1] >= start)) {
+        i--;
+        if (end > _end[i]) {
+            _end[i] = end;
+        }
+    } else {
+        if (_count == NIGHT_SCHEDULE_MAX_WINDOWS) {
+            DEBUG_PRINTLN(F("NightSchedule: too many windows."));
+            return;
+        }
+        for (byte j = _count; j > i; j--) {
+            _start[j] = _start[j - 1];
+            _end[j] = _end[j - 1];
+        }
+        _start[i] = start;
+        _end[i] = end;
+        _count++;
+    }
+    // Nachfolger schlucken, die jetzt ueberlappen
+    while ((i + 1 < _count) && (_start[i + 1] <= _end[i])) {
+        if (_end[i + 1] > _end[i]) {
+            _end[i] = _end[i + 1];
+        }
+        for (byte j = i + 1; j + 1 < _count; j++) {
+            _start[j] = _start[j + 1];
+            _end[j] = _end[j + 1];
+        }
+        _count--;
+    }
+}
+
+/**
+ * Zustand und naechsten Wechsel fuer eine Minute der Woche suchen.
+ */
+void NightSchedule::_locate(unsigned int minutesOfWeek) {
+    _validFrom = minutesOfWeek;
+    if (_count == 0) {
+        _isNight = false;
+        _validLength = SCHEDULE_MINUTES_OF_WEEK;
+        return;
+    }
+    // das erste Intervall, das nach minutesOfWeek endet
+    byte i = 0;
+    while ((i < _count) && (_end[i] <= minutesOfWeek)) {
+        i++;
+    }
+    unsigned int next;
+    if (i == _count) {
+        _isNight = false;
+        next = _start[0] + SCHEDULE_MINUTES_OF_WEEK;
+    } else if (_start[i] <= minutesOfWeek) {
+        _isNight = true;
+        next = _end[i];
+    } else {
+        _isNight = false;
+        next = _start[i];
+    }
+    _validLength = next - minutesOfWeek;
+}
@@ -0,0 +1,51 @@
+/**
+ * NightSchedule
+ * Die Nachtzeiten aus dem Zeitplan (Schedule) als sortierte Liste von
+ * Intervallen (Minuten der Woche, Ende exklusiv).
+ * Ein Nachtfenster ist ein NIGHT_OFF-Eintrag, direkt gefolgt von einem
+ * NIGHT_ON-Eintrag, an den Wochentagen des NIGHT_OFF-Eintrags. Liegt die
+ * Ausschaltzeit nach der Einschaltzeit, beginnt das Fenster am Vorabend.
+ * An Feiertagen gelten die Fenster des Sonntags.
+ *
+ * Der aktuelle Zustand und der naechste Wechsel werden gemerkt, bis dahin
+ * kostet isNight() nur einen Vergleich.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef NIGHTSCHEDULE_H
+#define NIGHTSCHEDULE_H
+
+#include "Arduino.h"
+#include "Schedule.h"
+
+#define NIGHT_SCHEDULE_MAX_WINDOWS 16
+
+class NightSchedule {
+public:
+    NightSchedule();
+
+    void compile(Schedule* schedule, byte holidays);
+    boolean isNight(unsigned int minutesOfWeek);
+    unsigned int getNextTransition();
+
+private:
+    unsigned int _start[NIGHT_SCHEDULE_MAX_WINDOWS];
+    unsigned int _end[NIGHT_SCHEDULE_MAX_WINDOWS];
+    byte _count;
+
+    boolean _isNight;
+    unsigned int _validFrom;
+    unsigned int _validLength;
+
+    void _add(unsigned int start, unsigned int end);
+    void _locate(unsigned int minutesOfWeek);
+};
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * PinChangeInterrupt
+ * Verteilt die Pin-Change-Interrupts (PCINT0..2) des ATmega328 an
+ * angemeldete Routinen. So koennen sich der IR-Empfaenger und die Tasten
+ * einen Port (z. B. A1 und A2) teilen.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - attachPinChangeInterrupt() meldet, ob die Routine angemeldet wurde.
+ *         - Nur die Interrupt-Vektoren der Ports aus PCINT_PORTS.
+ */
+#include "PinChangeInterrupt.h"
+#include <avr/interrupt.h>
+
+// #define DEBUG
+#include "Debug.h"
+
+static PinChangeHandler volatile _pinChangeHandlers[3][PCINT_MAX_HANDLERS_PER_PORT];
+
+/**
+ * Den Pin-Change-Interrupt fuer einen Pin einschalten und die Routine anmelden.
+ *
+ * @param pin Der Arduino-Pin.
+ * @param handler Die Routine, die im Interrupt aufgerufen wird.
+ * @return TRUE, wenn die Routine angemeldet ist.
+ */
+boolean attachPinChangeInterrupt(byte pin, PinChangeHandler handler) {
+    if ((digitalPinToPCICR(pin) == 0) || !(PCINT_PORTS & _BV(digitalPinToPCICRbit(pin)))) {
+        DEBUG_PRINT(F("No pin change interrupt on pin "));
+        DEBUG_PRINTLN(pin);
+        return false;
+    }
+    byte port = digitalPinToPCICRbit(pin);
+
+    boolean attached = false;
+    uint8_t oldSREG = SREG;
+    cli();
+    for (byte i = 0; i < PCINT_MAX_HANDLERS_PER_PORT; i++) {
+        if ((_pinChangeHandlers[port][i] == handler) || (_pinChangeHandlers[port][i] == 0)) {
+            _pinChangeHandlers[port][i] = handler;
+            attached = true;
+            break;
+        }
+    }
+    if (attached) {
+        *digitalPinToPCMSK(pin) |= _BV(digitalPinToPCMSKbit(pin));
+        PCIFR = _BV(port);
+        *digitalPinToPCICR(pin) |= _BV(port);
+    }
+    SREG = oldSREG;
+    if (!attached) {
+        DEBUG_PRINT(F("No free pin change handler for pin "));
+        DEBUG_PRINTLN(pin);
+    }
+    return attached;
+}
+
+static inline void _dispatchPinChange(byte port) {
+    for (byte i = 0; i < PCINT_MAX_HANDLERS_PER_PORT; i++) {
+        PinChangeHandler handler = _pinChangeHandlers[port][i];
+        if (handler != 0) {
+            handler();
+        }
+    }
+}
+
+#if PCINT_PORTS & 0x01
+ISR(PCINT0_vect) {
+    _dispatchPinChange(0);
+}
+#endif
+
+#if PCINT_PORTS & 0x02
+ISR(PCINT1_vect) {
+    _dispatchPinChange(1);
+}
+#endif
+
+#if PCINT_PORTS & 0x04
+ISR(PCINT2_vect) {
+    _dispatchPinChange(2);
+}
+#endif
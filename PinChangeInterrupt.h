@@ -0,0 +1,45 @@
+/**
+ * PinChangeInterrupt
+ * Verteilt die Pin-Change-Interrupts (PCINT0..2) des ATmega328 an
+ * angemeldete Routinen. So koennen sich der IR-Empfaenger und die Tasten
+ * einen Port (z. B. A1 und A2) teilen.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - attachPinChangeInterrupt() meldet, ob die Routine angemeldet wurde.
+ *         - Nur die Interrupt-Vektoren der Ports aus PCINT_PORTS.
+ */
+#ifndef PIN_CHANGE_INTERRUPT_H
+#define PIN_CHANGE_INTERRUPT_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+/*
+ * Wieviele Routinen duerfen sich einen Port teilen?
+ */
+#define PCINT_MAX_HANDLERS_PER_PORT 2
+
+#ifndef PCINT_PORTS
+    #define PCINT_PORTS 0x07
+#endif
+
+typedef void (*PinChangeHandler)(void);
+
+/*
+ * Den Pin-Change-Interrupt fuer einen Pin einschalten und die Routine anmelden.
+ * Die Routine wird im Interrupt bei jeder Aenderung eines angemeldeten Pins
+ * des Ports aufgerufen und muss selbst pruefen, ob sich 'ihr' Pin geaendert hat.
+ * Liefert FALSE, wenn der Pin keinen Pin-Change-Interrupt hat, sein Port nicht
+ * in PCINT_PORTS steht oder schon PCINT_MAX_HANDLERS_PER_PORT Routinen am Port
+ * haengen. Der Interrupt bleibt dann aus.
+ */
+boolean attachPinChangeInterrupt(byte pin, PinChangeHandler handler);
+
+#endif
@@ -3,9 +3,9 @@
  * Die Firmware der Selbstbau-QLOCKTWO.
  *
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  3.4.10
+ * @version  3.4.11
  * @created  01.11.2011
- * @updated  30.01.2022 TF basierend auf Ergänzungen und Änderungen von A. Mueller
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.1:   - DCF77 auf reine Zeit ohne Strings umgestellt.
@@ -314,6 +314,34 @@
  *            * 12/24 h Weckzeitmodus im Menue einstellbar 
  *            * Snooze-Dauer im Menue einstellbar
  *            * getestet mit 5-Tasten-Wecker
+ * V 3.4.11   Optimierungen
+ *            * IR-Empfang ueber Pin-Change-Interrupt statt 50us-Timer-Interrupt. Ohne Fernbedienung kostet der Empfang keine Rechenzeit mehr.
+ *            * IR-Protokolle werden beim Compilieren passend zur Fernbedienung gewaehlt (Configuration.h), der IR-Sender wird nicht mehr uebersetzt.
+ *            * Fernbedienungen werden als sortierte Code-Tabelle im PROGMEM beschrieben (IRTranslatorTable, binaere Suche).
+ *            * Lernmodus fuer unbekannte Fernbedienungs-Codes (EXT_MODE_IR_LEARN, Codes im EEPROM).
+ *            * Tasten per Pin-Change-Interrupt entprellt, Ereignisse (auch der Fernbedienung) laufen ueber eine Warteschlange (ButtonEvents).
+ *            * LDR und Naeherungssensor werden im Hintergrund gelesen und gefiltert (AnalogSampler), kein Einlesen beim Start mehr.
+ *            * Helligkeitsregelung mit begrenzter Geschwindigkeit (%/s) und Kennlinie (BrightnessController), die Settings bleiben dabei unberuehrt.
+ *            * Einstellungen als Journal mit CRC im EEPROM (SettingsJournal), Schreibzugriffe werden ueber das ganze EEPROM verteilt.
+ *            * Haeufig wechselnde Werte (LDR-Grenzen, letzte DCF77-Synchronisation, Schlummermodus, Nachtsperre) im RAM der DS1307.
+ *            * Weckmelodien als Ereignisfolgen im PROGMEM, gespielt im Timer1-Interrupt (MelodyPlayer).
+ *            * Zeitplan (Schedule) fuer mehrere Weckzeiten mit Wochentagen und die Nachtzeiten, der naechste Zeitpunkt wird vorausberechnet.
+ *            * Nachtschaltung als sortierte Intervalle je Wochentag mit Feiertagen (NightSchedule), der naechste Wechsel wird gemerkt.
+ *            * Modi als Tabelle im PROGMEM (Nachfolger, Flags, Ruecksprung, Anzeige- und Tastenfunktionen), die Modi sind neu durchnummeriert.
+ *            * Die Anzeige wird nur neu geschrieben, wenn sich etwas aendert (refresh in der Modus-Tabelle, Tasten, Blinken).
+ *            * Ereignis des Tages und naechstes Countdown-Ziel werden einmal am Tag gesucht (updateEventCache()).
+ *            * Ereignis-Symbole gepackt und gemeinsam nutzbar, bewegliche Ereignisse (Ostern, n-ter Wochentag) einmal im Jahr berechnet.
+ *            * Buchstaben und Ziffern an beliebigen Spalten und durchlaufende Texte (TextRenderer) fuer den Sync-Status (EXT_MODE_DCF_SYNC), optional auch fuer das Datum (DATE_SCROLL).
+ *            * Laufzeitmessung der Abschnitte von loop() mit Histogrammen (LOOP_PROFILER, Menue EXT_MODE_PROFILER, Ausgabe ueber Serial).
+ *            * Log-Eintraege mit Nummer statt Text (LogMessages.h), mit DEBUG_BINARY_LOG binaer und ohne zu blockieren, Decoder in tools/logdecoder.py.
+ *            * Ringpuffer der letzten Ereignisse (TRACE_ENABLE, EventTrace), Anzeige im Menue EXT_MODE_TRACE, Ausgabe ueber Serial, optional ueber einen Reset hinweg.
+ *            * Kommandozeile ueber Serial (SERIAL_CONSOLE, SerialConsole): Zeit, Datum, Einstellungen, Zeitplan, DCF77-Neusynchronisation und Statistiken.
+ *            * Bei dunkler Anzeige schlaeft der ATmega zwischen den Durchlaeufen von loop() (SLEEP_ENABLE, SleepScheduler), mit Statistik.
+ *            * Periodische Aufgaben (Dimmung, Alarm-LED, DCF77-Takt) laufen ueber einen festen Plan (TaskScheduler) mit Zaehlern fuer verpasste Faelligkeiten.
+ *            * Schneller Start (FAST_BOOT): Die Zeit steht sofort, Blinken und Infos nur mit gedrueckter Mode-Taste bzw. nach dem ersten Bild. Die Zeit bis zum ersten Bild wird gemessen.
+ *            * Zeit von einem GPS-Empfaenger ueber Serial (GPS_ENABLE, MyGPS: NMEA RMC/ZDA, Zeitzone und Sommerzeit, optional PPS), Simulator in tools/gpssim.py.
+ *            * Der TimeArbiter bewertet die Zeitquellen (Uebereinstimmung, Alter, Jitter, Fehler), waehlt die beste, verwirft Ausreisser und
+ *              entscheidet, wann der DCF77-Empfaenger eingeschaltet wird (DCF77_POWER_SAVE). Die Zeitverschiebung kommt an einer Stelle dazu.
  */
 #include <Wire.h> // Wire library fuer I2C
 #include <avr/pgmspace.h>
@@ -331,6 +359,7 @@
 #include "LedDriverDotStar.h"
 #include "LedDriverLPD8806.h"
 #include "IRTranslator.h"
+#include "IRTranslatorTable.h"
 #include "IRTranslatorSparkfun.h"
 #include "IRTranslatorMooncandles.h"
 #include "IRTranslatorLunartec.h"
@@ -338,16 +367,27 @@
 #include "MyRTC.h"
 #ifdef DCF77_SENSOR_EXISTS
     #include "MyDCF77.h"
+#endif
+#if defined(DCF77_SENSOR_EXISTS) || defined(GPS_ENABLE)
     #include "DCF77Helper.h"
 #endif
+#include "MyGPS.h"
+#include "TimeArbiter.h"
 #include "Button.h"
 #include "AnalogButton.h"
+#include "ButtonEvents.h"
+#include "AnalogSampler.h"
+#include "BrightnessController.h"
 #include "LDR.h"
 #include "Renderer.h"
-#include "Staben.h"
 #include "Settings.h"
-#include "Zahlen.h"
-#include "ZahlenKlein.h"
+#include "NightSchedule.h"
+#include "TextRenderer.h"
+#include "LoopProfiler.h"
+#include "EventTrace.h"
+#include "SerialConsole.h"
+#include "SleepScheduler.h"
+#include "TaskScheduler.h"
 #ifdef EVENTDAY
 #include "Ereignisse.h"
 #endif
@@ -363,8 +403,18 @@
 //#define DEBUG
 #include "Debug.h"
 // Die Geschwindigkeit der seriellen Schnittstelle. Default: 57600. Die Geschwindigkeit brauchen wir immer,
-// da auch ohne DEBUG Meldungen ausgegeben werden!
-#define SERIAL_SPEED 57600
+// da auch ohne DEBUG Meldungen ausgegeben werden! Mit GPS_ENABLE gibt der Empfaenger sie vor.
+#ifdef GPS_ENABLE
+    #define SERIAL_SPEED GPS_SERIAL_SPEED
+#else
+    #define SERIAL_SPEED 57600
+#endif
+#if defined(GPS_ENABLE) && defined(SERIAL_CONSOLE)
+    #error "GPS_ENABLE und SERIAL_CONSOLE brauchen beide den Empfang von Serial."
+#endif
+#if defined(DCF77_POWER_SAVE) && defined(WW_5_BUTTONS_ENABLE_NEARSENSOR_A0)
+    #error "DCF77_POWER_SAVE und WW_5_BUTTONS_ENABLE_NEARSENSOR_A0 schalten beide den DCF77-Empfaenger."
+#endif
 
 /*
  * Die persistenten (im EEPROM gespeicherten) Einstellungen.
@@ -376,6 +426,64 @@ Settings settings;
  */
 Renderer renderer;
 
+/**
+ * Schreibt Buchstaben, Ziffern und durchlaufende Texte auf die Matrix.
+ */
+TextRenderer textRenderer;
+
+#ifdef LOOP_PROFILER
+/**
+ * Misst die Laufzeit der Abschnitte von loop().
+ */
+LoopProfiler loopProfiler;
+// Der im Menue angezeigte Abschnitt
+byte profilerStage = PROFILER_STAGE_LDR;
+#endif
+
+#ifdef TRACE_ENABLE
+// Der im Menue angezeigte Eintrag der Ereignisse (0 = der neueste)
+byte traceAge = 0;
+#endif
+
+#ifdef SERIAL_CONSOLE
+/**
+ * Die Kommandozeile ueber Serial.
+ */
+SerialConsole serialConsole;
+#endif
+
+#ifdef SLEEP_ENABLE
+/**
+ * Schlafen, solange die Anzeige aus ist.
+ */
+SleepScheduler sleepScheduler;
+// Ist die naechste Aufgabe (TaskScheduler) frueher faellig, wird nicht geschlafen.
+#define SLEEP_MIN_MICROS 1024
+#endif
+
+/**
+ * Die periodischen Aufgaben in loop() mit ihrer Periode in Mikrosekunden.
+ * Die Tabelle steht vor den Funktionen, deshalb die Deklarationen.
+ */
+void brightnessTask();
+void alarmLedTask();
+void dcf77Task();
+const TaskEntry tasks[] PROGMEM = {
+    {LDR_CHECK_RATE * 1000UL, brightnessTask},
+#ifdef ALARM_OPTION_ENABLE
+    {ALARM_LED_TICK * 1000UL, alarmLedTask},
+#endif
+#ifdef DCF77_SENSOR_EXISTS
+    {1000000UL / MYDCF77_SIGNAL_BINS, dcf77Task},
+#endif
+};
+static_assert(sizeof(tasks) / sizeof(tasks[0]) <= TASK_SCHEDULER_MAX_TASKS, "Mehr Aufgaben als TASK_SCHEDULER_MAX_TASKS.");
+TaskScheduler taskScheduler(tasks, sizeof(tasks) / sizeof(tasks[0]));
+#ifdef ALARM_OPTION_ENABLE
+// Der zuletzt gerenderte Zustand der Alarm-LED
+boolean isAlarmLedOn = false;
+#endif
+
 /**
  * Der LED-Treiber fuer 74HC595-Shift-Register. Verwendet
  * von der Drei-Lochraster-Platinen-Version und dem
@@ -573,6 +681,21 @@ IRTranslatorMooncandles irTranslator;
 #ifdef REMOTE_LUNARTEC
 IRTranslatorLunartec irTranslator;
 #endif
+#ifdef IR_LEARN_ENABLE
+// Die Taste, der im Lernmodus der naechste Code zugeordnet wird.
+byte irLearnButton = REMOTE_BUTTON_MODE;
+#endif
+
+/**
+ * Der Start: Diagnose (Blinken der Status-LEDs, Infos ueber Serial) in setup()
+ * und die Zeit bis zum ersten Bild.
+ */
+#ifdef FAST_BOOT
+boolean bootDiagnostics = false;
+#else
+boolean bootDiagnostics = true;
+#endif
+word bootMillis = 0;
 
 /**
  * Die Real-Time-Clock mit der Status-LED fuer das SQW-Signal.
@@ -588,6 +711,21 @@ volatile byte helperSeconds;
     DCF77Helper dcf77Helper;
 #endif
 
+/**
+ * Der GPS-Empfaenger (NMEA ueber Serial).
+ */
+#ifdef GPS_ENABLE
+    MyGPS gps;
+    DCF77Helper gpsHelper;
+#endif
+
+/**
+ * Wer darf die RTC stellen?
+ */
+#if defined(DCF77_SENSOR_EXISTS) || defined(GPS_ENABLE)
+    TimeArbiter timeArbiter;
+#endif
+
 /**
  * Variable fuer den Alarm.
  */
@@ -599,77 +737,120 @@ volatile byte helperSeconds;
  * Der Helligkeitssensor
  */
 LDR ldr(PIN_LDR, IS_INVERTED, &settings);
-unsigned long lastBrightnessCheck;
 
 /**
- * Die Tasten.
+ * Die Helligkeitsregelung (LDR bzw. manuelle Helligkeit -> LED-Treiber).
  */
-#ifdef WW_5_BUTTONS
-    Button alarmButton(PIN_ALARM, BUTTONS_PRESSING_AGAINST);
-#endif
-Button minutesPlusButton(PIN_M_PLUS, BUTTONS_PRESSING_AGAINST);
-Button hoursPlusButton(PIN_H_PLUS, BUTTONS_PRESSING_AGAINST);
-Button extModeDoubleButton(PIN_M_PLUS, PIN_H_PLUS, BUTTONS_PRESSING_AGAINST);
-Button modeChangeButton(PIN_MODE, BUTTONS_PRESSING_AGAINST);
+BrightnessController brightnessController(&ledDriver);
+
+/**
+ * Die Tasten. Sie werden per Interrupt abgefragt und in setup() angemeldet.
+ */
+#define BUTTON_MODE     0
+#define BUTTON_M_PLUS   1
+#define BUTTON_H_PLUS   2
+#define BUTTON_EXT_MODE 3
+#define BUTTON_ALARM    4
+ButtonEvents buttonEvents;
 
 /**
  * Die Standard-Modi.
+ * Die Modi sind fortlaufend nummeriert, weil sie Indizes in die
+ * Modus-Tabelle (modeTable, siehe unten) sind.
  */
 #define STD_MODE_NORMAL     0
 #define STD_MODE_ALARM      1
-#ifdef WW_5_BUTTONS
-    #define STD_MODE_WW_START   2
-#endif
 #define STD_MODE_SECONDS    2
 #define STD_MODE_COUNTDOWN  3
 #define STD_MODE_DATE       4
-#ifdef WW_5_BUTTONS
-    #define STD_MODE_WW_END     5
-#endif
 #define STD_MODE_BRIGHTNESS 5
 #define STD_MODE_BLANK      6
-#define STD_MODE_COUNT      7
 // nicht manuell zu erreichender Modus...
-#define STD_MODE_NIGHT      8
+#define STD_MODE_NIGHT      7
 // Modus "alle LEDs an" für WW
-#ifdef WW_5_BUTTONS
-    #define STD_MODE_ALLON  9
-#endif
+#define STD_MODE_ALLON      8
 
 /**
  * Die erweiterten Modi.
  */
-#define EXT_MODE_START            20
-
-#define EXT_MODE_MAIN_SETTINGS_START  20
-#define EXT_MODE_LDR_MODE         21
-#define EXT_MODE_LDR_NIGHT_MODE   22
-#define EXT_MODE_LDR_NIGHT_THRESH 23
-#define EXT_MODE_CORNERS          24
-#define EXT_MODE_ES_IST           25
-#define EXT_MODE_ALARM_MELODY     26
-#define EXT_MODE_DCF_IS_INVERTED  27
-#define EXT_MODE_LANGUAGE         28
-
-#define EXT_MODE_TIME_SETTINGS_START  29
-#define EXT_MODE_TIME_SHIFT       30
-#define EXT_MODE_YEARSET          31
-#define EXT_MODE_MONTHSET         32
-#define EXT_MODE_DATESET          33
-#define EXT_MODE_TIMESET          34
-#define EXT_MODE_OFFTIME_MOFR     35
-#define EXT_MODE_ONTIME_MOFR      36
-#define EXT_MODE_OFFTIME_SASO     37
-#define EXT_MODE_ONTIME_SASO      38
-#define EXT_MODE_24               39
-#define EXT_MODE_SNOOZE           40 
-
-#define EXT_MODE_TEST_DEBUG_START     41
-#define EXT_MODE_TEST             42
-#define EXT_MODE_DCF_SYNC         43
-#define EXT_MODE_DCF_DEBUG        44
-#define EXT_MODE_DCF_BLANK        45
-#define EXT_MODE_COUNT            46
+#define EXT_MODE_START            9
+
+#define EXT_MODE_MAIN_SETTINGS_START  9
+#define EXT_MODE_LDR_MODE         10
+#define EXT_MODE_LDR_NIGHT_MODE   11
+#define EXT_MODE_LDR_NIGHT_THRESH 12
+#define EXT_MODE_CORNERS          13
+#define EXT_MODE_ES_IST           14
+#define EXT_MODE_ALARM_MELODY     15
+#define EXT_MODE_DCF_IS_INVERTED  16
+#define EXT_MODE_LANGUAGE         17
+
+#define EXT_MODE_TIME_SETTINGS_START  18
+#define EXT_MODE_TIME_SHIFT       19
+#define EXT_MODE_YEARSET          20
+#define EXT_MODE_MONTHSET         21
+#define EXT_MODE_DATESET          22
+#define EXT_MODE_TIMESET          23
+#define EXT_MODE_OFFTIME_MOFR     24
+#define EXT_MODE_ONTIME_MOFR      25
+#define EXT_MODE_OFFTIME_SASO     26
+#define EXT_MODE_ONTIME_SASO      27
+#define EXT_MODE_24               28
+#define EXT_MODE_SNOOZE           29
+
+#define EXT_MODE_TEST_DEBUG_START     30
+#define EXT_MODE_TEST             31
+#define EXT_MODE_DCF_SYNC         32
+#define EXT_MODE_DCF_DEBUG        33
+#define EXT_MODE_DCF_BLANK        34
+#define EXT_MODE_IR_LEARN         35
+#define EXT_MODE_PROFILER         36
+#define EXT_MODE_TRACE            37
+#define EXT_MODE_COUNT            38
+
+/**
+ * Die Modus-Tabelle: pro Modus der Nachfolger (Mode-Taste), die Flags,
+ * der automatische Ruecksprung (Sekunden, 0 = keiner), wann sich die
+ * Anzeige von selbst aendert (refresh) und die Funktionen fuer die Anzeige
+ * und die Tasten (NULL = nichts tun). Ist modeKey gesetzt, wird sie statt
+ * des Weiterschaltens aufgerufen.
+ */
+typedef void (*ModeFunction)();
+
+struct ModeEntry {
+    byte next;
+    byte flags;
+    byte timeout;
+    byte refresh;
+    ModeFunction render;
+    ModeFunction hourPlus;
+    ModeFunction minutePlus;
+    ModeFunction modeKey;
+};
+
+// Nachtschaltung erlaubt
+#define MODE_FLAG_NIGHT_ALLOWED   0x01
+// Display aus
+#define MODE_FLAG_DARK            0x02
+// Per #define abgeschaltet
+#define MODE_FLAG_SKIP            0x04
+// Nur mit LDR
+#define MODE_FLAG_NEEDS_LDR       0x08
+// Nur mit LDR-gesteuerter Nachtschaltung
+#define MODE_FLAG_NEEDS_LDR_BLANK 0x10
+// Ueberspringen, wenn der LDR die Nachtschaltung macht
+#define MODE_FLAG_NIGHT_TIME      0x20
+// Nur, wenn ein Countdown laeuft
+#define MODE_FLAG_NEEDS_COUNTDOWN 0x40
+
+// Die Anzeige aendert sich nur durch Tasten
+#define MODE_REFRESH_INPUT        0
+// ... jede Minute (Worte, Ecken, Datum)
+#define MODE_REFRESH_MINUTE       1
+// ... jede Sekunde (Sekunden, Countdown, Test)
+#define MODE_REFRESH_SECOND       2
+
+extern const ModeEntry modeTable[] PROGMEM;
 
 // Startmode...
 byte mode = STD_MODE_NORMAL;
@@ -683,6 +864,9 @@ word matrix[16];
 
 // Hilfsvariable, da I2C und Interrupts nicht zusammenspielen
 volatile boolean needsUpdateFromRtc = true;
+// Die Anzeige muss neu geschrieben werden (Taste, Blinken, Alarm-LED).
+// Die regelmaessigen Aenderungen kommen aus der Modus-Tabelle (refresh).
+boolean needsRender = true;
 
 // Fuer den Bildschirm-Test
 byte x, y;
@@ -695,13 +879,26 @@ byte x, y;
 
 // Eigene Variablendeklaration
 #ifdef EVENTDAY
-    // Fuer die Anzeige eines Symbols bei einem Ereignis
+    // Fuer die Anzeige eines Symbols bei einem Ereignis (Nummer in eventSymbols[])
     char eventdaySymbol;
+    // Das Symbol des heutigen Tages (-1 = keins) und fuer welchen Tag es gilt, siehe updateEventCache()
+    char eventdayToday = -1;
+    byte eventCacheDate;
+    byte eventCacheMonth;
+    // Die Tage (Tag, Monat) der beweglichen Ereignisse und fuer welches Jahr sie berechnet wurden
+    byte eventRuleDates[sizeof(eventRules) / sizeof(EventRule)][2];
+    byte eventRuleYear = 0xFF;
 #endif
 
 #ifdef COUNTDOWN
     // Fuer den Ereignis-Countdown
     int countdown;
+    // Das Symbol des naechsten Countdowns (-1 = keiner), Beginn und Ziel in Minuten des Jahrhunderts
+    char countdownSymbol = -1;
+    unsigned long countdownStart;
+    unsigned long countdownTarget;
+    // Wann das Countdown-Ziel berechnet wurde (Minuten des Jahrhunderts)
+    unsigned long countdownCachedAt;
 #endif
 
 // Fuer LDR-Nachtmodus
@@ -709,6 +906,23 @@ byte LdrThresholdZustand;
 // Fuer den Näherungssensor
 boolean nightLock;
 
+/**
+ * Haeufig wechselnde Werte, die im RAM der DS1307 ueberleben (siehe saveHotValues()).
+ */
+#ifdef RTC_NVRAM_HOT_VALUES
+    struct HotValues {
+        unsigned int ldrAutoMin;
+        unsigned int ldrAutoMax;
+        // Letzte DCF77-Synchronisation: Minuten, Stunden, Tag, Monat, Jahr
+        byte dcf77LastSync[5];
+        // Beginn des Schlummermodus in Minuten des Tages, 0xFFFF = kein Schlummermodus
+        unsigned int snoozeStart;
+        byte nightByTimeLock;
+    };
+    HotValues hotValues;
+    HotValues hotValuesSaved;
+#endif
+
 // 0: Nachtschaltung via Zeitsteuerung erlaubt
 // 1: Nachtschaltung via Zeitsteuerung deaktiviert + (Nur bei 5-Tasten-Wortwecker: DCF77-Empfänger ein- (und Näherungssensor ausgeschaltet))
 // 2: (Nur bei 5-Tasten-Wortwecker: Wie 1 + DCF77-Empfänger aus- (und Näherunssensor eingeschaltet))
@@ -717,26 +931,159 @@ byte nightByTimeLock;
 // Fuer automatischen Rücksprung zur Standardanzeige
 byte jumpToTime;
 
+// Die gerade faelligen Eintraege des Zeitplans (siehe Schedule::poll())
+byte scheduleDue;
+
+// Die Nachtzeiten als Intervalle (aus dem Zeitplan)
+NightSchedule nightSchedule;
+
 /**
  * Automatisches Zurückschalten von einer definierten Anzeige auf die Zeitanzeige nach einer
  * festgelegten Zeitspanne jumpToTime. Ist dieser Wert == 0, so findet kein
  * automatischer Rücksprung statt.
- * Achtung!: Als Modi (von denen aus zurückgesprungen werden soll) nur Standardmodi verwenden.
+ * Die Modi mit Ruecksprung haben in der Modus-Tabelle einen timeout.
  */
 static void updateJumpToTime() {
-    if (TIMEOUT_JUMP_TO_TIME > 0) {
-        switch (mode) {
-            case STD_MODE_SECONDS:
-            case STD_MODE_DATE:
-                jumpToTime--;
-                if (!jumpToTime) {
-                    mode = STD_MODE_NORMAL;
-                }
-                break;
+    if (pgm_read_byte_near(&modeTable[mode].timeout)) {
+        jumpToTime--;
+        if (!jumpToTime) {
+            mode = STD_MODE_NORMAL;
         }
     }
 }
 
+#ifdef EVENTDAY
+    /*
+     * Die Tage der beweglichen Ereignisse (eventRules[]) fuer das Jahr der RTC berechnen.
+     */
+    void updateEventRuleDates() {
+        byte year = rtc.getYear();
+        eventRuleYear = year;
+
+        // Ostersonntag nach Gauss (2000 bis 2099), als Tag ab dem 1. Maerz
+        byte a = (year + 5) % 19; // (2000 + year) % 19
+        byte h = (19 * a + 24) % 30;
+        byte l = (32 + 2 * (year / 4) - h - (year % 4)) % 7;
+        byte m = (a + 11 * h + 22 * l) / 451;
+        byte easterMarchDay = h + l - 7 * m + 22;
+        byte leapDay = (year % 4) ? 0 : 1;
+
+        for (byte i = 0; i < sizeof(eventRules) / sizeof(EventRule); i++) {
+            char arg = pgm_read_byte_near(&eventRules[i].arg);
+            byte month = pgm_read_byte_near(&eventRules[i].month);
+            TimeStamp date(0, 0, 1, 0, 1, year);
+            switch (pgm_read_byte_near(&eventRules[i].rule)) {
+                case EVENT_RULE_EASTER:
+                    // Tage ab dem 1. Januar
+                    date.incDate(31 + 28 + leapDay + easterMarchDay - 1 + arg, true);
+                    break;
+                case EVENT_RULE_NTH_WEEKDAY: {
+                    date.setMonth(month);
+                    byte weekday = pgm_read_byte_near(&eventRules[i].weekday);
+                    byte day = 1 + (weekday + 7 - date.getDayOfWeek()) % 7 + 7 * (arg - 1);
+                    byte daysOfMonth = (month == 2) ? 28 + leapDay : 30 + ((month + (month > 7)) & 1);
+                    while (day > daysOfMonth) {
+                        day -= 7;
+                    }
+                    date.setDate(day);
+                    break;
+                }
+            }
+            eventRuleDates[i][0] = date.getDate();
+            eventRuleDates[i][1] = date.getMonth();
+        }
+    }
+
+    #ifdef COUNTDOWN
+        /*
+         * Ein Countdown-Ziel pruefen. Gemerkt wird der Countdown, der als erster beginnt.
+         */
+        void addCountdownCandidate(unsigned long target, byte countdownMinutes, byte symbol) {
+            unsigned long start = target - countdownMinutes;
+            if ((countdownSymbol == -1) || (start < countdownStart)) {
+                countdownSymbol = symbol;
+                countdownStart = start;
+                countdownTarget = target;
+            }
+        }
+    #endif
+
+    /*
+     * Das Ereignis des Tages und das naechste Countdown-Ziel suchen. Die Listen werden
+     * nur einmal am Tag durchsucht (bzw. wenn das Ziel vorbei ist oder die Zeit
+     * zurueckgestellt wurde), die Pruefung jede Minute ist dann eine Subtraktion.
+     */
+    void updateEventCache() {
+        byte date = rtc.getDate();
+        byte month = rtc.getMonth();
+        boolean newDay = (date != eventCacheDate) || (month != eventCacheMonth);
+
+        if (newDay) {
+            eventCacheDate = date;
+            eventCacheMonth = month;
+            if (rtc.getYear() != eventRuleYear) {
+                updateEventRuleDates();
+            }
+            eventdayToday = -1;
+            for (byte i = 0; i < sizeof(eventdayObject)/sizeof(EventdayObject); i++) {
+                if ( (pgm_read_byte_near(&eventdayObject[i].day) == date) && (pgm_read_byte_near(&eventdayObject[i].month) == month) ) {
+                    eventdayToday = pgm_read_byte_near(&eventdayObject[i].symbol);
+                    break;
+                }
+            }
+            for (byte i = 0; (eventdayToday == -1) && (i < sizeof(eventRules) / sizeof(EventRule)); i++) {
+                if ( (eventRuleDates[i][0] == date) && (eventRuleDates[i][1] == month) ) {
+                    eventdayToday = pgm_read_byte_near(&eventRules[i].symbol);
+                }
+            }
+        }
+
+        #ifdef COUNTDOWN
+            unsigned long now = rtc.getMinutesOfCentury();
+            if ( !newDay && (now >= countdownCachedAt) && ((countdownSymbol == -1) || (now <= countdownTarget)) ) {
+                return;
+            }
+            countdownCachedAt = now;
+            countdownSymbol = -1;
+            for (byte i = 0; i < sizeof(eventdayObject)/sizeof(EventdayObject); i++) {
+                byte countdownDay = pgm_read_byte_near(&eventdayObject[i].countdownDay);
+                byte countdownMonth = pgm_read_byte_near(&eventdayObject[i].countdownMonth);
+                if (countdownDay && countdownMonth) {
+                    TimeStamp TSTemp( pgm_read_byte_near(&eventdayObject[i].countdownMinute),
+                                      pgm_read_byte_near(&eventdayObject[i].countdownHour),
+                                      countdownDay,
+                                      0,
+                                      countdownMonth,
+                                      rtc.getYear());
+                    unsigned long target = TSTemp.getMinutesOfCentury();
+                    if (target < now) {
+                        // Schon vorbei, also im naechsten Jahr (Silvester / Neujahr)
+                        TSTemp.incYear(1, true);
+                        target = TSTemp.getMinutesOfCentury();
+                    }
+                    addCountdownCandidate(target, pgm_read_byte_near(&eventdayObject[i].countdownMinutes), pgm_read_byte_near(&eventdayObject[i].symbol));
+                }
+            }
+            // Bewegliche Ereignisse nur im laufenden Jahr
+            for (byte i = 0; i < sizeof(eventRules) / sizeof(EventRule); i++) {
+                byte countdownMinutes = pgm_read_byte_near(&eventRules[i].countdownMinutes);
+                if (countdownMinutes) {
+                    TimeStamp TSTemp( pgm_read_byte_near(&eventRules[i].countdownMinute),
+                                      pgm_read_byte_near(&eventRules[i].countdownHour),
+                                      eventRuleDates[i][0],
+                                      0,
+                                      eventRuleDates[i][1],
+                                      eventRuleYear);
+                    unsigned long target = TSTemp.getMinutesOfCentury();
+                    if (target >= now) {
+                        addCountdownCandidate(target, countdownMinutes, pgm_read_byte_near(&eventRules[i].symbol));
+                    }
+                }
+            }
+        #endif
+    }
+#endif
+
 /* 
  *  Es wird geprüft, ob aktuell ein Countdown geplant ist
  *  und dieser berechnet.
@@ -745,31 +1092,12 @@ static void updateJumpToTime() {
     void CheckCountdown() {
         countdown = -1;
         eventdaySymbol = -1;
-        for (byte i = 0; i < sizeof(eventdayObject)/sizeof(EventdayObject); i++) {
-            byte countdownDay = pgm_read_byte_near(&eventdayObject[i].countdownDay);
-            byte countdownMonth = pgm_read_byte_near(&eventdayObject[i].countdownMonth);
-            if (countdownDay && countdownMonth) {
-                TimeStamp TSTemp( pgm_read_byte_near(&eventdayObject[i].countdownMinute),
-                                  pgm_read_byte_near(&eventdayObject[i].countdownHour),
-                                  countdownDay,
-                                  0,
-                                  countdownMonth,
-                                  rtc.getYear());
-                long diff_0 = TSTemp.getMinutesOfCentury() - rtc.getMinutesOfCentury();
-                long diff_1;
-                byte countdownMinutes = pgm_read_byte_near(&eventdayObject[i].countdownMinutes);
-                if ( (diff_0 >= 0) && (diff_0 <= countdownMinutes) ) {
-                    diff_1 = diff_0;
-                } else {
-                    // Nur für Silvester / Neujahr (Jahreswechsel) erforderlich
-                    TSTemp.incYear(1, true);
-                    diff_1 = TSTemp.getMinutesOfCentury() - rtc.getMinutesOfCentury();
-                }
-                if ( (diff_1 >= 0) && (diff_1 <= countdownMinutes) ) {
-                    countdown = diff_1 * 60 - rtc.getSeconds();
-                    eventdaySymbol = i;
-                    break;
-                }
+        updateEventCache();
+        if (countdownSymbol != -1) {
+            unsigned long now = rtc.getMinutesOfCentury();
+            if (now >= countdownStart) {
+                countdown = (countdownTarget - now) * 60 - rtc.getSeconds();
+                eventdaySymbol = countdownSymbol;
             }
         }
     }
@@ -805,6 +1133,16 @@ void updateFromRtc() {
     if (helperSeconds >= 60) {
         helperSeconds = 0;
     }
+    #ifdef TRACE_ENABLE
+        // Nur einen zu fruehen oder zu spaeten (fehlenden) Takt festhalten, sonst waere der Puffer nach Sekunden voll.
+        static unsigned long lastSqwMillis = 0;
+        unsigned long now = millis();
+        unsigned long interval = now - lastSqwMillis;
+        if (lastSqwMillis && ((interval < 1000 - TRACE_SQW_TOLERANCE) || (interval > 1000 + TRACE_SQW_TOLERANCE))) {
+            TRACE(TRACE_SQW, (interval > 2550) ? 255 : interval / 10);
+        }
+        lastSqwMillis = now;
+    #endif
 }
 
 /**
@@ -822,10 +1160,15 @@ int freeRam() {
  * Arduino Strom bekommt.
  */
 void setup() {
+    #ifdef TRACE_ENABLE
+        eventTrace.begin(traceResetCause);
+    #endif
     Serial.begin(SERIAL_SPEED);
-    Serial.println(F("Qlockthree is initializing..."));
-    DEBUG_PRINTLN(F("... and starting in debug-mode..."));
-    Serial.flush();
+    #ifndef FAST_BOOT
+        Serial.println(F("Qlockthree is initializing..."));
+        DEBUG_PRINTLN(F("... and starting in debug-mode..."));
+        Serial.flush();
+    #endif
 
     pinMode(PIN_DCF77_PON, OUTPUT);
     #ifdef DCF77_SENSOR_EXISTS
@@ -852,22 +1195,35 @@ void setup() {
         alarm->speakerPin(PIN_SPEAKER);
     #endif
 
+    // Tasten anmelden (per Pin-Change-Interrupt)
+    boolean buttonsOk = buttonEvents.addButton(BUTTON_MODE, PIN_MODE, BUTTONS_PRESSING_AGAINST);
+    buttonsOk &= buttonEvents.addButton(BUTTON_M_PLUS, PIN_M_PLUS, BUTTONS_PRESSING_AGAINST);
+    buttonsOk &= buttonEvents.addButton(BUTTON_H_PLUS, PIN_H_PLUS, BUTTONS_PRESSING_AGAINST);
+    buttonEvents.addCombination(BUTTON_EXT_MODE, BUTTON_M_PLUS, BUTTON_H_PLUS);
+    #ifdef WW_5_BUTTONS
+        buttonsOk &= buttonEvents.addButton(BUTTON_ALARM, PIN_ALARM, BUTTONS_PRESSING_AGAINST);
+    #endif
+    if (!buttonsOk) {
+        Serial.println(F("Buttons: no pin change interrupt (see PCINT_PORTS)."));
+    }
+    #ifdef FAST_BOOT
+        // Die Diagnose gibt es nur, wenn beim Einschalten die Mode-Taste gedrueckt ist.
+        bootDiagnostics = (digitalRead(PIN_MODE) == BUTTONS_PRESSING_AGAINST);
+    #endif
+
     // DCF77-LED drei Mal als 'Hello' blinken lassen
     // und Speaker piepsen kassen, falls ENABLE_ALARM eingeschaltet ist.
     #ifdef DCF77_SENSOR_EXISTS
-        for (byte i = 0; i < 3; i++) {
-            dcf77.statusLed(true);
-            delay(100);
-            dcf77.statusLed(false);
-            delay(100);
+        if (bootDiagnostics) {
+            for (byte i = 0; i < 3; i++) {
+                dcf77.statusLed(true);
+                delay(100);
+                dcf77.statusLed(false);
+                delay(100);
+            }
         }
     #endif
 
-    Serial.print(F("Compiled: "));
-    Serial.print(F(__TIME__));
-    Serial.print(F(" / "));
-    Serial.println(F(__DATE__));
-
     /*
     // Uhrzeit nach Compile-Zeit stellen...
     rtc.set(__DATE__, __TIME__);
@@ -884,10 +1240,8 @@ void setup() {
     }
 
 #ifdef DS1307
-    Serial.println(F("Uhrentyp ist DS1307."));
     rtc.enableSQWOnDS1307();
 #elif defined DS3231
-    Serial.println(F("Uhrentyp ist DS3231."));
     rtc.enableSQWOnDS3231();
 #else
     Definition_des_Uhrtyps_fehlt!
@@ -896,18 +1250,9 @@ void setup() {
 
     rtc.writeTime();
     helperSeconds = rtc.getSeconds();
-    Serial.print(F("RTC-Time: "));
-    Serial.print(rtc.getHours());
-    Serial.print(F(":"));
-    Serial.print(rtc.getMinutes());
-    Serial.print(F(":"));
-    Serial.print(rtc.getSeconds());
-    Serial.print(F(" RTC-Date: "));
-    Serial.print(rtc.getDate());
-    Serial.print(F("."));
-    Serial.print(rtc.getMonth());
-    Serial.print(F("."));
-    Serial.println(rtc.getYear());
+    #ifdef RTC_NVRAM_HOT_VALUES
+        loadHotValues();
+    #endif
 
     // Den Interrupt konfigurieren,
     // nicht mehr CHANGE, das sind 2 pro Sekunde,
@@ -916,21 +1261,77 @@ void setup() {
     // den Sekundenwechsel, Danke an Peter.
     attachInterrupt(0, updateFromRtc, FALLING);
 
-    // Werte vom LDR einlesen und vermuellen, da die ersten nichts taugen...
-    for (int i = 0; i < 1000; i++) {
-        analogRead(PIN_LDR);
-    }
+    // Analoge Eingaenge (LDR, Naeherungssensor) im Hintergrund lesen lassen.
+    // Der LDR hat sich in seinem Konstruktor schon angemeldet.
+    #if defined(WW_5_BUTTONS) && defined(WW_5_BUTTONS_NEAR_SENSOR_ENABLE)
+        analogSampler.addChannel(PIN_NEAR_SENSOR, NEAR_SENSOR_FILTER_SHIFT);
+    #endif
+    analogSampler.begin();
 
     // rtcSQWLed-LED drei Mal als 'Hello' blinken lassen
     // und Speaker piepsen kassen, falls ENABLE_ALARM eingeschaltet ist.
-    for (byte i = 0; i < 3; i++) {
-        rtc.statusLed(true);
-        delay(100);
-        rtc.statusLed(false);
-        delay(100);
+    if (bootDiagnostics) {
+        for (byte i = 0; i < 3; i++) {
+            rtc.statusLed(true);
+            delay(100);
+            rtc.statusLed(false);
+            delay(100);
+        }
+    }
+
+#ifndef REMOTE_NO_REMOTE
+    if (!irrecv.enableIRIn()) {
+        Serial.println(F("Remote: no pin change interrupt (see PCINT_PORTS)."));
+    }
+#endif
+
+    // DCF77-Empfaenger einschalten...
+    #ifdef DCF77_SENSOR_EXISTS
+        dcf77.enable(true);
+    #endif
+    #if defined(GPS_ENABLE) && defined(GPS_PPS_PIN)
+        if (!gps.enablePps(GPS_PPS_PIN)) {
+            Serial.println(F("GPS: no pin change interrupt for PPS (see PCINT_PORTS)."));
+        }
+    #endif
+    // Display einschalten...
+    ledDriver.wakeUp();
+    brightnessController.begin(settings.getBrightness());
+    taskScheduler.begin();
+
+    // Mit FAST_BOOT kommen die Infos erst nach dem ersten Bild (loop()).
+    if (bootDiagnostics) {
+        printBootInfo();
     }
+}
+
+/**
+ * Ein paar Infos ueber Serial ausgeben.
+ */
+void printBootInfo() {
+    Serial.print(F("Compiled: "));
+    Serial.print(F(__TIME__));
+    Serial.print(F(" / "));
+    Serial.println(F(__DATE__));
+
+#ifdef DS1307
+    Serial.println(F("Uhrentyp ist DS1307."));
+#elif defined DS3231
+    Serial.println(F("Uhrentyp ist DS3231."));
+#endif
+    Serial.print(F("RTC-Time: "));
+    Serial.print(rtc.getHours());
+    Serial.print(F(":"));
+    Serial.print(rtc.getMinutes());
+    Serial.print(F(":"));
+    Serial.print(rtc.getSeconds());
+    Serial.print(F(" RTC-Date: "));
+    Serial.print(rtc.getDate());
+    Serial.print(F("."));
+    Serial.print(rtc.getMonth());
+    Serial.print(F("."));
+    Serial.println(rtc.getYear());
 
-    // ein paar Infos ausgeben
     Serial.println(F("... done and ready to rock!"));
 
     Serial.print(F("Version: "));
@@ -942,7 +1343,6 @@ void setup() {
 #ifndef REMOTE_NO_REMOTE
     Serial.print(F("Remote: "));
     irTranslator.printSignature();
-    irrecv.enableIRIn();
 #else
     Serial.println(F("Remote: disabled."));
 #endif
@@ -959,29 +1359,31 @@ void setup() {
     if (settings.getDcfSignalIsInverted()) {
         Serial.println(F("DCF77-Signal is inverted."));
     }
+    #ifdef GPS_ENABLE
+        Serial.println(F("GPS is enabled."));
+    #endif
 
     Serial.print(F("Free ram: "));
     Serial.print(freeRam());
     Serial.println(F(" bytes."));
 
     Serial.flush();
+}
 
-    // DCF77-Empfaenger einschalten...
-    #ifdef DCF77_SENSOR_EXISTS
-        dcf77.enable(true);
-    #endif
-    // Display einschalten...
-    ledDriver.wakeUp();
-    ledDriver.setBrightness(settings.getBrightness());
+/**
+ * Die Zeit bis zum ersten Bild ueber Serial ausgeben (nach dem ersten Bild).
+ */
+void printBootTime() {
+    Serial.print(F("Boot: "));
+    Serial.print(bootMillis);
+    Serial.println(F(" ms to the first frame."));
 }
 
 /*
  * Schreibroutinen für Buchstaben und Zahlen
  */
 void write1xyStab(char char1, byte posx, byte posy) {
-    for (byte i = 0; i < 5; i++) {
-        matrix[posy + i] |= pgm_read_byte_near(&(staben[char1 - 'A'][i])) << posx;
-    }
+    textRenderer.drawStab(char1, 11 - posx, posy, matrix);
 }
 
 void write2yStaben(char char1, char char2, byte posy) {
@@ -999,9 +1401,7 @@ void write4Staben(char char1, char char2, char char3, char char4) {
 }
 
 void write1xyDigit(byte number, byte posx, byte posy) {
-    for (byte i = 0; i < 7; i++) {
-        matrix[posy + i] |= pgm_read_byte_near(&(ziffern[number][i])) << posx;
-    }
+    textRenderer.drawDigit(number, 11 - posx, posy, matrix);
 }
 
 void write2yDigits(byte number, byte posy) {
@@ -1010,10 +1410,8 @@ void write2yDigits(byte number, byte posy) {
 }
 
 void write2ySmallDigits(byte number, byte posy) {
-    for (byte i = 0; i < 5; i++) {            
-        matrix[posy + i] |= pgm_read_byte_near(&(ziffernKlein[number / 10][i])) << 12;
-        matrix[posy + i] |= pgm_read_byte_near(&(ziffernKlein[number % 10][i])) << 7;
-    }
+    textRenderer.drawSmallDigit(number / 10, 0, posy, matrix);
+    textRenderer.drawSmallDigit(number % 10, 5, posy, matrix);
 }
 
 void write4SmallDigits(byte firstNumber, byte secondNumber) {
@@ -1029,8 +1427,24 @@ void write4SmallDigits(byte firstNumber, byte secondNumber) {
             } else
         #endif
             {
-                for (byte i = 0; i < 10; i++) { 
-                    matrix[i] |= pgm_read_word_near(&(eventdayObject[(byte) eventdaySymbol].symbol[i])) << 5;
+                // Die Zeilen sind zu je 11 Bit gepackt (siehe EVENT_SYMBOL() in der Ereignisse.h)
+                const byte* symbol = eventSymbols[(byte) eventdaySymbol];
+                byte bits = 0;
+                byte bitsLeft = 0;
+                for (byte i = 0; i < 10; i++) {
+                    word row = 0;
+                    for (byte j = 0; j < 11; j++) {
+                        if (!bitsLeft) {
+                            bits = pgm_read_byte_near(symbol++);
+                            bitsLeft = 8;
+                        }
+                        if (bits & 1) {
+                            row |= 1 << j;
+                        }
+                        bits >>= 1;
+                        bitsLeft--;
+                    }
+                    matrix[i] |= row << 5;
                 }
             }
     }
@@ -1041,7 +1455,9 @@ void write4SmallDigits(byte firstNumber, byte secondNumber) {
  * loop() wird endlos auf alle Ewigkeit vom Microcontroller durchlaufen
  */
 void loop() {
-    static boolean _isAlarmLedOn = false;
+    static byte _renderedMode = EXT_MODE_COUNT;
+    static boolean _renderAgain = false;
+    boolean renderDue = false;
     
     /*
      * FPS
@@ -1055,28 +1471,20 @@ void loop() {
         frames = 0;
     }
 #endif
+    PROFILE_BEGIN();
 
     /*
-     * Dimmung.
+     * Die faelligen periodischen Aufgaben (Dimmung, Alarm-LED, DCF77-Takt).
      */
-    if (settings.getUseLdr()) {
-        if (millis() - lastBrightnessCheck > LDR_CHECK_RATE) { // langsam nachsehen...
-            byte lv = ldr.value();
-            byte currentBrightness = ledDriver.getBrightness();
-            if (currentBrightness > lv) {
-                ledDriver.setBrightness(settings.changeBrightness(-1));
-            } else if (currentBrightness < lv) {
-                ledDriver.setBrightness(settings.changeBrightness(1));
-            }
-            lastBrightnessCheck = millis();
-        }
-    }
+    taskScheduler.poll();
+    PROFILE_MARK(PROFILER_STAGE_LDR);
 
     /*
      * Der optische Naeherungssensor
      */
     #if defined(WW_5_BUTTONS) && defined(WW_5_BUTTONS_NEAR_SENSOR_ENABLE)
         CheckNearSensorIn_Blank_Night();    
+        PROFILE_MARK(PROFILER_STAGE_NEAR);
     #endif
 
     /*
@@ -1086,6 +1494,7 @@ void loop() {
      */
     if (needsUpdateFromRtc) {
         needsUpdateFromRtc = false;
+        boolean newMinute = (helperSeconds == 0);
 
         /*
          * Zeit einlesen...
@@ -1094,6 +1503,21 @@ void loop() {
             default:
                 if (helperSeconds == 0) {
                     rtc.readTime();
+                    {
+                        Schedule* schedule = settings.getSchedule();
+                        byte revision = schedule->getRevision();
+                        scheduleDue |= schedule->poll(rtc.getMinutesOfWeek());
+                        if (schedule->getRevision() != revision) {
+                            // Einmalige Eintraege hat poll() abgeschaltet, das muss einen Neustart ueberleben.
+                            settings.saveToEEPROM();
+                        }
+                    }
+                    #ifdef RTC_NVRAM_HOT_VALUES
+                        saveHotValues();
+                    #endif
+                    #if defined(DCF77_SENSOR_EXISTS) || defined(GPS_ENABLE)
+                        pollTimeArbiter();
+                    #endif
                 }
                 break;
 //            case STD_MODE_SECONDS:
@@ -1135,11 +1559,7 @@ void loop() {
          * Diese verbessert den DCF77-Empfang bzw. ermoeglicht ein dunkles Schlafzimmer.
          */
         // Vorbedingung: Nur bei Erfüllung dieser Bedinung soll Nachtschaltung erfolgen
-        if ( (!nightLock) && (mode < EXT_MODE_START) && (mode != STD_MODE_BRIGHTNESS)
-            #ifdef WW_5_BUTTONS 
-                && (mode != STD_MODE_ALLON) 
-            #endif 
-        ) {
+        if ( (!nightLock) && (getModeFlags(mode) & MODE_FLAG_NIGHT_ALLOWED) ) {
             // Wenn im BLANK-Modus, in diesem bleiben
             if (mode != STD_MODE_BLANK) {
                 // Display LDR-gesteuert ein- und abschalten
@@ -1185,421 +1605,166 @@ void loop() {
             if (checkNight())
                 nightByTimeLock = 0;
 
-        DEBUG_PRINT(F("Mode | nightByTimeLock | nightLock: "));
-        DEBUG_PRINT(mode);
-        DEBUG_PRINT(F(" | "));
-        DEBUG_PRINT(nightByTimeLock);
-        DEBUG_PRINT(F(" | "));
-        DEBUG_PRINTLN(nightLock);
-        DEBUG_FLUSH();
-        DEBUG_PRINTLN(rtc.asString());
+        LOG3(LOG_MODE, mode, nightByTimeLock, nightLock);
+        #ifdef DEBUG
+            logTimeStamp(LOG_TIME, &rtc);
+        #endif
 
         /*
-         * Variablendeklaration (temporär)
+         * Aendert sich die Anzeige des Modus von selbst? Nach einem Tastendruck
+         * wird beim naechsten Mal noch einmal geschrieben, weil der Treiber
+         * waehrend des Ueberblendens keine neue Matrix uebernimmt.
          */
-        unsigned long ul_min;
-        byte alarm_hours;
-        byte rtc_minutes = rtc.getMinutes();
-        byte rtc_date = rtc.getDate();
-        byte rtc_month = rtc.getMonth();
-        byte b_language = settings.getLanguage();
-        byte b_brightnessToDisplay; // Für die Anzeige der Helligkeit mit Balken
-        char c_TimeShift = settings.getTimeShift();
-        char c_abs_TimeShift = abs(c_TimeShift);
-        boolean bool_esIst = settings.getEsIst();
-        boolean bool_corner = settings.getRenderCornersCw();
-        TimeStamp* t_TimeStamp;
+        switch (pgm_read_byte_near(&modeTable[mode].refresh)) {
+            case MODE_REFRESH_SECOND:
+                renderDue = true;
+                break;
+            case MODE_REFRESH_MINUTE:
+                renderDue = newMinute;
+                break;
+        }
+        if (_renderAgain) {
+            renderDue = true;
+            _renderAgain = false;
+        }
+        PROFILE_MARK(PROFILER_STAGE_RTC);
+    }
+
+    /*
+     * Bildschirmpuffer beschreiben, aber nur, wenn sich etwas geaendert hat...
+     */
+    if (renderDue || needsRender || (mode != _renderedMode)) {
+        _renderAgain = needsRender || (mode != _renderedMode);
+        needsRender = false;
+        if (mode != _renderedMode) {
+            // Ein durchlaufender Text gehoert zum alten Modus
+            textRenderer.stopScroll();
+            TRACE(TRACE_MODE, mode);
+        }
+        _renderedMode = mode;
 
-        /*
-         * Bildschirmpuffer beschreiben...
-         */
         renderer.clearScreenBuffer(matrix);
         renderer.setAfternoon(0);
-        switch (mode) {
-            case EXT_MODE_TIMESET:
-                renderer.setAfternoon(rtc.getHours());
-            case STD_MODE_NORMAL:
-                renderer.setMinutes(rtc.getHours(), rtc_minutes, b_language, matrix);
-                renderer.setCorners(rtc_minutes, bool_corner, matrix);
-                if (!bool_esIst && ((rtc_minutes / 5) % 6)) {
-                    renderer.cleanIntroWords(b_language, matrix); // ES IST weg
-                }
-                break;
-            case EXT_MODE_TIME_SHIFT:
-                if (c_TimeShift < 0) {
-                    for (byte x = 0; x < 3; x++) {
-                        ledDriver.setPixelInScreenBuffer(x, 1, matrix);
-                    }
-                } else if (c_TimeShift > 0) {
-                    for (byte x = 0; x < 3; x++) {
-                        ledDriver.setPixelInScreenBuffer(x, 1, matrix);
-                    }
-                    for (byte y = 0; y < 3; y++) {
-                        ledDriver.setPixelInScreenBuffer(1, y, matrix);
-                    }
-                }
-                write1xyDigit(c_abs_TimeShift % 10, 5, 3);
-                if (c_abs_TimeShift > 9) {
-                    write1xyDigit(1, 10, 3);
+        ModeFunction render = (ModeFunction)pgm_read_ptr_near(&modeTable[mode].render);
+        if (render) {
+            render();
+        }
+
+        // Leert die Anzeige, wenn eine Zeit >= 12 Uhr mittags angezeigt wird und der Takt dies erfordert.
+        renderer.clearScreenIfNeeded_DisplayOnBlinking(matrix);
+
+        // Schaltet die Alarm-LED ein (blinkend oder dauerhaft)
+        #ifdef ALARM_OPTION_ENABLE
+            if (isAlarmLedOn)
+                renderer.activateAlarmLed(matrix);
+        #endif
+        PROFILE_MARK(PROFILER_STAGE_RENDER);
+
+        // Update mit onChange = true, weil sich hier immer was geaendert hat.
+        ledDriver.writeScreenBufferToMatrix(matrix, true);
+        PROFILE_MARK(PROFILER_STAGE_DRIVER);
+
+        // Das erste Bild: Startzeit merken und ausgeben, mit FAST_BOOT jetzt erst die Infos.
+        if (!bootMillis) {
+            bootMillis = millis();
+            #ifdef FAST_BOOT
+                if (!bootDiagnostics) {
+                    printBootInfo();
                 }
-                break;
-            #ifdef ALARM_OPTION_ENABLE
-                case STD_MODE_ALARM:
-                   if ((alarm->getShowAlarmTimer() == 0) || alarm->isEnable()) {
-                        alarm->toggleEnable();
-                        settings.saveToEEPROM();
-                        goToNormalDispOn();
-                    } else {
-                        alarm_hours = alarm->getHours();
-                        if (settings.get24hMode())
-                           renderer.setAfternoon(alarm_hours);
-                        renderer.setMinutes(alarm_hours, alarm->getMinutes(), b_language, matrix);
-                        renderer.setCorners(alarm->getMinutes(), bool_corner, matrix);
-                        renderer.cleanIntroWords(b_language, matrix); // ES IST weg  
-                    }
-                    break;
-            #endif
-            #ifdef DATE_ENABLE
-                case STD_MODE_DATE:
-                    #ifdef EVENTDAY
-                        /**
-                         * Es wird geprüft, ob der heutige Tag ein Ereignis ist und das entsprechend
-                         * definierte Symbol dazu auf der Datumsanzeige ausgegeben.
-                         * Ereignisse werden in der Ereignisse.h definiert.
-                         */  
-                        eventdaySymbol = -1;
-                        for (byte i = 0; i < sizeof(eventdayObject)/sizeof(EventdayObject); i++) {
-                            if ( (pgm_read_byte_near(&eventdayObject[i].day) == rtc_date) && (pgm_read_byte_near(&eventdayObject[i].month) == rtc_month) ) {
-                                eventdaySymbol = i;
-                                break;
-                            }
-                        }      
-                        if (eventdaySymbol != -1) {
-                            // Anzeige des Geburtstagssymbols
-                            writeEventSymbol();
-                        } else
-                    #endif
-                    {
-                        // Anzeige des Datums
-                        #ifdef DATE_MONTH_SHOW
-                            write4SmallDigits(rtc_date, rtc_month);
-                            ledDriver.setPixelInScreenBuffer(10, 4, matrix);
-                            ledDriver.setPixelInScreenBuffer(10, 9, matrix);
-                        #else
-                            write2yDigits(rtc_date, 1);
-                        #endif
-                    }
-                    break;
-            #endif
-            #ifdef COUNTDOWN
-                case STD_MODE_COUNTDOWN:
-                    /**
-                     * Dieser Modus zeigt den Countdown zu einem Ereignis an.
-                     * Ereignisse werden in Ereignisse.h definiert.
-                     */ 
-                    if (countdown >= 60) {
-                        // Anzeige des Countdowns (Minuten und Sekunden)
-                        write4SmallDigits(countdown / 60 % 60, countdown % 60);
-                        ledDriver.setPixelInScreenBuffer(10, 1, matrix);
-                        ledDriver.setPixelInScreenBuffer(10, 3, matrix);
-                    } else if (countdown >= 0) {
-                        // Anzeige des Countdowns (nur Sekunden)
-                        write2yDigits(countdown, 1);
-                    } else if (countdown > -COUNTDOWN_BLINK_DURATION) {
-                        // Anzeige des Symbols blinkend im Sekundentakt
-                        if (countdown % 2) {
-                            writeEventSymbol();
-                        }
-                    } else {
-                        // Rücksprung auf Uhrzeit
-                        mode = STD_MODE_NORMAL;
-                    }
-                    break;
-            #endif
-            case EXT_MODE_MAIN_SETTINGS_START:
-                write4Staben('M', 'A', 'I', 'N');
-                break;
-            case EXT_MODE_TIME_SETTINGS_START:
-                write4Staben('T', 'I', 'M', 'E');
-                break;
-            case EXT_MODE_TEST_DEBUG_START:
-                write4Staben('T', 'E', 'S', 'T');
-                break;
-            case EXT_MODE_YEARSET:
-                    write2yStaben('Y', 'Y', 0);
-                    write2ySmallDigits(rtc.getYear(), 5);
-                    break;
-            case EXT_MODE_MONTHSET:
-                    write2yStaben('M', 'M', 0);
-                    write2ySmallDigits(rtc.getMonth(), 5);
-                    break;
-            case EXT_MODE_DATESET:
-                    write2yStaben('D', 'D', 0);
-                    write2ySmallDigits(rtc.getDate(), 5);
-                    break;
-            case EXT_MODE_OFFTIME_MOFR:
-            case EXT_MODE_OFFTIME_SASO:
-                ledDriver.setPixelInScreenBuffer(10, 7, matrix);
-            case EXT_MODE_ONTIME_MOFR:
-            case EXT_MODE_ONTIME_SASO:
-                t_TimeStamp = getNightTimeStamp(mode);
-                write4SmallDigits(t_TimeStamp->getHours(), t_TimeStamp->getMinutes());
-                ledDriver.setPixelInScreenBuffer(10, 1, matrix);
-                ledDriver.setPixelInScreenBuffer(10, 3, matrix);
-                break; 
-            case STD_MODE_SECONDS:
-                renderer.setCorners(rtc_minutes, bool_corner, matrix);
-                write2yDigits(helperSeconds, 1);
-                break;
-            case EXT_MODE_LDR_MODE:
-                if (settings.getUseLdr()) {
-                    write1xyStab('A', 8, 3);
-                } else {
-                    write1xyStab('M', 8, 3);
-                }
-                break;
-            case EXT_MODE_LDR_NIGHT_MODE:
-                if (settings.getBlankByLdr()) {
-                    write4Staben('L', 'N', 'E', 'N');
-                } else {
-                    write4Staben('L', 'N', 'D', 'A');
-                }
-                break;
-            case EXT_MODE_LDR_NIGHT_THRESH:
-                write2yDigits(settings.getLdrBlankThreshold(), 3);
-                break;
-            case STD_MODE_BLANK:
-            case STD_MODE_NIGHT:
-            case EXT_MODE_DCF_BLANK:
-                break;
-            #ifdef WW_5_BUTTONS
-                case STD_MODE_ALLON:
-                    renderer.setAllScreenBuffer(matrix);
-                    break;
-            #endif
-            case STD_MODE_BRIGHTNESS:
-                #ifdef BRIGHTNESS_SETTING_IN_PERCENTAGE
-                    write2yDigits(settings.getBrightness(), 1);
-                #else
-                    ledDriver.setPixelInScreenBuffer(0, 9, matrix);
-                    b_brightnessToDisplay = settings.getBrightness() / 10;
-                    for (byte xb = 0; xb < b_brightnessToDisplay; xb++) {
-                        for (byte yb = 0; yb <= xb; yb++) {
-                            matrix[9 - yb] |= 1 << (14 - xb);
-                        }
-                    }
-                #endif
-                break;
-            case EXT_MODE_CORNERS:
-                if (bool_corner) {
-                    write2Staben('C', 'W');
-                } else {
-                    write1xyStab('C', 8, 0);
-                    write2yStaben('C', 'W', 5);
-                }
-                break;
-            case EXT_MODE_ES_IST:
-                if (bool_esIst) {
-                    write4Staben('I', 'T', 'E', 'N');
-                } else {
-                    write4Staben('I', 'T', 'D', 'A');
-                }
-                break;
-            #ifdef ALARM_OPTION_ENABLE
-                case EXT_MODE_ALARM_MELODY:
-                    write1xyStab('A', 8, 0);
-                    write2ySmallDigits(alarm->getAlarmMelody(), 5);
-                    break;
-                case EXT_MODE_24:
-                    if (settings.get24hMode()) {
-                       write2ySmallDigits(24, 0);
-                    } else {
-                       write2ySmallDigits(12, 0);
-                    }
-                    write1xyStab('H', 4, 5);
-                    break;
-                case EXT_MODE_SNOOZE:
-                    write2yStaben('S', 'N', 0);
-                    write2ySmallDigits(settings.getSnooze(), 5);
-                    break;
-             #endif
-            case EXT_MODE_DCF_IS_INVERTED:
-                if (settings.getDcfSignalIsInverted()) {
-                    write4Staben('R', 'S', 'I', 'N');
-                } else {
-                    write4Staben('R', 'S', 'N', 'O');
-                }
-                break;
-            case EXT_MODE_LANGUAGE:
-                for (byte i = 0; i < 5; i++) {
-                    switch (b_language) {
-                        #ifdef SPRACHE_DE
-                            case LANGUAGE_DE_DE:
-                                write2Staben('D', 'E');
-                                break;
-                            case LANGUAGE_DE_SW:
-                                write4Staben('D', 'E', 'S', 'W');
-                                break;
-                            case LANGUAGE_DE_BA:
-                                write4Staben('D', 'E', 'B', 'A');
-                                break;
-                            case LANGUAGE_DE_SA:
-                                write4Staben('D', 'E', 'S', 'A');
-                                break;
-                        #endif
-                        #ifdef SPRACHE_CH
-                            case LANGUAGE_CH:
-                                write2Staben('C', 'H');
-                                break;
-                        #endif
-                        #ifdef SPRACHE_EN
-                            case LANGUAGE_EN:
-                                write2Staben('E', 'N');
-                                break;
-                        #endif
-                        #ifdef SPRACHE_FR
-                            case LANGUAGE_FR:
-                                write2Staben('F', 'R');
-                                break;
-                        #endif
-                        #ifdef SPRACHE_IT
-                            case LANGUAGE_IT:
-                                write2Staben('I', 'T');
-                                break;
-                        #endif
-                        #ifdef SPRACHE_NL
-                            case LANGUAGE_NL:
-                                write2Staben('N', 'L');
-                                break;
-                        #endif
-                        #ifdef SPRACHE_ES
-                            case LANGUAGE_ES:
-                                write2Staben('E', 'S');
-                                break;
-                        #endif
-                        #ifdef SPRACHE_PT
-                            case LANGUAGE_PT:
-                                write2Staben('P', 'T');
-                                break;
-                        #endif
-                    }
-                }
-                break;
- 
-            case EXT_MODE_TEST:
-                renderer.setCorners(helperSeconds % 5, bool_corner, matrix);
-                renderer.activateAlarmLed(matrix);
-                for (byte i = 0; i < 11; i++) {
-                    ledDriver.setPixelInScreenBuffer(x, i, matrix);
-                }
-                x++;
-                if (x > 10) {
-                    x = 0;
-                }
-                break;
-            #ifdef DCF77_SENSOR_EXISTS
-                case EXT_MODE_DCF_SYNC:
-                    // Anzeige des letzten erfolgreichen DCF77-Syncs (samplesOK) in Stunden : Minuten
-                    ul_min = rtc.getMinutesOfCentury() - dcf77.getDcf77LastSuccessSyncMinutes();
-                    if (ul_min > 5999)
-                        ul_min = 5999;
-                    write4SmallDigits(ul_min / 60, ul_min % 60);
-                    ledDriver.setPixelInScreenBuffer(10, 1, matrix);
-                    ledDriver.setPixelInScreenBuffer(10, 3, matrix);
-                break;
-                case EXT_MODE_DCF_DEBUG:
-                    needsUpdateFromRtc = true;
-                    renderer.setCorners(dcf77.getDcf77ErrorCorner(), bool_corner, matrix);
-                    break;
             #endif
+            printBootTime();
         }
-
-        // Leert die Anzeige, wenn eine Zeit >= 12 Uhr mittags angezeigt wird und der Takt dies erfordert.
-        renderer.clearScreenIfNeeded_DisplayOnBlinking(matrix);
-
-        // Schaltet die Alarm-LED ein (blinkend oder dauerhaft)
-        if (_isAlarmLedOn)
-            renderer.activateAlarmLed(matrix);
-
-        // Update mit onChange = true, weil sich hier (aufgrund needsUpdateFromRtc) immer was geaendert hat.
-        // Entweder weil wir eine Sekunde weiter sind, oder weil eine Taste gedrueckt wurde.
-        ledDriver.writeScreenBufferToMatrix(matrix, true);
     }
 
     /* 
      * Display blinken lassen bei Zeitanzeige >= 12 Uhr (Nachmittag)
      */
     if (renderer.pollDisplayBlinkAfternoon())
-           needsUpdateFromRtc = true;
+           needsRender = true;
+
+    /*
+     * Durchlaufenden Text eine Spalte weiter schieben
+     */
+    if (textRenderer.pollScroll())
+        needsRender = true;
+    PROFILE_SKIP();
        
     /*
      * Tasten abfragen (Code mit 3.3.0 ausgelagert, wegen der Fernbedienung)
      */
-    // Taste Minuten++ und Stunden++ (brightness) gedrueckt?
-    if (extModeDoubleButton.pressed())
-        extModeDoublePressed();  
-
-#ifdef WW_5_BUTTONS
-    // Taste Alarm gedrueckt?
-    if (alarmButton.pressed())
-        alarmPressed();
-#endif
-    
-    // Taste Minuten++ (brighness++) gedrueckt?
-    if (minutesPlusButton.pressed())
-        minutePlusPressed();
-
-    // Taste Stunden++ (brightness--) gedrueckt?
-    if (hoursPlusButton.pressed())
-        hourPlusPressed();
-
-    // Taste Moduswechsel gedrueckt?
-    if (modeChangeButton.pressed())
-        modePressed();
-
     /*
-     * Tasten der Fernbedienung abfragen...
+     * Tasten der Fernbedienung abfragen und in die Warteschlange der Tasten legen...
      */
 #ifndef REMOTE_NO_REMOTE
     if (irrecv.decode(&irDecodeResults)) {
         DEBUG_PRINT(F("Decoded successfully as "));
         DEBUG_PRINTLN2(irDecodeResults.value, HEX);
         needsUpdateFromRtc = true;
-        switch (irTranslator.buttonForCode(irDecodeResults.value)) {
-            case REMOTE_BUTTON_MODE:
-                modePressed();
+        needsRender = true;
+        #ifdef IR_LEARN_ENABLE
+            if (mode == EXT_MODE_IR_LEARN) {
+                // Im Lernmodus wird jeder Code (ausser Wiederholungen) der gewaehlten Taste zugeordnet
+                // und die naechste Taste angeboten.
+                if (irDecodeResults.value != REPEAT) {
+                    irTranslator.learnCode(irDecodeResults.value, irLearnButton);
+                    if (irLearnButton != REMOTE_BUTTON_UNDEFINED) {
+                        irLearnButton++;
+                        if (irLearnButton >= REMOTE_BUTTON_SETCOLOR) {
+                            irLearnButton = REMOTE_BUTTON_MODE;
+                        }
+                    }
+                }
+            } else
+        #endif
+        buttonEvents.push(irTranslator.buttonForCode(irDecodeResults.value), BUTTON_EVENT_REMOTE);
+        irrecv.resume();
+        PROFILE_MARK(PROFILER_STAGE_IR);
+    }
+#endif
+
+    /*
+     * Die Ereignisse der Tasten abarbeiten. Halten einer Taste wiederholt sie.
+     */
+    ButtonEvent buttonEvent;
+    while (buttonEvents.read(&buttonEvent)) {
+        TRACE(TRACE_BUTTON, (buttonEvent.button & 0x0F) | (buttonEvent.type << 4));
+        if ((buttonEvent.type != BUTTON_EVENT_PRESS) && (buttonEvent.type != BUTTON_EVENT_REPEAT) && (buttonEvent.type != BUTTON_EVENT_REMOTE)) {
+            continue;
+        }
+        needsUpdateFromRtc = true;
+        needsRender = true;
+        if (buttonEvent.type == BUTTON_EVENT_REMOTE) {
+            #ifndef REMOTE_NO_REMOTE
+                remoteButtonPressed(buttonEvent.button);
+            #endif
+            continue;
+        }
+        switch (buttonEvent.button) {
+            // Taste Minuten++ und Stunden++ (brightness) gedrueckt?
+            case BUTTON_EXT_MODE:
+                extModeDoublePressed();
                 break;
-            case REMOTE_BUTTON_MINUTE_PLUS:
+#ifdef WW_5_BUTTONS
+            // Taste Alarm gedrueckt?
+            case BUTTON_ALARM:
+                alarmPressed();
+                break;
+#endif
+            // Taste Minuten++ (brighness++) gedrueckt?
+            case BUTTON_M_PLUS:
                 minutePlusPressed();
                 break;
-            case REMOTE_BUTTON_HOUR_PLUS:
+            // Taste Stunden++ (brightness--) gedrueckt?
+            case BUTTON_H_PLUS:
                 hourPlusPressed();
                 break;
-            case REMOTE_BUTTON_BRIGHTER:
-                setDisplayBrighter();
-                break;
-            case REMOTE_BUTTON_DARKER:
-                setDisplayDarker();
-                break;
-            case REMOTE_BUTTON_EXTMODE:
-                extModeDoublePressed_EnterExtMode();
-                break;
-            case REMOTE_BUTTON_TOGGLEBLANK:
-                toggleDisplay();
-                break;
-            case REMOTE_BUTTON_BLANK:
-                goTo_leaveFrom_Blank(true);
-                break;
-            case REMOTE_BUTTON_RESUME:
-                goTo_leaveFrom_Blank(false);
-                break;
-            case REMOTE_BUTTON_SETCOLOR:
-                ledDriver.setColor(irTranslator.getRed(), irTranslator.getGreen(), irTranslator.getBlue());
+            // Taste Moduswechsel gedrueckt?
+            case BUTTON_MODE:
+                modePressed();
                 break;
         }
-        irrecv.resume();
     }
-#endif
+    PROFILE_MARK(PROFILER_STAGE_BUTTONS);
 
     /*
      * DCF77-Empfänger ein-/aus- und Näherungssensor aus-/einschalten via A0-Hack
@@ -1627,19 +1792,15 @@ void loop() {
      * Alarm?
      */ 
     #ifdef ALARM_OPTION_ENABLE
-        // Alarm-LED
-        if (_isAlarmLedOn != alarm->pollLed(mode == STD_MODE_ALARM)) {
-            _isAlarmLedOn = !_isAlarmLedOn;
-            needsUpdateFromRtc = true;
-        }
-        // Alarm
-        if ( (mode != STD_MODE_ALARM) && alarm->isEnable() ) { 
-           if (settings.get24hMode()) {
-               alarm->pollAlarm(rtc.getMinutesOfDay());
-           }
-           else {
-               alarm->pollAlarm(rtc.getMinutesOf12HoursDay());
+        // Alarm. Die Weckzeiten bleiben in scheduleDue, bis pollAlarm() sie gesehen hat.
+        if (mode != STD_MODE_ALARM) {
+           byte alarmDue = scheduleDue & settings.getSchedule()->getTypeMask(SCHEDULE_TYPE_ALARM);
+           // Die Weckzeit aus dem Menue nur, wenn der Wecker eingeschaltet ist.
+           if (!alarm->isEnable()) {
+               bitClear(alarmDue, SCHEDULE_ENTRY_ALARM);
            }
+           alarm->pollAlarm(alarmDue != 0, bitRead(alarmDue, SCHEDULE_ENTRY_ALARM));
+           scheduleDue = 0;
         }
         #if defined(WW_5_BUTTONS) && defined(WW_5_BUTTONS_NEAR_SENSOR_ENABLE)
             if (alarm->isActive() && (settings.getSnooze() != 0)) {
@@ -1649,7 +1810,11 @@ void loop() {
                 }
             }
         #endif 
+    #else
+        // Die Zeitplan-Ereignisse sind verarbeitet.
+        scheduleDue = 0;
     #endif
+    PROFILE_MARK(PROFILER_STAGE_ALARM);
 
     /*
      * Die Matrix auf die LEDs multiplexen, hier 'Refresh-Zyklen'.
@@ -1657,6 +1822,7 @@ void loop() {
     if (!isCurrentModeDarkMode()) {
         ledDriver.writeScreenBufferToMatrix(matrix, false);
     }
+    PROFILE_MARK(PROFILER_STAGE_REFRESH);
 
     /*
      * Status-LEDs ausgeben
@@ -1669,14 +1835,82 @@ void loop() {
 #endif
 
     /*
-     * DCF77-Empfaenger anticken...
+     * DCF77-Signal abtasten (ausgewertet wird in dcf77Task())...
      */
     #ifdef DCF77_SENSOR_EXISTS
-        if (dcf77.poll(settings.getDcfSignalIsInverted()))
-            manageNewDCF77Data();
+        dcf77.poll(settings.getDcfSignalIsInverted());
+        PROFILE_MARK(PROFILER_STAGE_DCF);
+    #endif
+
+    /*
+     * GPS: nur die schon empfangenen Zeichen abholen, einmal pro Minute kommt eine neue Zeit.
+     */
+    #ifdef GPS_ENABLE
+        if (gps.poll())
+            manageNewGPSData();
+    #endif
+
+    /*
+     * Kommandozeile: nur die schon empfangenen Zeichen abholen.
+     */
+    #ifdef SERIAL_CONSOLE
+        if (serialConsole.poll())
+            serialConsoleCommand();
+    #endif
+
+    /*
+     * Bei dunkler Anzeige gibt es bis zum naechsten Interrupt nichts zu tun.
+     */
+    #ifdef SLEEP_ENABLE
+        if (isCurrentModeDarkMode() && !needsUpdateFromRtc && !needsRender && !Serial.available()
+            && (taskScheduler.getNextDue() >= SLEEP_MIN_MICROS)) {
+            sleepScheduler.sleep();
+        }
     #endif
 }
 
+#ifndef REMOTE_NO_REMOTE
+/**
+ * Was soll ausgefuehrt werden, wenn eine Taste der Fernbedienung gedrueckt wird?
+ *
+ * @param button: die Taste (REMOTE_BUTTON_*)
+ */
+void remoteButtonPressed(byte button) {
+    switch (button) {
+        case REMOTE_BUTTON_MODE:
+            modePressed();
+            break;
+        case REMOTE_BUTTON_MINUTE_PLUS:
+            minutePlusPressed();
+            break;
+        case REMOTE_BUTTON_HOUR_PLUS:
+            hourPlusPressed();
+            break;
+        case REMOTE_BUTTON_BRIGHTER:
+            setDisplayBrighter();
+            break;
+        case REMOTE_BUTTON_DARKER:
+            setDisplayDarker();
+            break;
+        case REMOTE_BUTTON_EXTMODE:
+            extModeDoublePressed_EnterExtMode();
+            break;
+        case REMOTE_BUTTON_TOGGLEBLANK:
+            toggleDisplay();
+            break;
+        case REMOTE_BUTTON_BLANK:
+            goTo_leaveFrom_Blank(true);
+            break;
+        case REMOTE_BUTTON_RESUME:
+            goTo_leaveFrom_Blank(false);
+            break;
+        case REMOTE_BUTTON_SETCOLOR:
+            ledDriver.setColor(irTranslator.getRed(), irTranslator.getGreen(), irTranslator.getBlue());
+            break;
+    }
+}
+#endif
+
 /**
  * Was soll ausgefuehrt werden, wenn die H+ und M+ -Taste zusammen gedrueckt wird?
  */
@@ -1684,8 +1918,8 @@ void extModeDoublePressed() {
     // Bedingung erforderlich, um in der Weckzeiteinstellung und im Menü
     // Stunden und Minuten gleichzeitig einstellen zu können.
     if ((mode != STD_MODE_ALARM) && (mode < EXT_MODE_START)) {
-        minutesPlusButton.lock();
-        hoursPlusButton.lock();
+        buttonEvents.lock(BUTTON_M_PLUS);
+        buttonEvents.lock(BUTTON_H_PLUS);
     }
     if (CheckAlarmAndSnoozeOrDeactivate()) {
         DEBUG_PRINT(F("Minutes plus AND hours plus pressed in "));
@@ -1740,406 +1974,1272 @@ void extModeDoublePressed_EnterExtMode() {
 #endif
 
 /**
- * Was soll ausgefuehrt werden, wenn die Mode-Taste gedrueckt wird?
+ * Was soll ausgefuehrt werden, wenn die Mode-Taste gedrueckt wird?
+ */
+void modePressed() {
+    if (CheckAlarmAndSnoozeOrDeactivate()) {
+        // Da der aktuelle Modus eventuell durch Tastendruck geändert wird, Display wieder einschalten.
+        setDisplayToOn();
+
+        ModeEntry entry;
+        readModeEntry(mode, &entry);
+        if (entry.modeKey) {
+            entry.modeKey();
+        } else {
+            mode = entry.next;
+            settings.saveToEEPROM();
+            // Modi ueberspringen, die per #define abgeschaltet oder gerade nicht sinnvoll sind
+            while (skipMode(mode)) {
+                mode = pgm_read_byte_near(&modeTable[mode].next);
+            }
+        }
+
+        // wenn auf Alarm gewechselt wurde, fuer SHOW_ALARM_TIME_TIMER Sekunden die
+        // Weckzeit anzeigen.
+        #ifdef ALARM_OPTION_ENABLE
+            if (mode == STD_MODE_ALARM) {
+                alarm->resetShowAlarmTimer();
+            }
+        #endif
+
+        // Das DCF77-Signal sofort zeigen, nicht erst, wenn pollTimeArbiter() den Empfaenger einschaltet.
+        #ifdef DCF77_POWER_SAVE
+            if ((mode == EXT_MODE_DCF_DEBUG) || (mode == EXT_MODE_DCF_BLANK)) {
+                dcf77.enable(true);
+            }
+        #endif
+
+        // Automatischer Rücksprung nach definierter Wartedauer (hier: Zurücksetzen)
+        if (pgm_read_byte_near(&modeTable[mode].timeout)) {
+            jumpToTime = pgm_read_byte_near(&modeTable[mode].timeout);
+        }
+
+        DEBUG_PRINT(F("Change mode pressed, mode is now "));
+        DEBUG_PRINT(mode);
+        DEBUG_PRINTLN(F("..."));
+        DEBUG_FLUSH();
+
+        // Displaytreiber ausschalten, wenn BLANK oder NIGHT
+        if (isCurrentModeDarkMode()) {
+            setDisplayToOff();
+        }
+    }
+}
+
+/**
+ * Was soll ausgefuehrt werden, wenn die H+-Taste gedrueckt wird?
+ */
+void hourPlusPressed() {
+    if (CheckAlarmAndSnoozeOrDeactivate()) {
+        resetCheckLdrThreshold_resetNightLock_needsUpdateFromRtc();
+
+        DEBUG_PRINTLN(F("Hours plus pressed..."));
+        DEBUG_FLUSH();
+
+        ModeFunction hourPlus = (ModeFunction)pgm_read_ptr_near(&modeTable[mode].hourPlus);
+        if (hourPlus) {
+            hourPlus();
+        }
+    }
+}
+
+/**
+ * Was soll ausgefuehrt werden, wenn die M+-Taste gedrueckt wird?
+ */
+void minutePlusPressed() {
+    if (CheckAlarmAndSnoozeOrDeactivate()) {
+        resetCheckLdrThreshold_resetNightLock_needsUpdateFromRtc();
+
+        DEBUG_PRINTLN(F("Minutes plus pressed..."));
+        DEBUG_FLUSH();
+
+        ModeFunction minutePlus = (ModeFunction)pgm_read_ptr_near(&modeTable[mode].minutePlus);
+        if (minutePlus) {
+            minutePlus();
+        }
+    }
+}
+
+/******************************************************************************
+ * Die Modi: Anzeige und Tasten. Die Zuordnung macht die Modus-Tabelle.
+ ******************************************************************************/
+
+/**
+ * Einen Eintrag der Modus-Tabelle aus dem PROGMEM holen.
+ */
+void readModeEntry(byte _mode, ModeEntry* entry) {
+    memcpy_P(entry, &modeTable[_mode], sizeof(ModeEntry));
+}
+
+/**
+ * Die Flags eines Modus.
+ */
+byte getModeFlags(byte _mode) {
+    return pgm_read_byte_near(&modeTable[_mode].flags);
+}
+
+/**
+ * Soll der Modus beim Weiterschalten mit der Mode-Taste uebersprungen werden?
+ */
+boolean skipMode(byte _mode) {
+    byte flags = getModeFlags(_mode);
+    if (flags & MODE_FLAG_SKIP) {
+        return true;
+    }
+    if ((flags & MODE_FLAG_NEEDS_LDR) && !settings.getUseLdr()) {
+        return true;
+    }
+    if ((flags & MODE_FLAG_NEEDS_LDR_BLANK) && (!settings.getBlankByLdr() || !settings.getUseLdr())) {
+        return true;
+    }
+    if ((flags & MODE_FLAG_NIGHT_TIME) && settings.getBlankByLdr()) {
+        return true;
+    }
+    #ifdef COUNTDOWN
+        if (flags & MODE_FLAG_NEEDS_COUNTDOWN) {
+            rtc.readTime();
+            CheckCountdown();
+            return countdown < 0;
+        }
+    #endif
+    return false;
+}
+
+/*
+ * Anzeige der Modi.
+ */
+void renderNormal() {
+    byte minutes = rtc.getMinutes();
+    byte language = settings.getLanguage();
+    renderer.setMinutes(rtc.getHours(), minutes, language, matrix);
+    renderer.setCorners(minutes, settings.getRenderCornersCw(), matrix);
+    if (!settings.getEsIst() && ((minutes / 5) % 6)) {
+        renderer.cleanIntroWords(language, matrix); // ES IST weg
+    }
+}
+
+void renderTimeSet() {
+    renderer.setAfternoon(rtc.getHours());
+    renderNormal();
+}
+
+void renderTimeShift() {
+    char timeShift = settings.getTimeShift();
+    char absTimeShift = abs(timeShift);
+    if (timeShift < 0) {
+        for (byte x = 0; x < 3; x++) {
+            ledDriver.setPixelInScreenBuffer(x, 1, matrix);
+        }
+    } else if (timeShift > 0) {
+        for (byte x = 0; x < 3; x++) {
+            ledDriver.setPixelInScreenBuffer(x, 1, matrix);
+        }
+        for (byte y = 0; y < 3; y++) {
+            ledDriver.setPixelInScreenBuffer(1, y, matrix);
+        }
+    }
+    write1xyDigit(absTimeShift % 10, 5, 3);
+    if (absTimeShift > 9) {
+        write1xyDigit(1, 10, 3);
+    }
+}
+
+#ifdef ALARM_OPTION_ENABLE
+    void renderAlarm() {
+        if ((alarm->getShowAlarmTimer() == 0) || alarm->isEnable()) {
+            alarm->toggleEnable();
+            settings.saveToEEPROM();
+            goToNormalDispOn();
+        } else {
+            byte language = settings.getLanguage();
+            byte hours = alarm->getHours();
+            if (settings.get24hMode())
+                renderer.setAfternoon(hours);
+            renderer.setMinutes(hours, alarm->getMinutes(), language, matrix);
+            renderer.setCorners(alarm->getMinutes(), settings.getRenderCornersCw(), matrix);
+            renderer.cleanIntroWords(language, matrix); // ES IST weg
+        }
+    }
+
+    void renderAlarmMelody() {
+        write1xyStab('A', 8, 0);
+        write2ySmallDigits(alarm->getAlarmMelody(), 5);
+    }
+
+    void render24() {
+        if (settings.get24hMode()) {
+            write2ySmallDigits(24, 0);
+        } else {
+            write2ySmallDigits(12, 0);
+        }
+        write1xyStab('H', 4, 5);
+    }
+
+    void renderSnooze() {
+        write2yStaben('S', 'N', 0);
+        write2ySmallDigits(settings.getSnooze(), 5);
+    }
+#endif
+
+#ifdef DATE_ENABLE
+    void renderDate() {
+        byte rtcDate = rtc.getDate();
+        byte rtcMonth = rtc.getMonth();
+        #ifdef EVENTDAY
+            /**
+             * Ist der heutige Tag ein Ereignis, wird das entsprechend definierte
+             * Symbol dazu auf der Datumsanzeige ausgegeben.
+             * Ereignisse werden in der Ereignisse.h definiert.
+             */
+            updateEventCache();
+            eventdaySymbol = eventdayToday;
+            if (eventdaySymbol != -1) {
+                // Anzeige des Geburtstagssymbols
+                writeEventSymbol();
+            } else
+        #endif
+        {
+            // Anzeige des Datums
+            #if defined(DATE_SCROLL)
+                char text[] = "00.00.2000";
+                text[0] += rtcDate / 10;
+                text[1] += rtcDate % 10;
+                text[3] += rtcMonth / 10;
+                text[4] += rtcMonth % 10;
+                text[8] += rtc.getYear() / 10;
+                text[9] += rtc.getYear() % 10;
+                textRenderer.scroll(text, 2);
+                textRenderer.renderScroll(matrix);
+            #elif defined(DATE_MONTH_SHOW)
+                write4SmallDigits(rtcDate, rtcMonth);
+                ledDriver.setPixelInScreenBuffer(10, 4, matrix);
+                ledDriver.setPixelInScreenBuffer(10, 9, matrix);
+            #else
+                write2yDigits(rtcDate, 1);
+            #endif
+        }
+    }
+#endif
+
+#ifdef COUNTDOWN
+    /**
+     * Dieser Modus zeigt den Countdown zu einem Ereignis an.
+     * Ereignisse werden in Ereignisse.h definiert.
+     */
+    void renderCountdown() {
+        if (countdown >= 60) {
+            // Anzeige des Countdowns (Minuten und Sekunden)
+            write4SmallDigits(countdown / 60 % 60, countdown % 60);
+            ledDriver.setPixelInScreenBuffer(10, 1, matrix);
+            ledDriver.setPixelInScreenBuffer(10, 3, matrix);
+        } else if (countdown >= 0) {
+            // Anzeige des Countdowns (nur Sekunden)
+            write2yDigits(countdown, 1);
+        } else if (countdown > -COUNTDOWN_BLINK_DURATION) {
+            // Anzeige des Symbols blinkend im Sekundentakt
+            if (countdown % 2) {
+                writeEventSymbol();
+            }
+        } else {
+            // Rücksprung auf Uhrzeit
+            mode = STD_MODE_NORMAL;
+        }
+    }
+#endif
+
+void renderMainSettings() {
+    write4Staben('M', 'A', 'I', 'N');
+}
+
+void renderTimeSettings() {
+    write4Staben('T', 'I', 'M', 'E');
+}
+
+void renderTestSettings() {
+    write4Staben('T', 'E', 'S', 'T');
+}
+
+void renderYearSet() {
+    write2yStaben('Y', 'Y', 0);
+    write2ySmallDigits(rtc.getYear(), 5);
+}
+
+void renderMonthSet() {
+    write2yStaben('M', 'M', 0);
+    write2ySmallDigits(rtc.getMonth(), 5);
+}
+
+void renderDateSet() {
+    write2yStaben('D', 'D', 0);
+    write2ySmallDigits(rtc.getDate(), 5);
+}
+
+void renderNightTime() {
+    if ((mode == EXT_MODE_OFFTIME_MOFR) || (mode == EXT_MODE_OFFTIME_SASO)) {
+        ledDriver.setPixelInScreenBuffer(10, 7, matrix);
+    }
+    TimeStamp* timeStamp = getNightTimeStamp(mode);
+    write4SmallDigits(timeStamp->getHours(), timeStamp->getMinutes());
+    ledDriver.setPixelInScreenBuffer(10, 1, matrix);
+    ledDriver.setPixelInScreenBuffer(10, 3, matrix);
+}
+
+void renderSeconds() {
+    renderer.setCorners(rtc.getMinutes(), settings.getRenderCornersCw(), matrix);
+    write2yDigits(helperSeconds, 1);
+}
+
+void renderLdrMode() {
+    if (settings.getUseLdr()) {
+        write1xyStab('A', 8, 3);
+    } else {
+        write1xyStab('M', 8, 3);
+    }
+}
+
+void renderLdrNightMode() {
+    if (settings.getBlankByLdr()) {
+        write4Staben('L', 'N', 'E', 'N');
+    } else {
+        write4Staben('L', 'N', 'D', 'A');
+    }
+}
+
+void renderLdrNightThresh() {
+    write2yDigits(settings.getLdrBlankThreshold(), 3);
+}
+
+void renderAllOn() {
+    renderer.setAllScreenBuffer(matrix);
+}
+
+void renderBrightness() {
+    #ifdef BRIGHTNESS_SETTING_IN_PERCENTAGE
+        write2yDigits(settings.getBrightness(), 1);
+    #else
+        ledDriver.setPixelInScreenBuffer(0, 9, matrix);
+        byte brightnessToDisplay = settings.getBrightness() / 10;
+        for (byte xb = 0; xb < brightnessToDisplay; xb++) {
+            for (byte yb = 0; yb <= xb; yb++) {
+                matrix[9 - yb] |= 1 << (14 - xb);
+            }
+        }
+    #endif
+}
+
+void renderCorners() {
+    if (settings.getRenderCornersCw()) {
+        write2Staben('C', 'W');
+    } else {
+        write1xyStab('C', 8, 0);
+        write2yStaben('C', 'W', 5);
+    }
+}
+
+void renderEsIst() {
+    if (settings.getEsIst()) {
+        write4Staben('I', 'T', 'E', 'N');
+    } else {
+        write4Staben('I', 'T', 'D', 'A');
+    }
+}
+
+void renderDcfInverted() {
+    if (settings.getDcfSignalIsInverted()) {
+        write4Staben('R', 'S', 'I', 'N');
+    } else {
+        write4Staben('R', 'S', 'N', 'O');
+    }
+}
+
+void renderLanguage() {
+    for (byte i = 0; i < 5; i++) {
+        switch (settings.getLanguage()) {
+            #ifdef SPRACHE_DE
+                case LANGUAGE_DE_DE:
+                    write2Staben('D', 'E');
+                    break;
+                case LANGUAGE_DE_SW:
+                    write4Staben('D', 'E', 'S', 'W');
+                    break;
+                case LANGUAGE_DE_BA:
+                    write4Staben('D', 'E', 'B', 'A');
+                    break;
+                case LANGUAGE_DE_SA:
+                    write4Staben('D', 'E', 'S', 'A');
+                    break;
+            #endif
+            #ifdef SPRACHE_CH
+                case LANGUAGE_CH:
+                    write2Staben('C', 'H');
+                    break;
+            #endif
+            #ifdef SPRACHE_EN
+                case LANGUAGE_EN:
+                    write2Staben('E', 'N');
+                    break;
+            #endif
+            #ifdef SPRACHE_FR
+                case LANGUAGE_FR:
+                    write2Staben('F', 'R');
+                    break;
+            #endif
+            #ifdef SPRACHE_IT
+                case LANGUAGE_IT:
+                    write2Staben('I', 'T');
+                    break;
+            #endif
+            #ifdef SPRACHE_NL
+                case LANGUAGE_NL:
+                    write2Staben('N', 'L');
+                    break;
+            #endif
+            #ifdef SPRACHE_ES
+                case LANGUAGE_ES:
+                    write2Staben('E', 'S');
+                    break;
+            #endif
+            #ifdef SPRACHE_PT
+                case LANGUAGE_PT:
+                    write2Staben('P', 'T');
+                    break;
+            #endif
+        }
+    }
+}
+
+void renderTest() {
+    renderer.setCorners(helperSeconds % 5, settings.getRenderCornersCw(), matrix);
+    renderer.activateAlarmLed(matrix);
+    for (byte i = 0; i < 11; i++) {
+        ledDriver.setPixelInScreenBuffer(x, i, matrix);
+    }
+    x++;
+    if (x > 10) {
+        x = 0;
+    }
+}
+
+#ifdef DCF77_SENSOR_EXISTS
+    void renderDcfSync() {
+        // Die Quelle des letzten erfolgreichen Syncs (samplesOK) und die Zeit seitdem in Stunden : Minuten als Lauftext
+        char text[] = "DCF 00:00";
+        unsigned long lastSync = dcf77.getDcf77LastSuccessSyncMinutes();
+        #ifdef GPS_ENABLE
+            if (timeArbiter.getLastSource() == TIME_SOURCE_GPS) {
+                memcpy(text, "GPS", 3);
+                lastSync = gps.getGpsLastSuccessSyncMinutes();
+            }
+        #endif
+        unsigned long minutes = rtc.getMinutesOfCentury() - lastSync;
+        if (minutes > 5999)
+            minutes = 5999;
+        text[4] += minutes / 600;
+        text[5] += minutes / 60 % 10;
+        text[7] += minutes % 60 / 10;
+        text[8] += minutes % 10;
+        textRenderer.scroll(text, 2);
+        textRenderer.renderScroll(matrix);
+    }
+
+    void renderDcfDebug() {
+        needsRender = true;
+        renderer.setCorners(dcf77.getDcf77ErrorCorner(), settings.getRenderCornersCw(), matrix);
+    }
+#endif
+
+#ifdef IR_LEARN_ENABLE
+    void renderIrLearn() {
+        write2yStaben('I', 'R', 0);
+        write2ySmallDigits(irLearnButton, 5);
+    }
+#endif
+
+#ifdef LOOP_PROFILER
+    /**
+     * Oben der Abschnitt, unten sein Histogramm (Klasse 0 links, Hoehe
+     * relativ zur vollsten Klasse, belegte Klassen mindestens eine LED).
+     */
+    void renderProfiler() {
+        write2yStaben(loopProfiler.getCode(profilerStage, 0), loopProfiler.getCode(profilerStage, 1), 0);
+        byte maxBin = 1;
+        for (byte i = 0; i < PROFILER_BINS; i++) {
+            maxBin = max(maxBin, loopProfiler.getBin(profilerStage, i));
+        }
+        for (byte i = 0; i < PROFILER_BINS; i++) {
+            byte height = ((word) loopProfiler.getBin(profilerStage, i) * 5 + maxBin - 1) / maxBin;
+            for (byte j = 0; j < height; j++) {
+                ledDriver.setPixelInScreenBuffer(1 + i, 9 - j, matrix);
+            }
+        }
+    }
+#endif
+
+#ifdef TRACE_ENABLE
+    /**
+     * Oben der Typ des Eintrags, darunter die Nutzdaten als Bits
+     * (hoechstes links).
+     */
+    void renderTrace() {
+        TraceRecord record;
+        if (!eventTrace.getRecord(traceAge, &record)) {
+            return;
+        }
+        write2yStaben(eventTrace.getCode(record.type, 0), eventTrace.getCode(record.type, 1), 0);
+        for (byte i = 0; i < 8; i++) {
+            if (record.payload & (0x80 >> i)) {
+                ledDriver.setPixelInScreenBuffer(1 + i, 7, matrix);
+            }
+        }
+    }
+#endif
+
+/*
+ * Tasten der Modi.
+ */
+#ifdef WW_5_BUTTONS
+    void wwHourPlus() {
+        goTo_leaveFrom_Blank(true);
+    }
+
+    void wwMinutePlus() {
+        setDisplayToOn();
+        mode = STD_MODE_ALLON;
+    }
+
+    void wwBlankHourPlus() {
+        if ( !settings.getBlankByLdr() && !checkNight() ) {
+            // Manueller Wechsel zurück in den zeitgesteuerten Nachtmodus (ohne nightByTimeLock zu verändern)
+            goToNight();
+            // Alternative: nightByTimeLock wird verändert:
+            // nightByTimeLock = 0;
+            // goTo_leaveFrom_Blank(true);
+        } else
+            goToNormalDispOn();
+    }
+#else
+    void resumeNightByTime() {
+        // Manueller Wechsel zurück in den zeitgesteuerten Nachtmodus
+        nightByTimeLock = 0;
+    }
+#endif
+
+void goToNormal() {
+    mode = STD_MODE_NORMAL;
+}
+
+void goToTimeSettings() {
+    mode = EXT_MODE_TIME_SETTINGS_START;
+}
+
+void goToTestSettings() {
+    mode = EXT_MODE_TEST_DEBUG_START;
+}
+
+/**
+ * Die Zeit wurde von Hand gestellt (Menue, Konsole): Sie gilt dem TimeArbiter
+ * als Referenz, grosse Abweichungen der Zeitquellen davon sind Ausreisser.
+ */
+void timeSetManually() {
+    #if defined(DCF77_SENSOR_EXISTS) || defined(GPS_ENABLE)
+        timeArbiter.setManual(&rtc);
+    #endif
+}
+
+void timeSetHourPlus() {
+    rtc.incHours();
+    helperSeconds = 59;
+    rtc.setSeconds(0);
+    rtc.writeTime();
+    timeSetManually();
+    DEBUG_PRINT(F("H is now "));
+    DEBUG_PRINTLN(rtc.getHours());
+    DEBUG_FLUSH();
+}
+
+void timeSetMinutePlus() {
+    rtc.incMinutes();
+    helperSeconds = 59;
+    rtc.setSeconds(0);
+    rtc.writeTime();
+    timeSetManually();
+    DEBUG_PRINT(F("M is now "));
+    DEBUG_PRINTLN(rtc.getMinutes());
+    DEBUG_FLUSH();
+}
+
+void yearSetHourPlus() {
+    rtc.incYear(10);
+    rtc.writeTime();
+    timeSetManually();
+}
+
+void yearSetMinutePlus() {
+    rtc.incYear();
+    rtc.writeTime();
+    timeSetManually();
+}
+
+void monthSetHourPlus() {
+    rtc.incMonth(10);
+    rtc.writeTime();
+    timeSetManually();
+}
+
+void monthSetMinutePlus() {
+    rtc.incMonth();
+    rtc.writeTime();
+    timeSetManually();
+}
+
+void dateSetHourPlus() {
+    rtc.incDate(10);
+    rtc.writeTime();
+    timeSetManually();
+}
+
+void dateSetMinutePlus() {
+    rtc.incDate();
+    rtc.writeTime();
+    timeSetManually();
+}
+
+void timeShiftHourPlus() {
+    rtc.addSubHoursOverflow(settings.decTimeShift());
+    rtc.writeTime();
+}
+
+void timeShiftMinutePlus() {
+    rtc.addSubHoursOverflow(settings.incTimeShift());
+    rtc.writeTime();
+}
+
+void nightTimeHourPlus() {
+    getNightTimeStamp(mode)->incHours();
+}
+
+void nightTimeMinutePlus() {
+    getNightTimeStamp(mode)->incMinutes();
+}
+
+#ifdef ALARM_OPTION_ENABLE
+    void alarmHourPlus() {
+        alarm->incHours();
+        alarm->resetShowAlarmTimer();
+        DEBUG_PRINT(F("A is now "));
+        DEBUG_PRINTLN(alarm->asString());
+        DEBUG_FLUSH();
+    }
+
+    void alarmMinutePlus() {
+        alarm->incMinutes();
+        alarm->resetShowAlarmTimer();
+        DEBUG_PRINT(F("A is now "));
+        DEBUG_PRINTLN(alarm->asString());
+        DEBUG_FLUSH();
+    }
+
+    #ifdef WW_5_BUTTONS
+        void alarmModePressed() {
+            alarm->incMinutes(5);
+        }
+    #endif
+
+    void alarmMelodyHourPlus() {
+        alarm->incAlarmMelody();
+    }
+
+    void alarmMelodyMinutePlus() {
+        alarm->decAlarmMelody();
+    }
+
+    void toggle24hMode() {
+        settings.toggle24hMode();
+    }
+
+    void snoozeHourPlus() {
+        settings.incSnooze();
+    }
+
+    void snoozeMinutePlus() {
+        settings.decSnooze();
+    }
+#endif
+
+void toggleUseLdr() {
+    settings.toggleUseLdr();
+    DEBUG_PRINT(F("LDR is now "));
+    DEBUG_PRINTLN(settings.getUseLdr());
+    DEBUG_FLUSH();
+}
+
+void toggleBlankByLdr() {
+    settings.toggleBlankByLdr();
+}
+
+void ldrNightThreshHourPlus() {
+    settings.changeLdrBlankThreshold(-1);
+}
+
+void ldrNightThreshMinutePlus() {
+    settings.changeLdrBlankThreshold(1);
+}
+
+void toggleRenderCornersCw() {
+    settings.toggleRenderCornersCw();
+}
+
+void toggleEsIst() {
+    settings.toggleEsIst();
+}
+
+void toggleDcfSignalIsInverted() {
+    settings.toggleDcfSignalIsInverted();
+}
+
+void languageHourPlus() {
+    settings.decLanguage();
+}
+
+void languageMinutePlus() {
+    settings.incLanguage();
+}
+
+#ifdef IR_LEARN_ENABLE
+    void irLearnHourPlus() {
+        if (irLearnButton == REMOTE_BUTTON_UNDEFINED) {
+            irLearnButton = REMOTE_BUTTON_SETCOLOR - 1;
+        } else {
+            irLearnButton--;
+        }
+    }
+
+    void irLearnMinutePlus() {
+        irLearnButton++;
+        if (irLearnButton >= REMOTE_BUTTON_SETCOLOR) {
+            irLearnButton = REMOTE_BUTTON_UNDEFINED;
+        }
+    }
+#endif
+
+#ifdef LOOP_PROFILER
+    void profilerHourPlus() {
+        profilerStage++;
+        if (profilerStage >= PROFILER_STAGES) {
+            profilerStage = PROFILER_STAGE_LDR;
+        }
+    }
+
+    /**
+     * Alle Abschnitte ueber Serial ausgeben und neu messen.
+     */
+    void profilerMinutePlus() {
+        loopProfiler.dump();
+        loopProfiler.reset();
+    }
+#endif
+
+#ifdef TRACE_ENABLE
+    /**
+     * Einen Eintrag aelter, nach dem aeltesten wieder der neueste.
+     */
+    void traceHourPlus() {
+        traceAge++;
+        if (traceAge >= eventTrace.getCount()) {
+            traceAge = 0;
+        }
+    }
+
+    void traceMinutePlus() {
+        eventTrace.dump();
+    }
+#endif
+
+/*
+ * Was per #define abgeschaltet ist, wird in der Tabelle zu NULL bzw. zu
+ * MODE_FLAG_SKIP.
+ */
+#ifdef WW_5_BUTTONS
+    #define MODE_WW(ww, std) ww
+#else
+    #define MODE_WW(ww, std) std
+#endif
+#ifdef ALARM_OPTION_ENABLE
+    #define MODE_ALARM(f)   f
+    #define MODE_ALARM_SKIP 0
+#else
+    #define MODE_ALARM(f)   NULL
+    #define MODE_ALARM_SKIP MODE_FLAG_SKIP
+#endif
+#ifdef DATE_ENABLE
+    #define MODE_DATE(f)    f
+    #define MODE_DATE_SKIP  0
+#else
+    #define MODE_DATE(f)    NULL
+    #define MODE_DATE_SKIP  MODE_FLAG_SKIP
+#endif
+#ifdef COUNTDOWN
+    #define MODE_COUNTDOWN(f)   f
+    #define MODE_COUNTDOWN_SKIP MODE_FLAG_NEEDS_COUNTDOWN
+#else
+    #define MODE_COUNTDOWN(f)   NULL
+    #define MODE_COUNTDOWN_SKIP MODE_FLAG_SKIP
+#endif
+#ifdef DCF77_SENSOR_EXISTS
+    #define MODE_DCF(f)     f
+    #define MODE_DCF_SKIP   0
+#else
+    #define MODE_DCF(f)     NULL
+    #define MODE_DCF_SKIP   MODE_FLAG_SKIP
+#endif
+#ifdef IR_LEARN_ENABLE
+    #define MODE_IR_LEARN(f)   f
+    #define MODE_IR_LEARN_SKIP 0
+#else
+    #define MODE_IR_LEARN(f)   NULL
+    #define MODE_IR_LEARN_SKIP MODE_FLAG_SKIP
+#endif
+#ifdef LOOP_PROFILER
+    #define MODE_PROFILER(f)   f
+    #define MODE_PROFILER_SKIP 0
+#else
+    #define MODE_PROFILER(f)   NULL
+    #define MODE_PROFILER_SKIP MODE_FLAG_SKIP
+#endif
+#ifdef TRACE_ENABLE
+    #define MODE_TRACE(f)      f
+    #define MODE_TRACE_SKIP    0
+#else
+    #define MODE_TRACE(f)      NULL
+    #define MODE_TRACE_SKIP    MODE_FLAG_SKIP
+#endif
+// Die Zeiten für die Nachtabschaltung müssen beim A0-Hack einstellbar bleiben.
+#if defined(WW_5_BUTTONS) && defined(WW_5_BUTTONS_NEAR_SENSOR_ENABLE) && defined(WW_5_BUTTONS_ENABLE_NEARSENSOR_A0)
+    #define MODE_NIGHT_TIME 0
+#else
+    #define MODE_NIGHT_TIME MODE_FLAG_NIGHT_TIME
+#endif
+
+/*
+ * Die Modus-Tabelle, Index ist der Modus:
+ * {next, flags, timeout, refresh, render, hourPlus, minutePlus, modeKey}
+ */
+const ModeEntry modeTable[] PROGMEM = {
+    // STD_MODE_NORMAL (der Wortwecker hat die Weckzeit auf der Alarm-Taste)
+    {MODE_WW(STD_MODE_SECONDS, STD_MODE_ALARM), MODE_FLAG_NIGHT_ALLOWED, 0, MODE_REFRESH_MINUTE,
+        renderNormal, MODE_WW(wwHourPlus, resumeNightByTime), MODE_WW(wwMinutePlus, resumeNightByTime), NULL},
+    // STD_MODE_ALARM
+    {STD_MODE_SECONDS, MODE_FLAG_NIGHT_ALLOWED | MODE_ALARM_SKIP, 0, MODE_REFRESH_SECOND,
+        MODE_ALARM(renderAlarm), MODE_ALARM(alarmHourPlus), MODE_ALARM(alarmMinutePlus), MODE_WW(MODE_ALARM(alarmModePressed), NULL)},
+    // STD_MODE_SECONDS
+    {STD_MODE_COUNTDOWN, MODE_FLAG_NIGHT_ALLOWED, TIMEOUT_JUMP_TO_TIME, MODE_REFRESH_SECOND,
+        renderSeconds, MODE_WW(wwHourPlus, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // STD_MODE_COUNTDOWN
+    {STD_MODE_DATE, MODE_FLAG_NIGHT_ALLOWED | MODE_COUNTDOWN_SKIP, 0, MODE_REFRESH_SECOND,
+        MODE_COUNTDOWN(renderCountdown), MODE_WW(wwHourPlus, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // STD_MODE_DATE
+    {MODE_WW(STD_MODE_NORMAL, STD_MODE_BRIGHTNESS), MODE_FLAG_NIGHT_ALLOWED | MODE_DATE_SKIP, TIMEOUT_JUMP_TO_TIME, MODE_REFRESH_MINUTE,
+        MODE_DATE(renderDate), MODE_WW(wwHourPlus, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // STD_MODE_BRIGHTNESS
+    {MODE_WW(STD_MODE_NORMAL, STD_MODE_BLANK), 0, 0, MODE_REFRESH_INPUT,
+        renderBrightness, setDisplayDarker, setDisplayBrighter, NULL},
+    // STD_MODE_BLANK
+    {STD_MODE_NORMAL, MODE_FLAG_NIGHT_ALLOWED | MODE_FLAG_DARK, 0, MODE_REFRESH_INPUT,
+        NULL, MODE_WW(wwBlankHourPlus, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // STD_MODE_NIGHT
+    {STD_MODE_NORMAL, MODE_FLAG_NIGHT_ALLOWED | MODE_FLAG_DARK, 0, MODE_REFRESH_INPUT,
+        NULL, MODE_WW(goToNormalDispOn, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // STD_MODE_ALLON
+    {STD_MODE_NORMAL, 0, 0, MODE_REFRESH_INPUT,
+        renderAllOn, MODE_WW(wwHourPlus, NULL), MODE_WW(goToNormal, NULL), NULL},
+
+    // EXT_MODE_MAIN_SETTINGS_START
+    {EXT_MODE_LDR_MODE, 0, 0, MODE_REFRESH_INPUT,
+        renderMainSettings, goToTimeSettings, goToTimeSettings, NULL},
+    // EXT_MODE_LDR_MODE
+    {EXT_MODE_LDR_NIGHT_MODE, 0, 0, MODE_REFRESH_INPUT,
+        renderLdrMode, toggleUseLdr, toggleUseLdr, NULL},
+    // EXT_MODE_LDR_NIGHT_MODE
+    {EXT_MODE_LDR_NIGHT_THRESH, MODE_FLAG_NEEDS_LDR, 0, MODE_REFRESH_INPUT,
+        renderLdrNightMode, toggleBlankByLdr, toggleBlankByLdr, NULL},
+    // EXT_MODE_LDR_NIGHT_THRESH
+    {EXT_MODE_CORNERS, MODE_FLAG_NEEDS_LDR_BLANK, 0, MODE_REFRESH_INPUT,
+        renderLdrNightThresh, ldrNightThreshHourPlus, ldrNightThreshMinutePlus, NULL},
+    // EXT_MODE_CORNERS
+    {EXT_MODE_ES_IST, 0, 0, MODE_REFRESH_INPUT,
+        renderCorners, toggleRenderCornersCw, toggleRenderCornersCw, NULL},
+    // EXT_MODE_ES_IST
+    {EXT_MODE_ALARM_MELODY, 0, 0, MODE_REFRESH_INPUT,
+        renderEsIst, toggleEsIst, toggleEsIst, NULL},
+    // EXT_MODE_ALARM_MELODY
+    {EXT_MODE_DCF_IS_INVERTED, MODE_ALARM_SKIP, 0, MODE_REFRESH_INPUT,
+        MODE_ALARM(renderAlarmMelody), MODE_ALARM(alarmMelodyHourPlus), MODE_ALARM(alarmMelodyMinutePlus), NULL},
+    // EXT_MODE_DCF_IS_INVERTED
+    {EXT_MODE_LANGUAGE, MODE_DCF_SKIP, 0, MODE_REFRESH_INPUT,
+        renderDcfInverted, toggleDcfSignalIsInverted, toggleDcfSignalIsInverted, NULL},
+    // EXT_MODE_LANGUAGE
+    {EXT_MODE_TIME_SETTINGS_START, 0, 0, MODE_REFRESH_INPUT,
+        renderLanguage, languageHourPlus, languageMinutePlus, NULL},
+
+    // EXT_MODE_TIME_SETTINGS_START
+    {EXT_MODE_TIME_SHIFT, 0, 0, MODE_REFRESH_INPUT,
+        renderTimeSettings, goToTestSettings, goToTestSettings, NULL},
+    // EXT_MODE_TIME_SHIFT
+    {EXT_MODE_YEARSET, 0, 0, MODE_REFRESH_INPUT,
+        renderTimeShift, timeShiftHourPlus, timeShiftMinutePlus, NULL},
+    // EXT_MODE_YEARSET
+    {EXT_MODE_MONTHSET, 0, 0, MODE_REFRESH_MINUTE,
+        renderYearSet, yearSetHourPlus, yearSetMinutePlus, NULL},
+    // EXT_MODE_MONTHSET
+    {EXT_MODE_DATESET, 0, 0, MODE_REFRESH_MINUTE,
+        renderMonthSet, monthSetHourPlus, monthSetMinutePlus, NULL},
+    // EXT_MODE_DATESET
+    {EXT_MODE_TIMESET, 0, 0, MODE_REFRESH_MINUTE,
+        renderDateSet, dateSetHourPlus, dateSetMinutePlus, NULL},
+    // EXT_MODE_TIMESET
+    {EXT_MODE_OFFTIME_MOFR, 0, 0, MODE_REFRESH_MINUTE,
+        renderTimeSet, timeSetHourPlus, timeSetMinutePlus, NULL},
+    // EXT_MODE_OFFTIME_MOFR
+    {EXT_MODE_ONTIME_MOFR, MODE_NIGHT_TIME, 0, MODE_REFRESH_INPUT,
+        renderNightTime, nightTimeHourPlus, nightTimeMinutePlus, NULL},
+    // EXT_MODE_ONTIME_MOFR
+    {EXT_MODE_OFFTIME_SASO, MODE_NIGHT_TIME, 0, MODE_REFRESH_INPUT,
+        renderNightTime, nightTimeHourPlus, nightTimeMinutePlus, NULL},
+    // EXT_MODE_OFFTIME_SASO
+    {EXT_MODE_ONTIME_SASO, MODE_NIGHT_TIME, 0, MODE_REFRESH_INPUT,
+        renderNightTime, nightTimeHourPlus, nightTimeMinutePlus, NULL},
+    // EXT_MODE_ONTIME_SASO
+    {EXT_MODE_24, MODE_NIGHT_TIME, 0, MODE_REFRESH_INPUT,
+        renderNightTime, nightTimeHourPlus, nightTimeMinutePlus, NULL},
+    // EXT_MODE_24
+    {EXT_MODE_SNOOZE, MODE_ALARM_SKIP, 0, MODE_REFRESH_INPUT,
+        MODE_ALARM(render24), MODE_ALARM(toggle24hMode), MODE_ALARM(toggle24hMode), NULL},
+    // EXT_MODE_SNOOZE
+    {EXT_MODE_TEST_DEBUG_START, MODE_ALARM_SKIP, 0, MODE_REFRESH_INPUT,
+        MODE_ALARM(renderSnooze), MODE_ALARM(snoozeHourPlus), MODE_ALARM(snoozeMinutePlus), NULL},
+
+    // EXT_MODE_TEST_DEBUG_START
+    {EXT_MODE_TEST, 0, 0, MODE_REFRESH_INPUT,
+        renderTestSettings, goToNormal, goToNormal, NULL},
+    // EXT_MODE_TEST
+    {EXT_MODE_DCF_SYNC, 0, 0, MODE_REFRESH_SECOND,
+        renderTest, MODE_WW(wwHourPlus, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // EXT_MODE_DCF_SYNC
+    {EXT_MODE_DCF_DEBUG, MODE_DCF_SKIP, 0, MODE_REFRESH_MINUTE,
+        MODE_DCF(renderDcfSync), MODE_WW(wwHourPlus, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // EXT_MODE_DCF_DEBUG
+    {EXT_MODE_DCF_BLANK, MODE_DCF_SKIP, 0, MODE_REFRESH_SECOND,
+        MODE_DCF(renderDcfDebug), MODE_WW(wwHourPlus, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // EXT_MODE_DCF_BLANK
+    {EXT_MODE_IR_LEARN, MODE_FLAG_DARK | MODE_DCF_SKIP, 0, MODE_REFRESH_INPUT,
+        NULL, MODE_WW(goToNormalDispOn, NULL), MODE_WW(wwMinutePlus, NULL), NULL},
+    // EXT_MODE_IR_LEARN
+    {EXT_MODE_PROFILER, MODE_IR_LEARN_SKIP, 0, MODE_REFRESH_INPUT,
+        MODE_IR_LEARN(renderIrLearn), MODE_IR_LEARN(irLearnHourPlus), MODE_IR_LEARN(irLearnMinutePlus), NULL},
+    // EXT_MODE_PROFILER
+    {EXT_MODE_TRACE, MODE_PROFILER_SKIP, 0, MODE_REFRESH_SECOND,
+        MODE_PROFILER(renderProfiler), MODE_PROFILER(profilerHourPlus), MODE_PROFILER(profilerMinutePlus), NULL},
+    // EXT_MODE_TRACE
+    {STD_MODE_NORMAL, MODE_TRACE_SKIP, 0, MODE_REFRESH_INPUT,
+        MODE_TRACE(renderTrace), MODE_TRACE(traceHourPlus), MODE_TRACE(traceMinutePlus), NULL}
+};
+
+#ifdef DEBUG
+/**
+ * Eine Zeit als Log-Eintrag (Stunden, Minuten, Tag, Monat, Jahr).
+ */
+void logTimeStamp(byte id, TimeStamp* timeStamp) {
+    int values[] = {timeStamp->getHours(), timeStamp->getMinutes(), timeStamp->getDate(), timeStamp->getMonth(), timeStamp->getYear()};
+    LOG_BYTES(id, values, sizeof(values));
+}
+#endif
+
+/**
+ * Dimmung: alle LDR_CHECK_RATE ms einen Schritt Richtung LDR bzw. manuelle Helligkeit.
+ */
+void brightnessTask() {
+    if (settings.getUseLdr()) {
+        brightnessController.update(ldr.value());
+    } else {
+        brightnessController.update(settings.getBrightness());
+    }
+}
+
+#ifdef ALARM_OPTION_ENABLE
+/**
+ * Alarm-LED: alle ALARM_LED_TICK ms, bei einer Aenderung neu rendern.
+ */
+void alarmLedTask() {
+    if (isAlarmLedOn != alarm->pollLed(mode == STD_MODE_ALARM)) {
+        isAlarmLedOn = !isAlarmLedOn;
+        needsRender = true;
+    }
+}
+#endif
+
+#ifdef DCF77_SENSOR_EXISTS
+/**
+ * DCF77: Der naechste (1s / MYDCF77_SIGNAL_BINS)-Abschnitt der Sekunde.
+ */
+void dcf77Task() {
+    if (dcf77.newCycle())
+        manageNewDCF77Data();
+}
+#endif
+
+/**
+ * Ein neues Sample einer Zeitquelle. Die Zeitverschiebung kommt fuer alle
+ * Quellen hier dazu, ob die RTC gestellt wird, entscheidet der TimeArbiter
+ * (u. a. mit den Zeitabstaenden zur RTC aus dem DCF77Helper der Quelle).
+ *
+ * @return TRUE, wenn die RTC gestellt wurde.
  */
-void modePressed() {
-    if (CheckAlarmAndSnoozeOrDeactivate()) {
-        // Da der aktuelle Modus eventuell durch Tastendruck geändert wird, Display wieder einschalten.
-        setDisplayToOn();
-    
-        #ifdef WW_5_BUTTONS
-            if (mode == STD_MODE_ALARM)
-                alarm->incMinutes(5); 
-            else
-        #endif  
-                {
-                    mode++;
-                    settings.saveToEEPROM();
-            
-                    #ifdef WW_5_BUTTONS
-                        if (mode < STD_MODE_WW_START) {
-                            mode = STD_MODE_WW_START;
-                        }
-                    #endif
-                }
-    
-        if (mode == STD_MODE_COUNTDOWN) {
-            #ifdef COUNTDOWN
-                rtc.readTime();
-                CheckCountdown();
-                if (countdown < 0)
-                    mode++;
-            #else
-                mode++;
-            #endif                    
+#if defined(DCF77_SENSOR_EXISTS) || defined(GPS_ENABLE)
+    boolean setRtcFromTimeSource(byte source, TimeStamp* time, byte seconds, DCF77Helper* helper) {
+        TimeStamp sample(time);
+        sample.addSubHoursOverflow(settings.getTimeShift());
+        rtc.readTime();
+        // Stimmen die Abstaende im Array? Pruefung mit Datum!
+        helper->addSample(&sample, &rtc);
+        if (!timeArbiter.offer(source, helper->samplesOk(), &sample, seconds, &rtc, rtc.getSeconds())) {
+            DEBUG_PRINTLN(F("Time trashed by the time arbiter."));
+            DEBUG_FLUSH();
+            return false;
         }
-        // Alarm ueberspringen, wenn Alarmmöglichkeit per #define abgeschaltet wurde
-        if (mode == STD_MODE_ALARM) {
-            // wenn auf Alarm gewechselt wurde, fuer SHOW_ALARM_TIME_TIMER Sekunden die
-            // Weckzeit anzeigen.
-            #ifdef ALARM_OPTION_ENABLE
-                alarm->resetShowAlarmTimer();
-            #else
-                mode++;
+        helperSeconds = 59;
+        rtc.set(&sample, false);
+        rtc.setSeconds(seconds);
+        rtc.writeTime();
+        DEBUG_PRINTLN(F("Time (+/- Timeshift) written to RTC."));
+        DEBUG_FLUSH();
+        if (mode == EXT_MODE_DCF_BLANK)
+            goToNormalDispOn();
+        return true;
+    }
+
+    /**
+     * Einmal pro Minute: Die Fehlerzaehler der Quellen melden und den
+     * DCF77-Empfaenger nur einschalten, wenn eine Synchronisation faellig ist
+     * oder sein Signal angezeigt wird.
+     */
+    void pollTimeArbiter() {
+        #ifdef DCF77_SENSOR_EXISTS
+            timeArbiter.reportErrors(TIME_SOURCE_DCF77, dcf77.getDecodeErrors());
+            #ifdef DCF77_POWER_SAVE
+                dcf77.enable(timeArbiter.wantsSample(&rtc) || (mode == EXT_MODE_DCF_DEBUG) || (mode == EXT_MODE_DCF_BLANK));
             #endif
-        }
-        #if !defined(ALARM_OPTION_ENABLE)
-            if (mode == EXT_MODE_ALARM_MELODY) {
-                mode++;
-            }
-        #endif
-        #if !defined(DATE_ENABLE)
-            if (mode == STD_MODE_DATE) {
-                mode++;
-            }
-        #endif
-        if (!settings.getUseLdr()) {
-            if (mode == EXT_MODE_LDR_NIGHT_MODE)
-                mode++;
-        }
-        if (!settings.getBlankByLdr() || !settings.getUseLdr()) {
-            if (mode == EXT_MODE_LDR_NIGHT_THRESH)
-                mode++;
-        }
-        // Zeiten der Nachtschaltung überpspringen, wenn LDR für Nachtschaltung verwendet wird.
-        // Wichtig: Die Zeiten für die Nachtabschaltung müssen aber einstellbar bleiben, wenn der A0-Hack verwendet wird!
-        #if ( !defined(WW_5_BUTTONS) || !defined(WW_5_BUTTONS_NEAR_SENSOR_ENABLE) || !defined(WW_5_BUTTONS_ENABLE_NEARSENSOR_A0) )
-            if (settings.getBlankByLdr()) {
-                if (mode == EXT_MODE_OFFTIME_MOFR)
-                    mode++;
-                if (mode == EXT_MODE_ONTIME_MOFR)
-                    mode++;
-                if (mode == EXT_MODE_OFFTIME_SASO)
-                    mode++;
-                if (mode == EXT_MODE_ONTIME_SASO)
-                    mode++;   
-            }
         #endif
-        // EXT_MODE_DCF_SYNC und EXT_MODE_DCF_DEBUG überspringen, wenn kein DCF77-Empfänger eingebaut
-        #if !defined(DCF77_SENSOR_EXISTS)
-            if (mode == EXT_MODE_DCF_IS_INVERTED)
-                mode++;
-            if (mode == EXT_MODE_DCF_SYNC)
-                mode++;
-            if (mode == EXT_MODE_DCF_DEBUG)
-                mode++;
-            if (mode == EXT_MODE_DCF_BLANK)
-                mode++;
-        #endif
-    
-        // Wenn mode außerhalb zulässigem Bereich (beim Wortwecker), zurück auf STD_MODE_NORMAL
-        #ifdef WW_5_BUTTONS
-            if ((mode >= STD_MODE_WW_END) && (mode < EXT_MODE_START)) {
-                mode = STD_MODE_NORMAL;
-            }
+        #ifdef GPS_ENABLE
+            timeArbiter.reportErrors(TIME_SOURCE_GPS, gps.getChecksumErrors());
         #endif
-    
-        // Wenn mode außerhalb zulässigem Bereich, zurück auf STD_MODE_NORMAL
-        if ( ((mode >= STD_MODE_COUNT) && (mode < EXT_MODE_START)) || (mode >= EXT_MODE_COUNT)) {
-            mode = STD_MODE_NORMAL;
-        }
-    
-        // Automatischer Rücksprung nach definierter Wartedauer (hier: Zurücksetzen)
-        switch (mode) {
-            case STD_MODE_SECONDS:
-            case STD_MODE_DATE:
-                // Timeout für den automatischen Rücksprung von
-                // STD_MODE_SECONDS und STD_MODE_DATE zurücksetzen
-                jumpToTime = TIMEOUT_JUMP_TO_TIME;
-                break;
-        }
-       
-        DEBUG_PRINT(F("Change mode pressed, mode is now "));
-        DEBUG_PRINT(mode);
-        DEBUG_PRINTLN(F("..."));
-        DEBUG_FLUSH();
-    
-        // Displaytreiber ausschalten, wenn BLANK oder NIGHT
-        if (isCurrentModeDarkMode()) {
-            setDisplayToOff();
-        }
     }
-}
+#endif
 
 /**
- * Was soll ausgefuehrt werden, wenn die H+-Taste gedrueckt wird?
+ * Korrekte Daten (auf Basis der Pruefbits) vom DCF-Empfaenger bekommen.
  */
-void hourPlusPressed() {
-    if (CheckAlarmAndSnoozeOrDeactivate()) {
-        resetCheckLdrThreshold_resetNightLock_needsUpdateFromRtc();
+#ifdef DCF77_SENSOR_EXISTS
+    void manageNewDCF77Data() {
+        #ifdef DEBUG
+            logTimeStamp(LOG_DCF_CAPTURED, &dcf77);
+        #endif
     
-        DEBUG_PRINTLN(F("Hours plus pressed..."));
-        DEBUG_FLUSH();
-          
-        switch (mode) {
-            #ifdef WW_5_BUTTONS
-                case STD_MODE_BLANK:
-                    if ( !settings.getBlankByLdr() && !checkNight() ) {
-                        // Manueller Wechsel zurück in den zeitgesteuerten Nachtmodus (ohne nightByTimeLock zu verändern)
-                        goToNight();
-                        // Alternative: nightByTimeLock wird verändert:
-                        // nightByTimeLock = 0;
-                        // goTo_leaveFrom_Blank(true);
-                    } else
-                        goToNormalDispOn();
-                    break;                   
-                case STD_MODE_NIGHT:
-                case EXT_MODE_DCF_BLANK:
-                    goToNormalDispOn();
-                    break;
-                default:       
-                    goTo_leaveFrom_Blank(true);
-                    break;
-            #else
-                case STD_MODE_NORMAL:
-                    // Manueller Wechsel zurück in den zeitgesteuerten Nachtmodus
-                    nightByTimeLock = 0;
-                    break;
-            #endif
-            case EXT_MODE_MAIN_SETTINGS_START:
-                mode = EXT_MODE_TIME_SETTINGS_START;
-                break;
-            case EXT_MODE_TIME_SETTINGS_START:
-                mode = EXT_MODE_TEST_DEBUG_START;
-                break;
-            case EXT_MODE_TEST_DEBUG_START:
-                mode = STD_MODE_NORMAL;
-                break;
-            case EXT_MODE_TIMESET:
-                rtc.incHours();
-                helperSeconds = 59;
-                rtc.setSeconds(0);
-                rtc.writeTime();
-                DEBUG_PRINT(F("H is now "));
-                DEBUG_PRINTLN(rtc.getHours());
-                DEBUG_FLUSH();
-                break;
-            case EXT_MODE_YEARSET:
-                rtc.incYear(10);
-                rtc.writeTime();
-                break;
-            case EXT_MODE_MONTHSET:
-                rtc.incMonth(10);
-                rtc.writeTime();
-                break;
-            case EXT_MODE_DATESET:
-                rtc.incDate(10);
-                rtc.writeTime();
-                break;
-            case EXT_MODE_TIME_SHIFT:
-                rtc.addSubHoursOverflow(settings.decTimeShift());
-                rtc.writeTime();
-                break;
-            case EXT_MODE_OFFTIME_MOFR:
-            case EXT_MODE_ONTIME_MOFR:
-            case EXT_MODE_OFFTIME_SASO:
-            case EXT_MODE_ONTIME_SASO:
-                getNightTimeStamp(mode)->incHours();
-                break;
-            #ifdef ALARM_OPTION_ENABLE
-                case STD_MODE_ALARM:
-                    alarm->incHours();
-                    alarm->resetShowAlarmTimer();
-                    DEBUG_PRINT(F("A is now "));
-                    DEBUG_PRINTLN(alarm->asString());
-                    DEBUG_FLUSH();
-                    break;
-            #endif
-            case STD_MODE_BRIGHTNESS:
-                setDisplayDarker();
-                break;
-            case EXT_MODE_LDR_MODE:
-                settings.toggleUseLdr();
-                DEBUG_PRINT(F("LDR is now "));
-                DEBUG_PRINTLN(settings.getUseLdr());
-                DEBUG_FLUSH();
-                break;
-            case EXT_MODE_LDR_NIGHT_MODE:
-                settings.toggleBlankByLdr();
-                break;
-            case EXT_MODE_LDR_NIGHT_THRESH:
-                settings.changeLdrBlankThreshold(-1);
-                break;
-            case EXT_MODE_CORNERS:
-                settings.toggleRenderCornersCw();
-                break;
-            case EXT_MODE_ES_IST:
-                settings.toggleEsIst();
-                break;
-            #ifdef ALARM_OPTION_ENABLE
-                case EXT_MODE_ALARM_MELODY:
-                    alarm->incAlarmMelody();
-                    break;
-            case EXT_MODE_24:
-                settings.toggle24hMode();
-                break;
-            case EXT_MODE_SNOOZE:
-                settings.incSnooze();
-                break;
+        if (setRtcFromTimeSource(TIME_SOURCE_DCF77, &dcf77, 0, &dcf77Helper)) {
+            dcf77.setDcf77SuccessSync(&rtc);
+            // Spezialfall für 5-Tasten-Wortwecker mit A0-Hack: Der DCF77-Empfänger wird nach erfolgreichen Empfang aus-
+            // und der Näherungssensor wieder eingeschaltet.
+            #if defined(WW_5_BUTTONS) && defined(WW_5_BUTTONS_NEAR_SENSOR_ENABLE) && defined(WW_5_BUTTONS_ENABLE_NEARSENSOR_A0)
+                if (nightByTimeLock == 1)
+                    nightByTimeLock = 2;
             #endif
-            case EXT_MODE_DCF_IS_INVERTED:
-                settings.toggleDcfSignalIsInverted();
-                break;
-            case EXT_MODE_LANGUAGE:
-                settings.decLanguage();
-                break;
         }
     }
-}
+#endif
 
 /**
- * Was soll ausgefuehrt werden, wenn die M+-Taste gedrueckt wird?
+ * Eine neue Minute vom GPS-Empfaenger (Ortszeit, Pruefsumme stimmt).
  */
-void minutePlusPressed() {
-    if (CheckAlarmAndSnoozeOrDeactivate()) {
-        resetCheckLdrThreshold_resetNightLock_needsUpdateFromRtc();
-    
-        DEBUG_PRINTLN(F("Minutes plus pressed..."));
-        DEBUG_FLUSH();
+#ifdef GPS_ENABLE
+    void manageNewGPSData() {
+        if (setRtcFromTimeSource(TIME_SOURCE_GPS, &gps, gps.getSeconds(), &gpsHelper))
+            gps.setGpsSuccessSync(&rtc);
+    }
+#endif
 
-        switch (mode) {
-            #ifdef WW_5_BUTTONS
-                case STD_MODE_ALLON:
-                    mode = STD_MODE_NORMAL;
-                    break;
-                default:
-                    setDisplayToOn();
-                    mode = STD_MODE_ALLON;
-                    break;
-            #else
-                case STD_MODE_NORMAL:
-                    // Manueller Wechsel zurück in den zeitgesteuerten Nachtmodus
-                    nightByTimeLock = 0;
+#ifdef SERIAL_CONSOLE
+/**
+ * Ein Kommando der SerialConsole ausfuehren. Antwort ist der gelesene Wert,
+ * OK oder ERR.
+ *
+ * ?                        Hilfe
+ * T [hh:mm[:ss]]           Zeit lesen/stellen
+ * D [dd.mm.yy]             Datum lesen/stellen
+ * G [Name]                 Einstellung(en) lesen
+ * S Name Wert              Einstellung setzen und speichern
+ * A [i Typ Tage hh:mm]     Zeitplan lesen/setzen (Typ mit Flags, Tage Bit 0 = Mo),
+ *                          bei den Nacht- und Weckzeiten aus dem Menue nur die Flags
+ * R                        DCF77 neu synchronisieren
+ * I                        Modus, Helligkeit, letzte DCF77-Synchronisation, Zeitquellen, Laufzeit, Schlaf, Aufgaben
+ * P                        Laufzeiten von loop() (LOOP_PROFILER)
+ * E                        Ereignisse (TRACE_ENABLE)
+ */
+void serialConsoleCommand() {
+    int values[5];
+    char name[10];
+    char field;
+    byte count;
+    Schedule* schedule = settings.getSchedule();
+    switch (serialConsole.getCommand()) {
+        case '?':
+            Serial.println(F("T [hh:mm[:ss]] D [dd.mm.yy] G [name] S name value A [i type days hh:mm] R I P E"));
+            return;
+        case 'T':
+            if (!serialConsole.atEnd()) {
+                values[2] = 0;
+                count = serialConsole.nextNumbers(values, 3);
+                if ((count < 2) || !serialConsole.atEnd() || (values[0] < 0) || (values[0] > 23)
+                    || (values[1] < 0) || (values[1] > 59) || (values[2] < 0) || (values[2] > 59)) {
                     break;
-            #endif
-            case EXT_MODE_MAIN_SETTINGS_START:
-                mode = EXT_MODE_TIME_SETTINGS_START;
-                break;
-            case EXT_MODE_TIME_SETTINGS_START:
-                mode = EXT_MODE_TEST_DEBUG_START;
-                break;
-            case EXT_MODE_TEST_DEBUG_START:
-                mode = STD_MODE_NORMAL;
-                break;
-            case EXT_MODE_TIMESET:
-                rtc.incMinutes();
-                helperSeconds = 59;
-                rtc.setSeconds(0);
-                rtc.writeTime();
-                DEBUG_PRINT(F("M is now "));
-                DEBUG_PRINTLN(rtc.getMinutes());
-                DEBUG_FLUSH();
-                break;
-            case EXT_MODE_YEARSET:
-                rtc.incYear();
-                rtc.writeTime();
-                break;
-            case EXT_MODE_MONTHSET:
-                rtc.incMonth();
-                rtc.writeTime();
-                break;
-            case EXT_MODE_DATESET:
-                rtc.incDate();
+                }
+                rtc.readTime();
+                rtc.setHours(values[0]);
+                rtc.setMinutes(values[1]);
+                rtc.setSeconds(values[2]);
                 rtc.writeTime();
-                break;
-            case EXT_MODE_TIME_SHIFT:
-                rtc.addSubHoursOverflow(settings.incTimeShift());
+                timeSetManually();
+                helperSeconds = 59;
+                needsUpdateFromRtc = true;
+            }
+            rtc.readTime();
+            Serial.print(rtc.asString());
+            Serial.print(' ');
+            Serial.println(rtc.getSeconds());
+            return;
+        case 'D':
+            if (!serialConsole.atEnd()) {
+                count = serialConsole.nextNumbers(values, 3);
+                if ((count < 3) || !serialConsole.atEnd() || (values[0] < 1) || (values[0] > 31)
+                    || (values[1] < 1) || (values[1] > 12) || (values[2] < 0) || (values[2] > 99)) {
+                    break;
+                }
+                rtc.readTime();
+                // set() prueft das Datum und berechnet den Wochentag
+                rtc.set(rtc.getMinutes(), rtc.getHours(), values[0], 0, values[1], values[2]);
                 rtc.writeTime();
-                break;
-            case EXT_MODE_OFFTIME_MOFR:
-            case EXT_MODE_ONTIME_MOFR:
-            case EXT_MODE_OFFTIME_SASO:
-            case EXT_MODE_ONTIME_SASO:
-                getNightTimeStamp(mode)->incMinutes();
-                break;
-            #ifdef ALARM_OPTION_ENABLE
-                case STD_MODE_ALARM:
-                    alarm->incMinutes();
-                    alarm->resetShowAlarmTimer();
-                    DEBUG_PRINT(F("A is now "));
-                    DEBUG_PRINTLN(alarm->asString());
-                    DEBUG_FLUSH();
+                timeSetManually();
+                needsUpdateFromRtc = true;
+            }
+            rtc.readTime();
+            Serial.println(rtc.asString());
+            return;
+        case 'G':
+            if (serialConsole.nextWord(name, sizeof(name))) {
+                field = settings.findField(name);
+                if (field < 0) {
                     break;
-            #endif
-            case STD_MODE_BRIGHTNESS:
-                setDisplayBrighter();
-                break;
-            case EXT_MODE_LDR_MODE:
-                settings.toggleUseLdr();
-                DEBUG_PRINT(F("LDR is now "));
-                DEBUG_PRINTLN(settings.getUseLdr());
-                DEBUG_FLUSH();
-                break;
-            case EXT_MODE_LDR_NIGHT_MODE:
-                settings.toggleBlankByLdr();
-                break;
-            case EXT_MODE_LDR_NIGHT_THRESH:
-                settings.changeLdrBlankThreshold(1);
-                break;
-            case EXT_MODE_CORNERS:
-                settings.toggleRenderCornersCw();
-                break;
-            case EXT_MODE_ES_IST:
-                settings.toggleEsIst();
+                }
+                Serial.println(settings.getField(field));
+                return;
+            }
+            for (byte i = 0; i < settings.getFieldCount(); i++) {
+                Serial.print((const __FlashStringHelper*) settings.getFieldName(i));
+                Serial.print(' ');
+                Serial.println(settings.getField(i));
+            }
+            return;
+        case 'S': {
+            field = serialConsole.nextWord(name, sizeof(name)) ? settings.findField(name) : -1;
+            char timeShift = settings.getTimeShift();
+            if ((field < 0) || (serialConsole.nextNumbers(values, 1) < 1) || !serialConsole.atEnd()
+                || !settings.setField(field, values[0])) {
                 break;
-            #ifdef ALARM_OPTION_ENABLE
-                case EXT_MODE_ALARM_MELODY:
-                    alarm->decAlarmMelody();
-                    break;
-                case EXT_MODE_24:
-                    settings.toggle24hMode();
+            }
+            if (settings.getTimeShift() != timeShift) {
+                // wie im Menue: die Uhr wandert mit der Zeitverschiebung
+                rtc.readTime();
+                rtc.addSubHoursOverflow(settings.getTimeShift() - timeShift);
+                rtc.writeTime();
+                needsUpdateFromRtc = true;
+            }
+            settings.saveToEEPROM();
+            needsRender = true;
+            Serial.println(settings.getField(field));
+            return;
+        }
+        case 'A':
+            if (!serialConsole.atEnd()) {
+                count = serialConsole.nextNumbers(values, 5);
+                if ((count < 5) || !serialConsole.atEnd() || (values[0] < 0) || (values[0] >= SCHEDULE_ENTRIES)
+                    || (values[1] < 0) || (values[1] > 0xFF) || (values[2] < 0) || (values[2] > SCHEDULE_ALL_DAYS)
+                    || (values[3] < 0) || (values[3] > 23) || (values[4] < 0) || (values[4] > 59)) {
                     break;
-                case EXT_MODE_SNOOZE:
-                    settings.decSnooze();
+                }
+                if (!settings.setScheduleEntry(values[0], values[1], values[2], values[3], values[4])) {
                     break;
+                }
+                settings.saveToEEPROM();
+            }
+            for (byte i = 0; i < SCHEDULE_ENTRIES; i++) {
+                byte type = schedule->getType(i);
+                for (byte flag = SCHEDULE_FLAG_ENABLED; flag <= SCHEDULE_FLAG_12H; flag <<= 1) {
+                    if (schedule->hasFlag(i, flag)) {
+                        type |= flag;
+                    }
+                }
+                Serial.print(i);
+                Serial.print(' ');
+                Serial.print(type);
+                Serial.print(' ');
+                Serial.print(schedule->getDays(i));
+                Serial.print(' ');
+                Serial.print(schedule->getHours(i));
+                Serial.print(schedule->getMinutes(i) < 10 ? F(":0") : F(":"));
+                Serial.println(schedule->getMinutes(i));
+            }
+            return;
+        #ifdef DCF77_SENSOR_EXISTS
+            case 'R':
+                dcf77Helper.clear();
+                timeArbiter.resync();
+                dcf77.enable(true);
+                serialConsole.ok();
+                return;
+        #endif
+        case 'I':
+            Serial.print(F("mode "));
+            Serial.println(mode);
+            Serial.print(F("brightness "));
+            Serial.println(brightnessController.getBrightness());
+            #ifdef DCF77_SENSOR_EXISTS
+                Serial.print(F("dcf sync min "));
+                rtc.readTime();
+                Serial.println(rtc.getMinutesOfCentury() - dcf77.getDcf77LastSuccessSyncMinutes());
+                timeArbiter.dump(&rtc);
             #endif
-            case EXT_MODE_DCF_IS_INVERTED:
-                settings.toggleDcfSignalIsInverted();
-                break;
-            case EXT_MODE_LANGUAGE:
-                settings.incLanguage();
-                break;
-
-        }
-    }
-}
-
-/**
- * Korrekte Daten (auf Basis der Pruefbits) vom DCF-Empfaenger
- * bekommen. Sicherheitshalber gegen Zeitabstaende der RTC pruefen.
- */
-#ifdef DCF77_SENSOR_EXISTS
-    void manageNewDCF77Data() {
-        DEBUG_PRINT(F("Captured: "));
-        DEBUG_PRINTLN(dcf77.asString());
-        DEBUG_FLUSH();
-    
-        rtc.readTime();
-        dcf77Helper.addSample(&dcf77, &rtc);
-        // Stimmen die Abstaende im Array?
-        // Pruefung mit Datum!
-        if (dcf77Helper.samplesOk()) {
-            helperSeconds = 59;
-            rtc.setSeconds(0);
-            rtc.set(&dcf77, false);
-            rtc.addSubHoursOverflow(settings.getTimeShift());
-            rtc.writeTime();
-            DEBUG_PRINTLN(F("DCF77-Time (+/- Timeshift) written to RTC."));
-            DEBUG_FLUSH();
-            dcf77.setDcf77SuccessSync(&rtc);
-            // Spezialfall für 5-Tasten-Wortwecker mit A0-Hack: Der DCF77-Empfänger wird nach erfolgreichen Empfang aus-
-            // und der Näherungssensor wieder eingeschaltet.
-            #if defined(WW_5_BUTTONS) && defined(WW_5_BUTTONS_NEAR_SENSOR_ENABLE) && defined(WW_5_BUTTONS_ENABLE_NEARSENSOR_A0)
-                if (nightByTimeLock == 1)
-                    nightByTimeLock = 2;
+            Serial.print(F("uptime s "));
+            Serial.println(millis() / 1000);
+            Serial.print(F("boot ms "));
+            Serial.println(bootMillis);
+            Serial.print(F("free ram "));
+            Serial.println(freeRam());
+            #ifdef SLEEP_ENABLE
+                sleepScheduler.dump();
             #endif
-            if (mode == EXT_MODE_DCF_BLANK)
-                goToNormalDispOn();
-        } else {
-            DEBUG_PRINTLN(F("DCF77-Time trashed because wrong distances between timestamps."));
-            DEBUG_FLUSH();
-        }
+            taskScheduler.dump();
+            return;
+        #ifdef LOOP_PROFILER
+            case 'P':
+                loopProfiler.dump();
+                return;
+        #endif
+        #ifdef TRACE_ENABLE
+            case 'E':
+                eventTrace.dump();
+                return;
+        #endif
     }
+    serialConsole.error();
+}
 #endif
 
 boolean CheckAlarmAndSnoozeOrDeactivate() {
@@ -2161,7 +3261,7 @@ boolean CheckAlarmAndSnoozeOrDeactivate() {
 
 #if defined(WW_5_BUTTONS) && defined(WW_5_BUTTONS_NEAR_SENSOR_ENABLE)
     boolean CheckNearSensor() {
-        return (analogRead(A1) < 512);
+        return (analogSampler.getValue(PIN_NEAR_SENSOR) < 512);
     }
     
     void CheckNearSensorIn_Blank_Night() {
@@ -2186,9 +3286,85 @@ boolean CheckAlarmAndSnoozeOrDeactivate() {
     }
 #endif
 
+#ifdef RTC_NVRAM_HOT_VALUES
+/**
+ * Die haeufig wechselnden Werte in hotValues einsammeln.
+ */
+void collectHotValues() {
+    memset(&hotValues, 0, sizeof(hotValues));
+    #ifdef LDR_AUTOSCALE
+        hotValues.ldrAutoMin = settings.getLdrAutoMin();
+        hotValues.ldrAutoMax = settings.getLdrAutoMax();
+    #endif
+    #ifdef DCF77_SENSOR_EXISTS
+        TimeStamp* lastSync = dcf77.getDcf77SuccessSync();
+        hotValues.dcf77LastSync[0] = lastSync->getMinutes();
+        hotValues.dcf77LastSync[1] = lastSync->getHours();
+        hotValues.dcf77LastSync[2] = lastSync->getDate();
+        hotValues.dcf77LastSync[3] = lastSync->getMonth();
+        hotValues.dcf77LastSync[4] = lastSync->getYear();
+    #endif
+    hotValues.snoozeStart = 0xFFFF;
+    #ifdef ALARM_OPTION_ENABLE
+        if (alarm->isSnooze()) {
+            hotValues.snoozeStart = (rtc.getMinutesOfDay() + 1440 - alarm->getSnoozeElapsedMinutes() % 1440) % 1440;
+        }
+    #endif
+    hotValues.nightByTimeLock = nightByTimeLock;
+}
+
+/**
+ * Die haeufig wechselnden Werte ins RAM der DS1307 schreiben, aber nur, wenn
+ * sich etwas geaendert hat. Wird einmal pro Minute aufgerufen. Das RAM kennt
+ * keine Abnutzung, das EEPROM bleibt fuer die eigentlichen Einstellungen.
+ */
+void saveHotValues() {
+    collectHotValues();
+    if (memcmp(&hotValues, &hotValuesSaved, sizeof(hotValues)) != 0) {
+        rtc.writeNvram((byte*) &hotValues, sizeof(hotValues));
+        hotValuesSaved = hotValues;
+        DEBUG_PRINTLN(F("Hot values saved to RTC NVRAM."));
+        DEBUG_FLUSH();
+    }
+}
+
+/**
+ * Die haeufig wechselnden Werte beim Start aus dem RAM der DS1307 holen.
+ * Ist das RAM ungueltig (z. B. nach einem Batteriewechsel), bleiben die
+ * Werte aus dem EEPROM bzw. die Defaults.
+ */
+void loadHotValues() {
+    collectHotValues();
+    if (!rtc.readNvram((byte*) &hotValues, sizeof(hotValues))) {
+        return;
+    }
+    hotValuesSaved = hotValues;
+    #ifdef LDR_AUTOSCALE
+        settings.setLdrAutoMin(hotValues.ldrAutoMin);
+        settings.setLdrAutoMax(hotValues.ldrAutoMax);
+    #endif
+    #ifdef DCF77_SENSOR_EXISTS
+        TimeStamp lastSync(hotValues.dcf77LastSync[0], hotValues.dcf77LastSync[1], hotValues.dcf77LastSync[2], 0, hotValues.dcf77LastSync[3], hotValues.dcf77LastSync[4]);
+        dcf77.setDcf77SuccessSync(&lastSync);
+    #endif
+    #ifdef ALARM_OPTION_ENABLE
+        if (hotValues.snoozeStart != 0xFFFF) {
+            unsigned int elapsed = (rtc.getMinutesOfDay() + 1440 - hotValues.snoozeStart) % 1440;
+            if (elapsed < settings.getSnooze()) {
+                alarm->resumeSnooze(elapsed);
+            }
+        }
+    #endif
+    nightByTimeLock = hotValues.nightByTimeLock;
+    DEBUG_PRINTLN(F("Hot values loaded from RTC NVRAM."));
+    DEBUG_FLUSH();
+}
+#endif
+
 void resetCheckLdrThreshold_resetNightLock_needsUpdateFromRtc() {
     LdrThresholdZustand = 0;
     needsUpdateFromRtc = true;
+    needsRender = true;
     nightLock = false;
 }
 
@@ -2196,7 +3372,7 @@ byte checkLdrThreshold() {
     boolean retVal = 1;
     
     static unsigned long _wait;
-    byte _brightness = settings.getBrightness();
+    byte _brightness = brightnessController.getBrightness();
     byte _threshold = settings.getLdrBlankThreshold();
     switch (LdrThresholdZustand) {
         case 0: /*
@@ -2264,54 +3440,45 @@ TimeStamp* getNightTimeStamp(byte _mode) {
     return settings.getNightTimeStamp(_mode - EXT_MODE_OFFTIME_MOFR);
 }
 
-/*
- * Pointer auf NightTime abhängig vom Wochentag
- * _on == 0: offTime
- * _on == 1: onTime
+/**
+ * Die Intervalle der Nachtschaltung neu aufbauen, wenn sich der Zeitplan
+ * oder der Tag geaendert hat (Feiertage gelten fuer heute und morgen).
  */
-TimeStamp* getOffOnTimeDayOfWeek(byte _dayOfWeek, byte _on) {
-    switch (_dayOfWeek) {
-        default:  return settings.getNightTimeStamp(0 + _on);
-                  break;
-        case 6:
-        case 7:   return settings.getNightTimeStamp(2 + _on);
+void updateNightSchedule() {
+    static byte compiledDate = 0;
+    static byte compiledRevision;
+    Schedule* schedule = settings.getSchedule();
+    if ((compiledDate == rtc.getDate()) && (compiledRevision == schedule->getRevision())) {
+        return;
     }
+    compiledDate = rtc.getDate();
+    compiledRevision = schedule->getRevision();
+
+    byte holidayMask = 0;
+    #ifdef EVENTDAY
+        TimeStamp day(&rtc);
+        for (byte i = 0; i < 2; i++) {
+            for (byte j = 0; j < sizeof(holidays) / sizeof(holidays[0]); j++) {
+                if ((pgm_read_byte_near(&holidays[j][0]) == day.getDate()) && (pgm_read_byte_near(&holidays[j][1]) == day.getMonth())) {
+                    holidayMask |= 1 << ((rtc.getDayOfWeek() - 1 + i) % 7);
+                }
+            }
+            day.incDate(1, true);
+        }
+    #endif
+    nightSchedule.compile(schedule, holidayMask);
 }
 
 /**
  * Ist aktuell Nacht?
- * Veraltet: Bei glatt wird 0 nur dann zurückgegeben, wenn die aktuelle Uhrzeit
- *           exakt einer eingestellten Ausschaltzeit entspricht.
- *           Bei !glatt wird auch dann 0 zurückgegeben, wenn die aktuelle
- *           Uhrzeit innerhalb eines passenden Zeitbereichs liegt.
+ * Die Nachtfenster kommen aus dem Zeitplan (NightSchedule), bis zum
+ * naechsten Wechsel ist die Abfrage nur ein Vergleich.
+ *
+ * @return 0: Nacht (Display aus), 1: keine Nacht (Display an)
  */
 byte checkNight() {
-    byte retVal = 1; // no night, 1: Display on, 0: Display off
-  
-    byte dayOfWeek = rtc.getDayOfWeek();
-    unsigned int currentMinutesOfWeek = rtc.getMinutesOfWeek1();
-    for (byte i = 0; i <= 2; i++) {
-        byte dayOfWeek01 = dayOfWeek + i/2;
-        TimeStamp* TT0 = getOffOnTimeDayOfWeek(dayOfWeek01, i % 2);
-        TT0->setDayOfWeek(dayOfWeek01);
-        unsigned int nightMinutes0 = TT0->getMinutesOfWeek1();
-        if (!(i % 2)) {
-            TimeStamp* TT1 = getOffOnTimeDayOfWeek(dayOfWeek01, 1);
-            TT1->setDayOfWeek(dayOfWeek01);
-            unsigned int nightMinutes1 = TT1->getMinutesOfWeek1();
-            if (nightMinutes0 > nightMinutes1) {
-                nightMinutes0 -= 24 * 60;
-            }
-        }
-          // Falls glatt verwendet wird
-//        if ( ((!glatt) && (currentMinutesOfWeek >= nightMinutes0)) ||
-//              ((glatt) && (currentMinutesOfWeek == nightMinutes0)) ) {
-        if (currentMinutesOfWeek >= nightMinutes0) {
-            retVal = i % 2; // 0: offTime, 1: onTime
-        }
-    }
-   
-    return retVal;
+    updateNightSchedule();
+    return !nightSchedule.isNight(rtc.getMinutesOfWeek());
 }
 
 /**
@@ -2324,9 +3491,7 @@ void goToNight() {
 }
 
 boolean isCurrentModeDarkMode() {
-    if ( (mode == STD_MODE_BLANK) || (mode == STD_MODE_NIGHT) || (mode == EXT_MODE_DCF_BLANK) )
-        return true;
-    return false;
+    return getModeFlags(mode) & MODE_FLAG_DARK;
 }
 
 /**
@@ -2400,8 +3565,8 @@ void setDisplayDarker() {
 }
 
 /**
- * Das Display dunkler machen.
+ * Die manuelle Helligkeit aendern. Die Helligkeitsregelung blendet dann dorthin.
  */
 void changeDisplayBrightness(char change) {
-    ledDriver.setBrightness(settings.changeBrightness(change));
+    settings.changeBrightness(change);
 }
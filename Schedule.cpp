@@ -0,0 +1,241 @@
+/**
+ * Schedule
+ * Zeitplan fuer alle wiederkehrenden Zeitpunkte der Uhr: Weckzeiten
+ * (mit Wochentagen, einmalig oder wiederkehrend) und die Aus- und
+ * Einschaltzeiten der Nachtschaltung.
+ * Ein Eintrag besteht aus Typ mit Flags, Wochentagen, Stunden und Minuten
+ * und wird ueber das SettingsJournal im EEPROM gespeichert.
+ *
+ * Der naechste faellige Zeitpunkt (Minute der Woche) wird nur nach einer
+ * Aenderung oder nachdem er erreicht wurde neu berechnet. Die Pruefung pro
+ * Minute ist damit ein einziger Vergleich.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Revision, damit abgeleitete Plaene (NightSchedule) Aenderungen erkennen.
+ */
+#include "Schedule.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+/**
+ * Initialisierung, alle Eintraege sind leer.
+ */
+Schedule::Schedule() {
+    for (byte i = 0; i < SCHEDULE_ENTRIES; i++) {
+        set(i, SCHEDULE_TYPE_NONE, 0, 0, 0);
+    }
+    _nextDue = SCHEDULE_NEVER;
+    _lastMinute = SCHEDULE_NEVER;
+    _revision = 0;
+}
+
+/**
+ * Einen Eintrag setzen.
+ *
+ * @param type SCHEDULE_TYPE_* | SCHEDULE_FLAG_*
+ * @param days Wochentage als Bitmaske (Bit 0 = Montag).
+ */
+void Schedule::set(byte index, byte type, byte days, byte hours, byte minutes) {
+    _entries[index].type = type;
+    _entries[index].days = days & SCHEDULE_ALL_DAYS;
+    _entries[index].hours = hours % 24;
+    _entries[index].minutes = minutes % 60;
+    _changed();
+}
+
+byte Schedule::getType(byte index) {
+    return _entries[index].type & SCHEDULE_TYPE_MASK;
+}
+
+byte Schedule::getDays(byte index) {
+    return _entries[index].days;
+}
+
+byte Schedule::getHours(byte index) {
+    return _entries[index].hours;
+}
+
+byte Schedule::getMinutes(byte index) {
+    return _entries[index].minutes;
+}
+
+void Schedule::setTime(byte index, byte hours, byte minutes) {
+    if ((_entries[index].hours != hours) || (_entries[index].minutes != minutes)) {
+        set(index, _entries[index].type, _entries[index].days, hours, minutes);
+    }
+}
+
+void Schedule::setFlag(byte index, byte flag, boolean on) {
+    byte type = on ? (_entries[index].type | flag) : (_entries[index].type & ~flag);
+    if (type != _entries[index].type) {
+        _entries[index].type = type;
+        _changed();
+    }
+}
+
+boolean Schedule::hasFlag(byte index, byte flag) {
+    return (_entries[index].type & flag) != 0;
+}
+
+/**
+ * Einmal pro Minute aufrufen.
+ * Wurde die Uhr gestellt (die Minute ist nicht die naechste) oder der Plan
+ * geaendert, wird der naechste Zeitpunkt neu berechnet.
+ *
+ * @param minutesOfWeek Die aktuelle Minute der Woche (0 = Montag 0:00).
+ * @return Bitmaske der Eintraege, die jetzt faellig sind.
+ */
+byte Schedule::poll(unsigned int minutesOfWeek) {
+    if (minutesOfWeek == _lastMinute) {
+        return 0;
+    }
+    if (_isDirty || (minutesOfWeek != (_lastMinute + 1) % SCHEDULE_MINUTES_OF_WEEK)) {
+        _update(minutesOfWeek);
+    }
+    _lastMinute = minutesOfWeek;
+    if (minutesOfWeek != _nextDue) {
+        return 0;
+    }
+
+    byte due = 0;
+    for (byte i = 0; i < SCHEDULE_ENTRIES; i++) {
+        if (_minutesUntil(i, minutesOfWeek) == 0) {
+            due |= (1 << i);
+            if (_entries[i].type & SCHEDULE_FLAG_ONCE) {
+                _entries[i].type &= ~SCHEDULE_FLAG_ENABLED;
+                _revision++;
+            }
+        }
+    }
+    _update((minutesOfWeek + 1) % SCHEDULE_MINUTES_OF_WEEK);
+    DEBUG_PRINT(F("Schedule due: "));
+    DEBUG_PRINTLN(due);
+    return due;
+}
+
+/**
+ * Der naechste faellige Zeitpunkt (Minute der Woche) oder SCHEDULE_NEVER.
+ */
+unsigned int Schedule::getNextDue() {
+    return _nextDue;
+}
+
+/**
+ * Zaehlt bei jeder Aenderung eines Eintrags weiter.
+ */
+byte Schedule::getRevision() {
+    return _revision;
+}
+
+/**
+ * Bitmaske aller Eintraege eines Typs (fuer die Auswertung von poll()).
+ */
+byte Schedule::getTypeMask(byte type) {
+    byte mask = 0;
+    for (byte i = 0; i < SCHEDULE_ENTRIES; i++) {
+        if (getType(i) == type) {
+            mask |= (1 << i);
+        }
+    }
+    return mask;
+}
+
+/**
+ * Den Plan aus dem Journal lesen. Eintraege, die es dort nicht gibt,
+ * bleiben unveraendert.
+ *
+ * @return TRUE, wenn alle Eintraege im Journal gefunden wurden.
+ */
+boolean Schedule::load(SettingsJournal* journal, byte journalIndex) {
+    boolean complete = true;
+    byte value[SCHEDULE_ENTRY_SIZE];
+    for (byte i = 0; i < SCHEDULE_ENTRIES; i++) {
+        boolean found = true;
+        for (byte b = 0; b < SCHEDULE_ENTRY_SIZE; b++) {
+            found &= journal->read(journalIndex + i * SCHEDULE_ENTRY_SIZE + b, &value[b]);
+        }
+        if (found) {
+            set(i, value[0], value[1], value[2], value[3]);
+        } else {
+            complete = false;
+        }
+    }
+    return complete;
+}
+
+/**
+ * Den Plan ins Journal schreiben (nur geaenderte Werte werden geschrieben).
+ */
+void Schedule::save(SettingsJournal* journal, byte journalIndex) {
+    for (byte i = 0; i < SCHEDULE_ENTRIES; i++) {
+        byte index = journalIndex + i * SCHEDULE_ENTRY_SIZE;
+        journal->write(index, _entries[i].type);
+        journal->write(index + 1, _entries[i].days);
+        journal->write(index + 2, _entries[i].hours);
+        journal->write(index + 3, _entries[i].minutes);
+    }
+}
+
+void Schedule::_changed() {
+    _isDirty = true;
+    _revision++;
+}
+
+/**
+ * Den naechsten faelligen Zeitpunkt ab minutesOfWeek (einschliesslich) berechnen.
+ */
+void Schedule::_update(unsigned int minutesOfWeek) {
+    unsigned int next = SCHEDULE_NEVER;
+    for (byte i = 0; i < SCHEDULE_ENTRIES; i++) {
+        unsigned int until = _minutesUntil(i, minutesOfWeek);
+        if (until < next) {
+            next = until;
+        }
+    }
+    if (next != SCHEDULE_NEVER) {
+        next = (minutesOfWeek + next) % SCHEDULE_MINUTES_OF_WEEK;
+    }
+    _nextDue = next;
+    _isDirty = false;
+}
+
+/**
+ * Wie viele Minuten bis zum naechsten Zeitpunkt eines Eintrags (0 = jetzt)?
+ *
+ * @return SCHEDULE_NEVER, wenn der Eintrag leer oder abgeschaltet ist.
+ */
+unsigned int Schedule::_minutesUntil(byte index, unsigned int minutesOfWeek) {
+    ScheduleEntry* entry = &_entries[index];
+    if ((getType(index) == SCHEDULE_TYPE_NONE) || !(entry->type & SCHEDULE_FLAG_ENABLED) || (entry->days == 0)) {
+        return SCHEDULE_NEVER;
+    }
+
+    unsigned int minutesOfDay = entry->hours * 60 + entry->minutes;
+    byte times = 1;
+    if (entry->type & SCHEDULE_FLAG_12H) {
+        minutesOfDay %= 12 * 60;
+        times = 2;
+    }
+    unsigned int best = SCHEDULE_NEVER;
+    for (byte day = 0; day < 7; day++) {
+        if (!(entry->days & (1 << day))) {
+            continue;
+        }
+        for (byte t = 0; t < times; t++) {
+            unsigned int at = day * 24 * 60 + minutesOfDay + t * 12 * 60;
+            unsigned int until = (at + SCHEDULE_MINUTES_OF_WEEK - minutesOfWeek) % SCHEDULE_MINUTES_OF_WEEK;
+            if (until < best) {
+                best = until;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,96 @@
+/**
+ * Schedule
+ * Zeitplan fuer alle wiederkehrenden Zeitpunkte der Uhr: Weckzeiten
+ * (mit Wochentagen, einmalig oder wiederkehrend) und die Aus- und
+ * Einschaltzeiten der Nachtschaltung.
+ * Ein Eintrag besteht aus Typ mit Flags, Wochentagen, Stunden und Minuten
+ * und wird ueber das SettingsJournal im EEPROM gespeichert.
+ *
+ * Der naechste faellige Zeitpunkt (Minute der Woche) wird nur nach einer
+ * Aenderung oder nachdem er erreicht wurde neu berechnet. Die Pruefung pro
+ * Minute ist damit ein einziger Vergleich.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Revision, damit abgeleitete Plaene (NightSchedule) Aenderungen erkennen.
+ */
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "SettingsJournal.h"
+
+// Typen (untere Bits)
+#define SCHEDULE_TYPE_NONE      0
+#define SCHEDULE_TYPE_ALARM     1
+#define SCHEDULE_TYPE_NIGHT_OFF 2
+#define SCHEDULE_TYPE_NIGHT_ON  3
+#define SCHEDULE_TYPE_MASK      0x0F
+
+// Flags (obere Bits)
+#define SCHEDULE_FLAG_ENABLED   0x10
+// Nach dem Ausloesen abschalten
+#define SCHEDULE_FLAG_ONCE      0x20
+// Alle 12 Stunden (12-Stunden-Modus)
+#define SCHEDULE_FLAG_12H       0x40
+
+// Wochentage (Bit 0 = Montag ... Bit 6 = Sonntag)
+#define SCHEDULE_MO_FR    0x1F
+#define SCHEDULE_SA_SO    0x60
+#define SCHEDULE_ALL_DAYS 0x7F
+
+#define SCHEDULE_MINUTES_OF_WEEK (7 * 24 * 60)
+#define SCHEDULE_NEVER 0xFFFF
+
+// Bytes pro Eintrag im Journal
+#define SCHEDULE_ENTRY_SIZE 4
+
+struct ScheduleEntry {
+    byte type;
+    byte days;
+    byte hours;
+    byte minutes;
+};
+
+class Schedule {
+public:
+    Schedule();
+
+    void set(byte index, byte type, byte days, byte hours, byte minutes);
+    byte getType(byte index);
+    byte getDays(byte index);
+    byte getHours(byte index);
+    byte getMinutes(byte index);
+    void setTime(byte index, byte hours, byte minutes);
+    void setFlag(byte index, byte flag, boolean on);
+    boolean hasFlag(byte index, byte flag);
+
+    byte poll(unsigned int minutesOfWeek);
+    unsigned int getNextDue();
+    byte getRevision();
+    byte getTypeMask(byte type);
+
+    boolean load(SettingsJournal* journal, byte journalIndex);
+    void save(SettingsJournal* journal, byte journalIndex);
+
+private:
+    ScheduleEntry _entries[SCHEDULE_ENTRIES];
+    unsigned int _nextDue;
+    unsigned int _lastMinute;
+    boolean _isDirty;
+    byte _revision;
+
+    void _changed();
+
+    void _update(unsigned int minutesOfWeek);
+    unsigned int _minutesUntil(byte index, unsigned int minutesOfWeek);
+};
+
+#endif
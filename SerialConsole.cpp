@@ -0,0 +1,152 @@
+/**
+ * SerialConsole
+ * Eine einfache Kommandozeile ueber Serial: Stellen von Zeit und Datum,
+ * Lesen und Schreiben der Einstellungen, Ausgabe von Statistiken.
+ * Die Zeichen sammelt der Interrupt der UART im Empfangspuffer von Serial,
+ * poll() holt pro Durchlauf von loop() nur die schon angekommenen (hoechstens
+ * SERIAL_CONSOLE_CHARS_PER_POLL) ab und wartet nie. Ist eine Zeile komplett,
+ * liefert poll() TRUE und das Kommando kann mit getCommand(), nextNumber()
+ * und nextWord() zerlegt werden. Ausgefuehrt werden die Kommandos im Sketch.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "SerialConsole.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+SerialConsole::SerialConsole() {
+    _length = 0;
+    _pos = 0;
+    _overflow = false;
+}
+
+/**
+ * Die angekommenen Zeichen abholen.
+ *
+ * @return TRUE, wenn eine vollstaendige Zeile vorliegt. Eine zu lange Zeile
+ *         wird bis zum Zeilenende verworfen und mit ERR beantwortet.
+ */
+boolean SerialConsole::poll() {
+    for (byte i = 0; (i < SERIAL_CONSOLE_CHARS_PER_POLL) && Serial.available(); i++) {
+        char c = Serial.read();
+        if ((c == '\r') || (c == '\n')) {
+            if (_overflow) {
+                _overflow = false;
+                _length = 0;
+                error();
+                continue;
+            }
+            if (_length == 0) {
+                // Leerzeile oder das zweite Zeichen von CR LF
+                continue;
+            }
+            _line[_length] = 0;
+            _length = 0;
+            _pos = 0;
+            return true;
+        }
+        if (_length < SERIAL_CONSOLE_LINE_LENGTH) {
+            _line[_length++] = c;
+        } else {
+            _overflow = true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Das Kommando (erstes Zeichen der Zeile, als Grossbuchstabe).
+ */
+char SerialConsole::getCommand() {
+    _pos = 0;
+    _skipSeparators();
+    char c = _line[_pos];
+    if (c) {
+        _pos++;
+    }
+    return ((c >= 'a') && (c <= 'z')) ? c - 'a' + 'A' : c;
+}
+
+/**
+ * Die naechste (ggf. negative) Zahl lesen. Trennzeichen sind Leerzeichen,
+ * ':' und '.', damit Zeit und Datum wie gewohnt eingegeben werden koennen.
+ *
+ * @return FALSE, wenn keine Zahl folgt.
+ */
+boolean SerialConsole::nextNumber(int* value) {
+    _skipSeparators();
+    boolean negative = (_line[_pos] == '-');
+    if (negative) {
+        _pos++;
+    }
+    if ((_line[_pos] < '0') || (_line[_pos] > '9')) {
+        return false;
+    }
+    int number = 0;
+    while ((_line[_pos] >= '0') && (_line[_pos] <= '9')) {
+        number = number * 10 + (_line[_pos++] - '0');
+    }
+    *value = negative ? -number : number;
+    return true;
+}
+
+/**
+ * Bis zu count Zahlen lesen (z. B. hh:mm:ss oder dd.mm.yy).
+ *
+ * @return Die Anzahl der gelesenen Zahlen.
+ */
+byte SerialConsole::nextNumbers(int* values, byte count) {
+    byte i = 0;
+    while ((i < count) && nextNumber(&values[i])) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Das naechste Wort (bis zum naechsten Trennzeichen) in Kleinbuchstaben lesen.
+ *
+ * @return Die Laenge des Wortes, 0 am Zeilenende.
+ */
+byte SerialConsole::nextWord(char* word, byte size) {
+    _skipSeparators();
+    byte length = 0;
+    while (_line[_pos] && (_line[_pos] != ' ')) {
+        char c = _line[_pos++];
+        if (length < size - 1) {
+            word[length++] = ((c >= 'A') && (c <= 'Z')) ? c - 'A' + 'a' : c;
+        }
+    }
+    word[length] = 0;
+    return length;
+}
+
+/**
+ * Ist die Zeile komplett gelesen?
+ */
+boolean SerialConsole::atEnd() {
+    _skipSeparators();
+    return !_line[_pos];
+}
+
+void SerialConsole::ok() {
+    Serial.println(F("OK"));
+}
+
+void SerialConsole::error() {
+    Serial.println(F("ERR"));
+}
+
+void SerialConsole::_skipSeparators() {
+    while ((_line[_pos] == ' ') || (_line[_pos] == ':') || (_line[_pos] == '.') || (_line[_pos] == '\t')) {
+        _pos++;
+    }
+}
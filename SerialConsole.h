@@ -0,0 +1,55 @@
+/**
+ * SerialConsole
+ * Eine einfache Kommandozeile ueber Serial: Stellen von Zeit und Datum,
+ * Lesen und Schreiben der Einstellungen, Ausgabe von Statistiken.
+ * Die Zeichen sammelt der Interrupt der UART im Empfangspuffer von Serial,
+ * poll() holt pro Durchlauf von loop() nur die schon angekommenen (hoechstens
+ * SERIAL_CONSOLE_CHARS_PER_POLL) ab und wartet nie. Ist eine Zeile komplett,
+ * liefert poll() TRUE und das Kommando kann mit getCommand(), nextNumber()
+ * und nextWord() zerlegt werden. Ausgefuehrt werden die Kommandos im Sketch.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef SERIALCONSOLE_H
+#define SERIALCONSOLE_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+#ifndef SERIAL_CONSOLE_LINE_LENGTH
+    #define SERIAL_CONSOLE_LINE_LENGTH 24
+#endif
+#define SERIAL_CONSOLE_CHARS_PER_POLL 16
+
+class SerialConsole {
+public:
+    SerialConsole();
+
+    boolean poll();
+
+    char getCommand();
+    boolean nextNumber(int* value);
+    byte nextNumbers(int* values, byte count);
+    byte nextWord(char* word, byte size);
+    boolean atEnd();
+
+    void ok();
+    void error();
+
+private:
+    char _line[SERIAL_CONSOLE_LINE_LENGTH + 1];
+    byte _length;
+    byte _pos;
+    boolean _overflow;
+
+    void _skipSeparators();
+};
+
+#endif
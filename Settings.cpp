@@ -5,9 +5,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.3e
+ * @version  1.8
  * @created  23.1.2013
- * @updated  04.06.2016 (Ergänzungen und Änderungen von A. Mueller)
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
@@ -26,6 +26,14 @@
  *         - Speichern der Weckeinstellungen.
  *         - Speichern der Auto-Ldr-Werte
  * V 1.3e: - TimeShift-Funktionen angepasst, JumpToTime-Funktionen entfallen
+ * V 1.4:  - Speichern ueber ein Journal mit CRC (SettingsJournal), das die Schreibzugriffe ueber das EEPROM verteilt.
+ *         - Die Helligkeit ist nur noch die manuelle Helligkeit und wird immer gespeichert.
+ * V 1.5:  - Mit RTC_NVRAM_HOT_VALUES landen die LDR-Grenzen nicht mehr im EEPROM, sondern im RAM der DS1307.
+ *         - Die Schlummerzeit wird an den Wecker weitergegeben.
+ * V 1.6:  - Nacht- und Weckzeiten liegen in einem Zeitplan (Schedule) mit Wochentagen und weiteren Weckzeiten.
+ * V 1.7:  - Zugriff auf die Einstellungen ueber ihren Namen (fuer die SerialConsole).
+ * V 1.8:  - setScheduleEntry() lehnt unbekannte Typen und Flags ab, die Eintraege der
+ *           Nacht- und Weckzeiten aus dem Menue behalten ihren Typ.
  */
 #include "Settings.h"
 #include <EEPROM.h>
@@ -34,6 +42,46 @@
 //#define DEBUG
 #include "Debug.h"
 
+// Der Zeitplan liegt im Journal hinter den _savedValues und den alten Nacht- und Weckzeiten.
+#define SETTINGS_SCHEDULE_JOURNAL_INDEX 32
+
+// Anzahl der Werte fuer die Weckzeit hinter den Nachtzeiten (Stunden und Minuten)
+#ifdef ALARM_OPTION_ENABLE
+    #define NIGHTTIMES_FOR_END 2
+#else
+    #define NIGHTTIMES_FOR_END 0
+#endif
+
+/**
+ * Die ueber ihren Namen erreichbaren Einstellungen: Name, Index in
+ * _savedValues und erlaubter Bereich.
+ */
+struct SettingsField {
+    char name[10];
+    byte index;
+    char min;
+    char max;
+};
+
+const SettingsField settingsFields[] PROGMEM = {
+    {"language",  2,   0, LANGUAGE_COUNT},
+    {"cornerscw", 3,   0, 1},
+    {"useldr",    8,   0, 1},
+    {"blankldr",  9,   0, 1},
+    {"ldrthresh", 10,  0, 99},
+    {"bright",    11,  0, 99},
+    {"dcfinv",    12,  0, 1},
+    {"timeshift", 13, -13, 13},
+    {"esist",     14,  0, 1},
+#ifdef ALARM_OPTION_ENABLE
+    {"alarm",     15,  0, 1},
+    // zu grosse Werte setzt Alarm::setAlarmMelody() auf 0
+    {"melody",    16,  0, 99},
+#endif
+    {"24h",       17,  0, 1},
+    {"snooze",    18,  0, 30}
+};
+
 /**
  *  Konstruktor.
  */
@@ -86,6 +134,14 @@ Settings::Settings() {
         _NightTimesAndAlarm[4] = _alarm;
     #endif
 
+    _schedule.set(0, SCHEDULE_TYPE_NIGHT_OFF | SCHEDULE_FLAG_ENABLED, SCHEDULE_MO_FR, offTimeMoFrHours, offTimeMoFrMinutes);
+    _schedule.set(1, SCHEDULE_TYPE_NIGHT_ON | SCHEDULE_FLAG_ENABLED, SCHEDULE_MO_FR, onTimeMoFrHours, onTimeMoFrMinutes);
+    _schedule.set(2, SCHEDULE_TYPE_NIGHT_OFF | SCHEDULE_FLAG_ENABLED, SCHEDULE_SA_SO, offTimeSaSoHours, offTimeSaSoMinutes);
+    _schedule.set(3, SCHEDULE_TYPE_NIGHT_ON | SCHEDULE_FLAG_ENABLED, SCHEDULE_SA_SO, onTimeSaSoHours, onTimeSaSoMinutes);
+    #ifdef ALARM_OPTION_ENABLE
+        _schedule.set(SCHEDULE_ENTRY_ALARM, SCHEDULE_TYPE_ALARM | SCHEDULE_FLAG_ENABLED | SCHEDULE_FLAG_12H, SCHEDULE_ALL_DAYS, alarmHours, alarmMinutes);
+    #endif
+
     if (!_savedValues[8]) _savedValues[9] = false;
 
     // Versuche alte Einstellungen zu laden...
@@ -271,6 +327,7 @@ boolean Settings::get24hMode() {
 
 void Settings::toggle24hMode() {
     _savedValues[17] = !_savedValues[17];
+    _schedule.setFlag(SCHEDULE_ENTRY_ALARM, SCHEDULE_FLAG_12H, !_savedValues[17]);
 }
 
 unsigned int Settings::getSnooze() {
@@ -282,6 +339,9 @@ void Settings::incSnooze() {
         _savedValues[18] = 0;
     else
         _savedValues[18] = _savedValues[18]+5;
+    #ifdef ALARM_OPTION_ENABLE
+        _alarm->setSnoozeMinutes(_savedValues[18]);
+    #endif
 }
 
 void Settings::decSnooze() {
@@ -289,6 +349,9 @@ void Settings::decSnooze() {
         _savedValues[18] = 30;
     else
         _savedValues[18] = _savedValues[18]-5;
+    #ifdef ALARM_OPTION_ENABLE
+        _alarm->setSnoozeMinutes(_savedValues[18]);
+    #endif
 }
 
 /**
@@ -308,89 +371,222 @@ TimeStamp* Settings::getNightTimeStamp(byte _position) {
 }
 
 /**
- * Die Einstellungen laden.
+ * Der Zeitplan mit Nacht- und Weckzeiten. Die Zeiten aus getNightTimeStamp()
+ * werden beim Speichern uebernommen.
+ */
+Schedule* Settings::getSchedule() {
+    return &_schedule;
+}
+
+/**
+ * Einen Eintrag im Zeitplan setzen. Bei den Eintraegen 0 bis 4 wird auch
+ * der TimeStamp aus getNightTimeStamp() nachgezogen, sonst wuerde
+ * saveToEEPROM() die alte Zeit zurueckschreiben. Ihr Typ ist fest, nur die
+ * Flags duerfen sich aendern.
+ *
+ * @return FALSE bei unbekanntem Typ oder Flag oder einem anderen Typ fuer
+ *         die Eintraege 0 bis 4 (dann bleibt der Eintrag unveraendert).
+ */
+boolean Settings::setScheduleEntry(byte index, byte type, byte days, byte hours, byte minutes) {
+    if (((type & SCHEDULE_TYPE_MASK) > SCHEDULE_TYPE_NIGHT_ON)
+        || (type & ~(SCHEDULE_TYPE_MASK | SCHEDULE_FLAG_ENABLED | SCHEDULE_FLAG_ONCE | SCHEDULE_FLAG_12H))) {
+        return false;
+    }
+    boolean fixed = (index < 4 + NIGHTTIMES_FOR_END / 2);
+    if (fixed && ((type & SCHEDULE_TYPE_MASK) != _schedule.getType(index))) {
+        return false;
+    }
+    _schedule.set(index, type, days, hours, minutes);
+    if (fixed) {
+        _NightTimesAndAlarm[index]->setHours(_schedule.getHours(index));
+        _NightTimesAndAlarm[index]->setMinutes(_schedule.getMinutes(index));
+    }
+    return true;
+}
+
+/**
+ * Die Einstellungen ueber ihren Namen (siehe settingsFields).
+ */
+byte Settings::getFieldCount() {
+    return sizeof(settingsFields) / sizeof(settingsFields[0]);
+}
+
+/**
+ * Der Name einer Einstellung (im Flash, z. B. fuer Serial.print((const __FlashStringHelper*) ...)).
+ */
+const char* Settings::getFieldName(byte field) {
+    return settingsFields[field].name;
+}
+
+/**
+ * @return Die Nummer der Einstellung oder -1, wenn es den Namen nicht gibt.
+ */
+char Settings::findField(const char* name) {
+    for (byte i = 0; i < getFieldCount(); i++) {
+        if (!strcmp_P(name, settingsFields[i].name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int Settings::getField(byte field) {
+    _fetchAlarmValues();
+    byte value = _savedValues[pgm_read_byte_near(&settingsFields[field].index)];
+    if ((char) pgm_read_byte_near(&settingsFields[field].min) < 0) {
+        return (char) value;
+    }
+    return value;
+}
+
+/**
+ * Eine Einstellung setzen (ohne zu speichern).
+ *
+ * @return FALSE, wenn der Wert ausserhalb des erlaubten Bereichs liegt.
+ */
+boolean Settings::setField(byte field, int value) {
+    if ((value < (char) pgm_read_byte_near(&settingsFields[field].min))
+        || (value > (char) pgm_read_byte_near(&settingsFields[field].max))) {
+        return false;
+    }
+    byte index = pgm_read_byte_near(&settingsFields[field].index);
+    _fetchAlarmValues();
+    _savedValues[index] = value;
+    if ((index == 8) && !value) {
+        // wie toggleUseLdr()
+        _savedValues[9] = false;
+        resetLdrLimits();
+    }
+    _applyValues();
+    return true;
+}
+
+/**
+ * Die Einstellungen laden. Gibt es noch kein Journal, werden die
+ * Einstellungen im alten Format (ab Adresse 0) uebernommen.
  */
 void Settings::loadFromEEPROM() {
-    if ((EEPROM.read(0) == _savedValues[0]) && (EEPROM.read(1) == _savedValues[1])) {
-        // es sind gueltige Einstellungen vorhanden...
-        for (byte i = 0; i < sizeof(_savedValues)/sizeof(_savedValues[0]); i++) {
-            _savedValues[i] = EEPROM.read(i);   
+    byte magicNumber;
+    byte version;
+    if (_journal.begin()) {
+        if (_journal.read(0, &magicNumber) && (magicNumber == _savedValues[0])
+            && _journal.read(1, &version) && (version == _savedValues[1])) {
+            // es sind gueltige Einstellungen vorhanden, fehlende Werte bleiben auf dem Default...
+            for (byte i = 0; i < sizeof(_savedValues)/sizeof(_savedValues[0]); i++) {
+                _journal.read(i, &_savedValues[i]);
+            }
+            if (_schedule.load(&_journal, SETTINGS_SCHEDULE_JOURNAL_INDEX)) {
+                _syncSchedule(false);
+            } else {
+                // Journal von V 1.5: Nacht- und Weckzeiten einzeln
+                _loadNightTimesAndAlarm();
+                _syncSchedule(true);
+            }
         }
-        _loadSaveNightTimesAndAlarm(false);
+    } else if (_loadLegacy()) {
+        saveToEEPROM();
     }
+    _applyValues();
+}
+
+/**
+ * Die geladenen (oder ueber setField() gesetzten) Werte an Zeitplan und Wecker weitergeben.
+ */
+void Settings::_applyValues() {
+    _schedule.setFlag(SCHEDULE_ENTRY_ALARM, SCHEDULE_FLAG_12H, !_savedValues[17]);
     #ifdef ALARM_OPTION_ENABLE
         _alarm->setEnable(_savedValues[15]);
         _alarm->setAlarmMelody(_savedValues[16]);
+        _alarm->setSnoozeMinutes(_savedValues[18]);
     #endif
 }
 
 /**
- * Die Einstellungen speichern.
+ * Der Wecker haelt Ein/Aus und Melodie selbst (Menue), hier in _savedValues uebernehmen.
  */
-void Settings::saveToEEPROM() {
+void Settings::_fetchAlarmValues() {
     #ifdef ALARM_OPTION_ENABLE
         _savedValues[15] = _alarm->isEnable();
         _savedValues[16] = _alarm->getAlarmMelody();
     #endif
+}
+
+/**
+ * Die Einstellungen speichern. Nur geaenderte Werte landen im Journal.
+ */
+void Settings::saveToEEPROM() {
+    _fetchAlarmValues();
     for (byte i = 0; i < sizeof(_savedValues)/sizeof(_savedValues[0]); i++) {
-        // _brightness wird nur gespeichert, wenn der LDR _NICHT_ verwendet wird.
-        DEBUG_PRINTLN();
-        DEBUG_PRINT(F(" - "));
-        DEBUG_PRINT(i);
-        DEBUG_PRINTLN(F(" - "));
-        DEBUG_PRINT(F("EEPROM: "));
-        DEBUG_PRINTLN(EEPROM.read(i));
-        DEBUG_PRINT(F("   RAM: "));
-        DEBUG_PRINT(_savedValues[i]);
-        if ( (i != 11) || !_savedValues[8] )
-            if (EEPROM.read(i) != _savedValues[i]) {
-                EEPROM.write(i, _savedValues[i]);
-                DEBUG_PRINT(F(" Speichern!!"));
-            }    
+        #ifdef RTC_NVRAM_HOT_VALUES
+            // Die LDR-Grenzen aendern sich oft, sie liegen im RAM der Echtzeituhr.
+            if ((i >= 4) && (i <= 7)) {
+                continue;
+            }
+        #endif
+        _journal.write(i, _savedValues[i]);
     }
-    _loadSaveNightTimesAndAlarm(true);
+    _syncSchedule(true);
+    _schedule.save(&_journal, SETTINGS_SCHEDULE_JOURNAL_INDEX);
 }
 
-void Settings::_loadSaveNightTimesAndAlarm(boolean save) {
+/**
+ * Die Nacht- und Weckzeiten im Journal von V 1.5 (hinter den _savedValues,
+ * jeweils Stunden und Minuten) lesen. Geschrieben wird nur noch der Zeitplan.
+ */
+void Settings::_loadNightTimesAndAlarm() {
     byte forStart = sizeof(_savedValues)/sizeof(_savedValues[0]);
-    #ifdef ALARM_OPTION_ENABLE
-        #define NIGHTTIMES_FOR_END 2
-    #else
-        #define NIGHTTIMES_FOR_END 0
-    #endif
     byte forEnd = forStart + 8 + NIGHTTIMES_FOR_END;
-    byte getValue;
+    byte value;
     for (byte i = forStart; i < forEnd; i++) {
-        byte value = EEPROM.read(i);
-        byte i_forStart   = i - forStart;
-        byte i_forStart_2 = i_forStart / 2;
-        if (!(i_forStart % 2)) {
-            // Hours
-            if (save) {
-                getValue = _NightTimesAndAlarm[i_forStart_2]->getHours();
+        TimeStamp* timeStamp = _NightTimesAndAlarm[(i - forStart) / 2];
+        if (_journal.read(i, &value)) {
+            if (!((i - forStart) % 2)) {
+                timeStamp->setHours(value);
             } else {
-                _NightTimesAndAlarm[i_forStart_2]->setHours(value);
+                timeStamp->setMinutes(value);
             }
+        }
+    }
+}
+
+/**
+ * Die Zeiten aus getNightTimeStamp() (das Menue stellt dort) und die
+ * Eintraege 0 bis 4 im Zeitplan abgleichen.
+ *
+ * @param toSchedule TRUE: TimeStamps -> Zeitplan, FALSE: Zeitplan -> TimeStamps.
+ */
+void Settings::_syncSchedule(boolean toSchedule) {
+    for (byte i = 0; i < 4 + NIGHTTIMES_FOR_END / 2; i++) {
+        if (toSchedule) {
+            _schedule.setTime(i, _NightTimesAndAlarm[i]->getHours(), _NightTimesAndAlarm[i]->getMinutes());
         } else {
-            // Minutes
-            if (save) {
-                getValue = _NightTimesAndAlarm[i_forStart_2]->getMinutes();
-            } else {
-                _NightTimesAndAlarm[i_forStart_2]->setMinutes(value);
-            }
-            
+            _NightTimesAndAlarm[i]->setHours(_schedule.getHours(i));
+            _NightTimesAndAlarm[i]->setMinutes(_schedule.getMinutes(i));
         }
-        DEBUG_PRINTLN();
-        DEBUG_PRINT(F(" - "));
-        DEBUG_PRINT(i);
-        DEBUG_PRINTLN(F(" - "));
-        DEBUG_PRINT(F("EEPROM: "));
-        DEBUG_PRINTLN(EEPROM.read(i));
-        DEBUG_PRINT(F("   RAM: "));
-        DEBUG_PRINT(getValue);
-        if (save && value != getValue) {
-            EEPROM.write(i, getValue);
-            DEBUG_PRINT(F(" Speichern!!"));
+    }
+}
+
+/**
+ * Die Einstellungen im alten Format (feste Adressen ab 0) lesen.
+ *
+ * @return TRUE, wenn dort gueltige Einstellungen lagen.
+ */
+boolean Settings::_loadLegacy() {
+    if ((EEPROM.read(0) != _savedValues[0]) || (EEPROM.read(1) != _savedValues[1])) {
+        return false;
+    }
+    byte count = sizeof(_savedValues)/sizeof(_savedValues[0]);
+    for (byte i = 0; i < count; i++) {
+        _savedValues[i] = EEPROM.read(i);
+    }
+    for (byte i = 0; i < 8 + NIGHTTIMES_FOR_END; i++) {
+        if (!(i % 2)) {
+            _NightTimesAndAlarm[i / 2]->setHours(EEPROM.read(count + i));
+        } else {
+            _NightTimesAndAlarm[i / 2]->setMinutes(EEPROM.read(count + i));
         }
     }
+    DEBUG_PRINTLN(F("Settings: legacy EEPROM layout imported."));
+    DEBUG_FLUSH();
+    return true;
 }
@@ -5,9 +5,9 @@
  *
  * @mc       Arduino/RBBB
  * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
- * @version  1.3e
+ * @version  1.8
  * @created  23.1.2013
- * @updated  04.06.2016 (Ergänzungen und Änderungen von A. Mueller)
+ * @updated  19.10.2026
  *
  * Versionshistorie:
  * V 1.0:  - Erstellt.
@@ -26,6 +26,14 @@
  *         - Speichern der Weckeinstellungen.
  *         - Speichern der Auto-Ldr-Werte
  * V 1.3e: - TimeShift-Funktionen angepasst, JumpToTime-Funktionen entfallen
+ * V 1.4:  - Speichern ueber ein Journal mit CRC (SettingsJournal), das die Schreibzugriffe ueber das EEPROM verteilt.
+ *         - Die Helligkeit ist nur noch die manuelle Helligkeit und wird immer gespeichert.
+ * V 1.5:  - Mit RTC_NVRAM_HOT_VALUES landen die LDR-Grenzen nicht mehr im EEPROM, sondern im RAM der DS1307.
+ *         - Die Schlummerzeit wird an den Wecker weitergegeben.
+ * V 1.6:  - Nacht- und Weckzeiten liegen in einem Zeitplan (Schedule) mit Wochentagen und weiteren Weckzeiten.
+ * V 1.7:  - Zugriff auf die Einstellungen ueber ihren Namen (fuer die SerialConsole).
+ * V 1.8:  - setScheduleEntry() lehnt unbekannte Typen und Flags ab, die Eintraege der
+ *           Nacht- und Weckzeiten aus dem Menue behalten ihren Typ.
  */
 #ifndef SETTINGS_H
 #define SETTINGS_H
@@ -36,6 +44,15 @@
     #include "Alarm.h"
 #endif
 #include "TimeStamp.h"
+#include "SettingsJournal.h"
+#include "Schedule.h"
+
+/*
+ * Die Eintraege 0 bis 4 im Zeitplan gehoeren zu getNightTimeStamp(),
+ * ab SCHEDULE_ENTRY_EXTRA sind weitere Weckzeiten moeglich.
+ */
+#define SCHEDULE_ENTRY_ALARM 4
+#define SCHEDULE_ENTRY_EXTRA 5
 
 class Settings {
 public:
@@ -87,6 +104,14 @@ public:
     void decSnooze();
     
     TimeStamp* getNightTimeStamp(byte _position);
+    Schedule* getSchedule();
+    boolean setScheduleEntry(byte index, byte type, byte days, byte hours, byte minutes);
+
+    byte getFieldCount();
+    const char* getFieldName(byte field);
+    char findField(const char* name);
+    int getField(byte field);
+    boolean setField(byte field, int value);
 
     void loadFromEEPROM();
     void saveToEEPROM();
@@ -95,11 +120,17 @@ private:
     byte _savedValues[19]; // 17 -> 19 -TF4
 
     TimeStamp* _NightTimesAndAlarm[5];
+    SettingsJournal _journal;
+    Schedule _schedule;
     #ifdef ALARM_OPTION_ENABLE
         Alarm* _alarm;
     #endif
 
-    void _loadSaveNightTimesAndAlarm(boolean save);
+    void _applyValues();
+    void _fetchAlarmValues();
+    void _loadNightTimesAndAlarm();
+    void _syncSchedule(boolean toSchedule);
+    boolean _loadLegacy();
 };
 
 #endif
@@ -0,0 +1,199 @@
+/**
+ * SettingsJournal
+ * Speichert Einstellungen (Index/Wert-Paare) als fortlaufendes Journal im
+ * EEPROM. Ein Eintrag besteht aus Folgenummer, Index, Wert und CRC. Es wird
+ * nur geschrieben, was sich geaendert hat, und zwar immer in den naechsten
+ * freien (ueberholten) Platz. Dadurch verteilen sich die Schreibzugriffe
+ * gleichmaessig ueber den ganzen Bereich. Der aktuelle Eintrag eines Index
+ * wird nie ueberschrieben, bricht der Strom beim Schreiben weg, gilt
+ * einfach der alte Wert weiter.
+ * Beim Start wird das Journal einmal gelesen und pro Index der Platz mit
+ * dem neuesten gueltigen Eintrag gemerkt.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "SettingsJournal.h"
+#include <EEPROM.h>
+#include <util/crc16.h>
+
+// #define DEBUG
+#include "Debug.h"
+
+/*
+ * Die Folgenummer laeuft ueber, verglichen wird deshalb nur die Differenz.
+ * Aktuelle Eintraege, die aelter als SETTINGS_JOURNAL_REFRESH_AGE sind,
+ * werden beim Vorbeikommen neu geschrieben, damit der Vergleich eindeutig bleibt.
+ */
+#define SETTINGS_JOURNAL_REFRESH_AGE 0x4000
+#define SETTINGS_JOURNAL_IS_NEWER(a, b) ((int16_t) ((a) - (b)) > 0)
+
+/**
+ * Initialisierung.
+ */
+SettingsJournal::SettingsJournal() {
+    for (byte i = 0; i < SETTINGS_JOURNAL_MAX_INDEX; i++) {
+        _slot[i] = SETTINGS_JOURNAL_NO_SLOT;
+    }
+    _sequence = 0;
+    _next = 0;
+}
+
+/**
+ * Das Journal lesen.
+ *
+ * @return TRUE, wenn mindestens ein gueltiger Eintrag gefunden wurde.
+ */
+boolean SettingsJournal::begin() {
+    unsigned int seqOf[SETTINGS_JOURNAL_MAX_INDEX];
+    boolean found = false;
+    unsigned int newest = 0;
+    byte newestSlot = SETTINGS_JOURNAL_SLOTS - 1;
+    unsigned int sequence;
+    byte index;
+    byte value;
+
+    for (byte i = 0; i < SETTINGS_JOURNAL_MAX_INDEX; i++) {
+        _slot[i] = SETTINGS_JOURNAL_NO_SLOT;
+    }
+    for (byte s = 0; s < SETTINGS_JOURNAL_SLOTS; s++) {
+        if (!_readRecord(s, &sequence, &index, &value)) {
+            continue;
+        }
+        if ((_slot[index] == SETTINGS_JOURNAL_NO_SLOT) || SETTINGS_JOURNAL_IS_NEWER(sequence, seqOf[index])) {
+            _slot[index] = s;
+            seqOf[index] = sequence;
+        }
+        if (!found || SETTINGS_JOURNAL_IS_NEWER(sequence, newest)) {
+            newest = sequence;
+            newestSlot = s;
+        }
+        found = true;
+    }
+
+    _sequence = newest + 1;
+    _next = newestSlot + 1;
+    if (_next >= SETTINGS_JOURNAL_SLOTS) {
+        _next = 0;
+    }
+
+    DEBUG_PRINT(F("SettingsJournal: slots: "));
+    DEBUG_PRINT(SETTINGS_JOURNAL_SLOTS);
+    DEBUG_PRINT(F(" next: "));
+    DEBUG_PRINT(_next);
+    DEBUG_PRINT(F(" sequence: "));
+    DEBUG_PRINTLN(_sequence);
+    DEBUG_FLUSH();
+
+    return found;
+}
+
+/**
+ * Den aktuellen Wert eines Index lesen.
+ *
+ * @return FALSE, wenn es fuer den Index keinen Eintrag gibt.
+ */
+boolean SettingsJournal::read(byte index, byte* value) {
+    if ((index >= SETTINGS_JOURNAL_MAX_INDEX) || (_slot[index] == SETTINGS_JOURNAL_NO_SLOT)) {
+        return false;
+    }
+    *value = EEPROM.read(_address(_slot[index]) + 3);
+    return true;
+}
+
+/**
+ * Einen Wert schreiben, aber nur, wenn er sich geaendert hat.
+ */
+void SettingsJournal::write(byte index, byte value) {
+    byte current;
+    if (index >= SETTINGS_JOURNAL_MAX_INDEX) {
+        return;
+    }
+    if (read(index, &current) && (current == value)) {
+        return;
+    }
+    _slot[index] = _append(index, value);
+}
+
+/**
+ * Einen Eintrag in den naechsten freien Platz schreiben. Plaetze mit dem
+ * aktuellen Eintrag eines Index werden uebersprungen (zu alte vorher erneuert).
+ * Der Index wird zuletzt geschrieben, ein halb geschriebener Eintrag ist
+ * damit ungueltig.
+ *
+ * @return Der Platz des neuen Eintrags.
+ */
+byte SettingsJournal::_append(byte index, byte value) {
+    for (;;) {
+        byte s = _next;
+        _next++;
+        if (_next >= SETTINGS_JOURNAL_SLOTS) {
+            _next = 0;
+        }
+
+        unsigned int sequence;
+        byte liveIndex;
+        byte liveValue;
+        if (_readRecord(s, &sequence, &liveIndex, &liveValue) && (_slot[liveIndex] == s)) {
+            if ((uint16_t) (_sequence - sequence) > SETTINGS_JOURNAL_REFRESH_AGE) {
+                _slot[liveIndex] = _append(liveIndex, liveValue);
+            }
+            continue;
+        }
+
+        // Erst den Index ungueltig machen, dann den Eintrag schreiben und
+        // zuletzt den Index. Bis dahin ist der Platz kein gueltiger Eintrag.
+        int address = _address(s);
+        EEPROM.update(address + 2, 0xFF);
+        EEPROM.update(address, lowByte(_sequence));
+        EEPROM.update(address + 1, highByte(_sequence));
+        EEPROM.update(address + 3, value);
+        EEPROM.update(address + 4, _crc(_sequence, index, value));
+        EEPROM.update(address + 2, index);
+        _sequence++;
+
+        DEBUG_PRINT(F("SettingsJournal: slot "));
+        DEBUG_PRINT(s);
+        DEBUG_PRINT(F(" index "));
+        DEBUG_PRINT(index);
+        DEBUG_PRINT(F(" value "));
+        DEBUG_PRINTLN(value);
+        DEBUG_FLUSH();
+
+        return s;
+    }
+}
+
+/**
+ * Einen Eintrag lesen und pruefen.
+ */
+boolean SettingsJournal::_readRecord(byte slot, unsigned int* sequence, byte* index, byte* value) {
+    int address = _address(slot);
+    *sequence = EEPROM.read(address) | (EEPROM.read(address + 1) << 8);
+    *index = EEPROM.read(address + 2);
+    *value = EEPROM.read(address + 3);
+    return (*index < SETTINGS_JOURNAL_MAX_INDEX) && (EEPROM.read(address + 4) == _crc(*sequence, *index, *value));
+}
+
+/**
+ * CRC-8 (Dallas/Maxim) ueber einen Eintrag. Der Startwert ist nicht 0,
+ * damit ein geloeschtes oder genulltes EEPROM keinen gueltigen Eintrag ergibt.
+ */
+byte SettingsJournal::_crc(unsigned int sequence, byte index, byte value) {
+    byte crc = 0xB8;
+    crc = _crc_ibutton_update(crc, lowByte(sequence));
+    crc = _crc_ibutton_update(crc, highByte(sequence));
+    crc = _crc_ibutton_update(crc, index);
+    crc = _crc_ibutton_update(crc, value);
+    return crc;
+}
+
+int SettingsJournal::_address(byte slot) {
+    return SETTINGS_JOURNAL_EEPROM_START + slot * SETTINGS_JOURNAL_RECORD_SIZE;
+}
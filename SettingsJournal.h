@@ -0,0 +1,53 @@
+/**
+ * SettingsJournal
+ * Speichert Einstellungen (Index/Wert-Paare) als fortlaufendes Journal im
+ * EEPROM. Ein Eintrag besteht aus Folgenummer, Index, Wert und CRC. Es wird
+ * nur geschrieben, was sich geaendert hat, und zwar immer in den naechsten
+ * freien (ueberholten) Platz. Dadurch verteilen sich die Schreibzugriffe
+ * gleichmaessig ueber den ganzen Bereich. Der aktuelle Eintrag eines Index
+ * wird nie ueberschrieben, bricht der Strom beim Schreiben weg, gilt
+ * einfach der alte Wert weiter.
+ * Beim Start wird das Journal einmal gelesen und pro Index der Platz mit
+ * dem neuesten gueltigen Eintrag gemerkt.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef SETTINGSJOURNAL_H
+#define SETTINGSJOURNAL_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+// Groesse eines Eintrags: Folgenummer (2), Index, Wert, CRC
+#define SETTINGS_JOURNAL_RECORD_SIZE 5
+#define SETTINGS_JOURNAL_SLOTS ((SETTINGS_JOURNAL_EEPROM_END - SETTINGS_JOURNAL_EEPROM_START) / SETTINGS_JOURNAL_RECORD_SIZE)
+#define SETTINGS_JOURNAL_NO_SLOT 0xFF
+
+class SettingsJournal {
+public:
+    SettingsJournal();
+
+    boolean begin();
+    boolean read(byte index, byte* value);
+    void write(byte index, byte value);
+
+private:
+    // Platz des aktuellen Eintrags je Index
+    byte _slot[SETTINGS_JOURNAL_MAX_INDEX];
+    unsigned int _sequence;
+    byte _next;
+
+    int _address(byte slot);
+    boolean _readRecord(byte slot, unsigned int* sequence, byte* index, byte* value);
+    byte _crc(unsigned int sequence, byte index, byte value);
+    byte _append(byte index, byte value);
+};
+
+#endif
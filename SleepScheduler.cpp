@@ -0,0 +1,80 @@
+/**
+ * SleepScheduler
+ * Legt den ATmega zwischen zwei Durchlaeufen von loop() schlafen, solange
+ * die Anzeige aus ist (Nacht, Blank, DCF-Blank). Geschlafen wird im Modus
+ * IDLE: Jeder Interrupt weckt wieder auf, also der Sekundentakt der RTC
+ * (INT0), die Tasten und der IR-Empfaenger (Pin-Change), die UART und
+ * spaetestens der Ueberlauf von Timer0 (alle 1,024ms). Der startet auch den
+ * AnalogSampler (LDR, analoges DCF77-Signal), so wird DCF77 weiterhin ueber
+ * die ganze Sekunde gleichmaessig abgetastet und millis() laeuft weiter.
+ * Nebenbei wird gezaehlt, wie lange die Uhr geschlafen hat.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "SleepScheduler.h"
+#include <avr/sleep.h>
+
+// #define DEBUG
+#include "Debug.h"
+
+SleepScheduler::SleepScheduler() {
+    reset();
+}
+
+/**
+ * Bis zum naechsten Interrupt schlafen. Setzt ein Interrupt kurz vor dem
+ * Einschlafen ein Flag (z. B. needsUpdateFromRtc), wird es spaetestens
+ * nach dem naechsten Ueberlauf von Timer0 bearbeitet.
+ */
+void SleepScheduler::sleep() {
+    unsigned long start = micros();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sleep_cpu();
+    sleep_disable();
+    unsigned long slept = micros() - start + _asleepMicros;
+    _asleepMillis += slept / 1000;
+    _asleepMicros = slept % 1000;
+    _sleepCount++;
+}
+
+/**
+ * Der Anteil der Zeit (in Prozent), den die Uhr seit reset() geschlafen hat.
+ */
+byte SleepScheduler::getResidency() {
+    unsigned long total = millis() - _since;
+    if (total < 100) {
+        return 0;
+    }
+    return _asleepMillis / (total / 100);
+}
+
+unsigned long SleepScheduler::getSleepCount() {
+    return _sleepCount;
+}
+
+void SleepScheduler::dump() {
+    Serial.print(F("Sleep: "));
+    Serial.print(getResidency());
+    Serial.print(F("% of "));
+    Serial.print((millis() - _since) / 1000);
+    Serial.print(F("s, asleep "));
+    Serial.print(_asleepMillis / 1000);
+    Serial.print(F("s, sleeps "));
+    Serial.println(_sleepCount);
+    Serial.flush();
+}
+
+void SleepScheduler::reset() {
+    _since = millis();
+    _asleepMillis = 0;
+    _asleepMicros = 0;
+    _sleepCount = 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * SleepScheduler
+ * Legt den ATmega zwischen zwei Durchlaeufen von loop() schlafen, solange
+ * die Anzeige aus ist (Nacht, Blank, DCF-Blank). Geschlafen wird im Modus
+ * IDLE: Jeder Interrupt weckt wieder auf, also der Sekundentakt der RTC
+ * (INT0), die Tasten und der IR-Empfaenger (Pin-Change), die UART und
+ * spaetestens der Ueberlauf von Timer0 (alle 1,024ms). Der startet auch den
+ * AnalogSampler (LDR, analoges DCF77-Signal), so wird DCF77 weiterhin ueber
+ * die ganze Sekunde gleichmaessig abgetastet und millis() laeuft weiter.
+ * Nebenbei wird gezaehlt, wie lange die Uhr geschlafen hat.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef SLEEPSCHEDULER_H
+#define SLEEPSCHEDULER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+class SleepScheduler {
+public:
+    SleepScheduler();
+
+    void sleep();
+
+    byte getResidency();
+    unsigned long getSleepCount();
+
+    void dump();
+    void reset();
+
+private:
+    unsigned long _since;
+    unsigned long _asleepMillis;
+    word _asleepMicros;
+    unsigned long _sleepCount;
+};
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * TaskScheduler
+ * Ein kleiner, fester Plan fuer die periodischen Aufgaben in loop(). Die
+ * Aufgaben stehen mit ihrer Periode (in Mikrosekunden) in einer Tabelle im
+ * Flash, hier liegen nur die naechste Faelligkeit und die Anzahl der
+ * Ueberschreitungen. poll() fuehrt nur die faelligen Aufgaben aus, ein
+ * Durchlauf ohne faellige Aufgabe kostet also nur einen Vergleich pro Aufgabe.
+ * Die Faelligkeit wird um die Periode weitergeschoben (kein Weglaufen), eine
+ * verpasste Faelligkeit wird beim naechsten poll() nachgeholt. Ist eine
+ * Aufgabe mehr als eine Periode zu spaet, zaehlt das als Ueberschreitung.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Die Anzahl der Aufgaben wird nicht mehr still begrenzt (static_assert im Sketch).
+ */
+#include "TaskScheduler.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+/**
+ * @param tasks Die Tabelle der Aufgaben im Flash.
+ * @param count Die Anzahl der Aufgaben (hoechstens TASK_SCHEDULER_MAX_TASKS,
+ *        wird im Sketch beim Compilieren geprueft).
+ */
+TaskScheduler::TaskScheduler(const TaskEntry* tasks, byte count) {
+    _tasks = tasks;
+    _count = count;
+}
+
+/**
+ * Alle Aufgaben ab jetzt einplanen (in setup(), wenn micros() laeuft).
+ */
+void TaskScheduler::begin() {
+    unsigned long now = micros();
+    for (byte i = 0; i < _count; i++) {
+        _next[i] = now + pgm_read_dword_near(&_tasks[i].period);
+        _overruns[i] = 0;
+    }
+}
+
+/**
+ * Die faelligen Aufgaben ausfuehren.
+ */
+void TaskScheduler::poll() {
+    for (byte i = 0; i < _count; i++) {
+        unsigned long late = micros() - _next[i];
+        if ((long) late < 0) {
+            continue;
+        }
+        unsigned long period = pgm_read_dword_near(&_tasks[i].period);
+        if ((late >= period) && (_overruns[i] < 0xFFFF)) {
+            _overruns[i]++;
+        }
+        _next[i] += period;
+        ((TaskFunction) pgm_read_ptr_near(&_tasks[i].run))();
+    }
+}
+
+/**
+ * Wie lange (in Mikrosekunden) bis zur naechsten faelligen Aufgabe? 0 = jetzt.
+ */
+unsigned long TaskScheduler::getNextDue() {
+    unsigned long now = micros();
+    unsigned long nextDue = 0xFFFFFFFF;
+    for (byte i = 0; i < _count; i++) {
+        long wait = _next[i] - now;
+        if (wait <= 0) {
+            return 0;
+        }
+        if ((unsigned long) wait < nextDue) {
+            nextDue = wait;
+        }
+    }
+    return nextDue;
+}
+
+word TaskScheduler::getOverruns(byte task) {
+    return _overruns[task];
+}
+
+/**
+ * Perioden und Ueberschreitungen ueber Serial ausgeben.
+ */
+void TaskScheduler::dump() {
+    Serial.println(F("Task period/us overruns"));
+    for (byte i = 0; i < _count; i++) {
+        Serial.print(i);
+        Serial.print(' ');
+        Serial.print(pgm_read_dword_near(&_tasks[i].period));
+        Serial.print(' ');
+        Serial.println(_overruns[i]);
+    }
+    Serial.flush();
+}
@@ -0,0 +1,58 @@
+/**
+ * TaskScheduler
+ * Ein kleiner, fester Plan fuer die periodischen Aufgaben in loop(). Die
+ * Aufgaben stehen mit ihrer Periode (in Mikrosekunden) in einer Tabelle im
+ * Flash, hier liegen nur die naechste Faelligkeit und die Anzahl der
+ * Ueberschreitungen. poll() fuehrt nur die faelligen Aufgaben aus, ein
+ * Durchlauf ohne faellige Aufgabe kostet also nur einen Vergleich pro Aufgabe.
+ * Die Faelligkeit wird um die Periode weitergeschoben (kein Weglaufen), eine
+ * verpasste Faelligkeit wird beim naechsten poll() nachgeholt. Ist eine
+ * Aufgabe mehr als eine Periode zu spaet, zaehlt das als Ueberschreitung.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+#define TASK_SCHEDULER_MAX_TASKS 4
+
+typedef void (*TaskFunction)(void);
+
+/**
+ * Eine Aufgabe in der Tabelle (PROGMEM).
+ */
+struct TaskEntry {
+    unsigned long period;
+    TaskFunction run;
+};
+
+class TaskScheduler {
+public:
+    TaskScheduler(const TaskEntry* tasks, byte count);
+
+    void begin();
+    void poll();
+
+    unsigned long getNextDue();
+    word getOverruns(byte task);
+
+    void dump();
+
+private:
+    const TaskEntry* _tasks;
+    byte _count;
+    unsigned long _next[TASK_SCHEDULER_MAX_TASKS];
+    word _overruns[TASK_SCHEDULER_MAX_TASKS];
+};
+
+#endif
@@ -0,0 +1,239 @@
+/**
+ * TextRenderer
+ * Schreibt Zeichen der Fonts (Staben, Zahlen, ZahlenKlein) an beliebige
+ * Spalten in die Matrix und laesst Texte durchlaufen.
+ * Eine Zeile eines Zeichens wird mit einer Verschiebung des ganzen Wortes
+ * in die Matrix-Zeile geodert, Teile ausserhalb der 11 Spalten fallen weg.
+ * Beim Durchlaufen werden das erste sichtbare Zeichen und seine Spalte
+ * mitgefuehrt, ein Bild kostet so immer nur die (hoechstens vier) sichtbaren
+ * Zeichen, egal wie lang der Text ist.
+ *
+ * Texte: 'A'..'Z', '0'..'9' (klein, 5 Zeilen hoch wie die Staben), ' ', '.', ':', '-'.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include "TextRenderer.h"
+#include "Staben.h"
+#include "Zahlen.h"
+#include "ZahlenKlein.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+// Breite der Fonts in Bit, die linke Spalte ist das hoechste Bit
+#define TEXT_STABEN_WIDTH        5
+#define TEXT_ZIFFERN_WIDTH       5
+#define TEXT_ZIFFERN_KLEIN_WIDTH 4
+
+// Die Spalten der Matrix (x = 0 ist Bit 15, x = 10 ist Bit 5)
+#define TEXT_COLUMNS             11
+#define TEXT_COLUMN_MASK         0b1111111111100000
+
+// Breite eines Leerzeichens
+#define TEXT_SPACE_WIDTH         2
+
+/**
+ * Satzzeichen fuer die Texte, wie die Staben.
+ */
+const char textPunctuation[][5] PROGMEM = {
+    { // 0:Leerzeichen
+        0b00000000,
+        0b00000000,
+        0b00000000,
+        0b00000000,
+        0b00000000
+    }
+    ,
+    { // 1:.
+        0b00000000,
+        0b00000000,
+        0b00000000,
+        0b00000000,
+        0b00010000
+    }
+    ,
+    { // 2::
+        0b00000000,
+        0b00010000,
+        0b00000000,
+        0b00010000,
+        0b00000000
+    }
+    ,
+    { // 3:-
+        0b00000000,
+        0b00000000,
+        0b00011100,
+        0b00000000,
+        0b00000000
+    }
+};
+
+TextRenderer::TextRenderer() {
+    _length = 0;
+}
+
+/**
+ * Ein Stab (A..Z) mit der linken Spalte an x (darf links oder rechts ausserhalb liegen).
+ */
+void TextRenderer::drawStab(char stab, char x, byte y, word matrix[16]) {
+    drawGlyph(staben[stab - 'A'], 5, TEXT_STABEN_WIDTH, x, y, matrix);
+}
+
+/**
+ * Eine grosse Ziffer (7 Zeilen).
+ */
+void TextRenderer::drawDigit(byte number, char x, byte y, word matrix[16]) {
+    drawGlyph(ziffern[number], 7, TEXT_ZIFFERN_WIDTH, x, y, matrix);
+}
+
+/**
+ * Eine kleine Ziffer (5 Zeilen).
+ */
+void TextRenderer::drawSmallDigit(byte number, char x, byte y, word matrix[16]) {
+    drawGlyph(ziffernKlein[number], 5, TEXT_ZIFFERN_KLEIN_WIDTH, x, y, matrix);
+}
+
+/**
+ * Einen Text mit dem ersten Zeichen an x schreiben. Gibt die Breite zurueck.
+ */
+byte TextRenderer::drawString(const char* text, char x, byte y, word matrix[16]) {
+    byte width = 0;
+    byte fontWidth;
+    while (*text) {
+        const char* glyph = getGlyph(*text++, &fontWidth);
+        drawGlyph(glyph, 5, fontWidth, x + width, y, matrix);
+        width += getWidth(glyph, fontWidth) + 1;
+    }
+    return width;
+}
+
+/**
+ * Einen Text von rechts nach links durchlaufen lassen. Ist es der Text, der
+ * gerade laeuft, laeuft er einfach weiter.
+ */
+void TextRenderer::scroll(const char* text, byte y) {
+    if (isScrolling() && (_y == y) && !strncmp(_text, text, TEXT_MAX_LENGTH)) {
+        return;
+    }
+    strncpy(_text, text, TEXT_MAX_LENGTH);
+    _text[TEXT_MAX_LENGTH] = 0;
+    _length = strlen(_text);
+    _y = y;
+    _first = 0;
+    _firstX = TEXT_COLUMNS;
+    _lastStep = millis();
+    DEBUG_PRINT(F("Scrolling "));
+    DEBUG_PRINTLN(_text);
+    DEBUG_FLUSH();
+}
+
+void TextRenderer::stopScroll() {
+    _length = 0;
+}
+
+boolean TextRenderer::isScrolling() {
+    return _length > 0;
+}
+
+/**
+ * Den Text eine Spalte weiter schieben, wenn TEXT_SCROLL_SPEED ms vorbei sind.
+ * Gibt true zurueck, wenn die Anzeige neu geschrieben werden muss.
+ */
+boolean TextRenderer::pollScroll() {
+    if (!isScrolling() || (millis() - _lastStep < TEXT_SCROLL_SPEED)) {
+        return false;
+    }
+    _lastStep = millis();
+    _firstX--;
+
+    // Ist das erste Zeichen (mit Abstand) links hinaus, ist das naechste das erste.
+    byte fontWidth;
+    const char* glyph = getGlyph(_text[_first], &fontWidth);
+    byte width = getWidth(glyph, fontWidth) + 1;
+    if (_firstX + width <= 0) {
+        _first++;
+        _firstX += width;
+        if (_first >= _length) {
+            // Von vorn, wieder von rechts hinein
+            _first = 0;
+            _firstX = TEXT_COLUMNS;
+        }
+    }
+    return true;
+}
+
+/**
+ * Die sichtbaren Zeichen des durchlaufenden Textes schreiben.
+ */
+void TextRenderer::renderScroll(word matrix[16]) {
+    char x = _firstX;
+    byte fontWidth;
+    for (byte i = _first; (i < _length) && (x < TEXT_COLUMNS); i++) {
+        const char* glyph = getGlyph(_text[i], &fontWidth);
+        drawGlyph(glyph, 5, fontWidth, x, _y, matrix);
+        x += getWidth(glyph, fontWidth) + 1;
+    }
+}
+
+/**
+ * Das Zeichen (5 Zeilen hoch) zu einem Buchstaben des Textes.
+ */
+const char* TextRenderer::getGlyph(char c, byte* fontWidth) {
+    *fontWidth = TEXT_STABEN_WIDTH;
+    if ((c >= 'A') && (c <= 'Z')) {
+        return staben[c - 'A'];
+    }
+    if ((c >= '0') && (c <= '9')) {
+        *fontWidth = TEXT_ZIFFERN_KLEIN_WIDTH;
+        return ziffernKlein[c - '0'];
+    }
+    switch (c) {
+        case '.':
+            return textPunctuation[1];
+        case ':':
+            return textPunctuation[2];
+        case '-':
+            return textPunctuation[3];
+    }
+    return textPunctuation[0];
+}
+
+/**
+ * Die Breite eines Zeichens (bis zur letzten benutzten Spalte).
+ */
+byte TextRenderer::getWidth(const char* glyph, byte fontWidth) {
+    byte used = 0;
+    for (byte i = 0; i < 5; i++) {
+        used |= pgm_read_byte_near(glyph + i);
+    }
+    if (!used) {
+        return TEXT_SPACE_WIDTH;
+    }
+    byte width = fontWidth;
+    while (!(used & 1)) {
+        used >>= 1;
+        width--;
+    }
+    return width;
+}
+
+/**
+ * Ein Zeichen mit der linken Spalte an x in die Matrix odern.
+ */
+void TextRenderer::drawGlyph(const char* glyph, byte rows, byte fontWidth, char x, byte y, word matrix[16]) {
+    if ((x <= -fontWidth) || (x >= TEXT_COLUMNS)) {
+        return;
+    }
+    byte shift = 16 - fontWidth - x;
+    for (byte i = 0; i < rows; i++) {
+        matrix[y + i] |= ((word) pgm_read_byte_near(glyph + i) << shift) & TEXT_COLUMN_MASK;
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * TextRenderer
+ * Schreibt Zeichen der Fonts (Staben, Zahlen, ZahlenKlein) an beliebige
+ * Spalten in die Matrix und laesst Texte durchlaufen.
+ * Eine Zeile eines Zeichens wird mit einer Verschiebung des ganzen Wortes
+ * in die Matrix-Zeile geodert, Teile ausserhalb der 11 Spalten fallen weg.
+ * Beim Durchlaufen werden das erste sichtbare Zeichen und seine Spalte
+ * mitgefuehrt, ein Bild kostet so immer nur die (hoechstens vier) sichtbaren
+ * Zeichen, egal wie lang der Text ist.
+ *
+ * Texte: 'A'..'Z', '0'..'9' (klein, 5 Zeilen hoch wie die Staben), ' ', '.', ':', '-'.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#ifndef TEXTRENDERER_H
+#define TEXTRENDERER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+
+// Die Laenge eines durchlaufenden Textes
+#define TEXT_MAX_LENGTH 16
+
+class TextRenderer {
+public:
+    TextRenderer();
+
+    void drawStab(char stab, char x, byte y, word matrix[16]);
+    void drawDigit(byte number, char x, byte y, word matrix[16]);
+    void drawSmallDigit(byte number, char x, byte y, word matrix[16]);
+    byte drawString(const char* text, char x, byte y, word matrix[16]);
+
+    void scroll(const char* text, byte y);
+    void stopScroll();
+    boolean isScrolling();
+    boolean pollScroll();
+    void renderScroll(word matrix[16]);
+
+private:
+    char _text[TEXT_MAX_LENGTH + 1];
+    byte _length;
+    byte _y;
+    // Das erste sichtbare Zeichen und seine Spalte
+    byte _first;
+    char _firstX;
+    unsigned long _lastStep;
+
+    const char* getGlyph(char c, byte* fontWidth);
+    byte getWidth(const char* glyph, byte fontWidth);
+    void drawGlyph(const char* glyph, byte rows, byte fontWidth, char x, byte y, word matrix[16]);
+};
+
+#endif
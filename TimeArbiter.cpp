@@ -0,0 +1,213 @@
+/**
+ * TimeArbiter
+ * Entscheidet, welche Zeitquelle (DCF77, GPS) die Echtzeituhr stellen darf.
+ * Jede Quelle hat eine Bewertung (0..100): Passt ein Sample zu den vorigen
+ * (DCF77Helper), steigt sie, abzueglich der Streuung des Abstands zur RTC
+ * (Jitter). Passt es nicht, und fuer jeden Dekodier- bzw. Pruefsummenfehler,
+ * sinkt sie. Ohne neue Samples verliert sie mit dem Alter an Wert.
+ * Uebernommen wird ein Sample nur von der am besten bewerteten Quelle. Wurde
+ * die RTC vor kurzem gestellt, gelten grosse Abweichungen als Ausreisser, bis
+ * sie sich mit kleinem Jitter ueber mehrere Samples wiederholen (z. B. nach
+ * der Sommerzeitumstellung).
+ * Die Entscheidungen werden nur gezaehlt (dump()), das kostet kaum Zeit.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Ausreisser erst nach TIME_ARBITER_CONFIRM_SAMPLES gleichen Abweichungen
+ *           uebernehmen, unabhaengig von der Bewertung.
+ */
+#include "TimeArbiter.h"
+
+// #define DEBUG
+#include "Debug.h"
+
+/**
+ * Die Namen der Quellen fuer die Ausgabe ueber Serial.
+ */
+const char timeSourceNames[][6] PROGMEM = {
+    "DCF77", "GPS"
+};
+
+/**
+ * Initialisierung.
+ */
+TimeArbiter::TimeArbiter() {
+    memset(_stats, 0, sizeof(_stats));
+    _lastSource = TIME_SOURCE_NONE;
+    _lastSync = 0;
+    _wanted = true;
+    _wakeups = 0;
+}
+
+/**
+ * Ein neues Sample einer Quelle (mit Zeitverschiebung, wie es in die RTC kaeme).
+ *
+ * @param  source: TIME_SOURCE_DCF77 oder TIME_SOURCE_GPS
+ *         agree: passt das Sample zu den vorigen (DCF77Helper::samplesOk())?
+ *         time, seconds: das Sample
+ *         rtc, rtcSeconds: die gerade gelesene Zeit der RTC
+ * @return TRUE, wenn die RTC mit dem Sample gestellt werden soll.
+ */
+boolean TimeArbiter::offer(byte source, boolean agree, TimeStamp* time, byte seconds, TimeStamp* rtc, byte rtcSeconds) {
+    TimeSourceStats* stats = &_stats[source];
+    stats->offers++;
+
+    long offset = ((long) time->getMinutesOfCentury() - (long) rtc->getMinutesOfCentury()) * 60 + seconds - rtcSeconds;
+    offset = constrain(offset, -32767L, 32767L);
+    long jitter = abs(offset - stats->offset);
+    stats->jitter = min(jitter, 0xFFFFL);
+    stats->offset = offset;
+    // Wie oft hintereinander kam (fast) dieselbe Abweichung?
+    if (stats->jitter <= TIME_ARBITER_CONFIRM_JITTER) {
+        if (stats->repeats < 0xFF) {
+            stats->repeats++;
+        }
+    } else {
+        stats->repeats = 1;
+    }
+
+    if (!agree) {
+        stats->disagreements++;
+        _decrease(source, TIME_ARBITER_DISAGREE_MALUS);
+        return false;
+    }
+
+    // Ausreisser gegenueber einer vor kurzem gestellten RTC, bis sich die Abweichung wiederholt
+    long sinceSync = (long) rtc->getMinutesOfCentury() - (long) _lastSync;
+    if ((_lastSource != TIME_SOURCE_NONE) && (sinceSync >= 0) && (sinceSync < TIME_ARBITER_TRUST_MINUTES)
+        && (abs(offset) > TIME_ARBITER_MAX_OFFSET) && (stats->repeats < TIME_ARBITER_CONFIRM_SAMPLES)) {
+        stats->outliers++;
+        DEBUG_PRINT(F("Time arbiter: outlier, offset s "));
+        DEBUG_PRINTLN(offset);
+        return false;
+    }
+
+    byte bonus = TIME_ARBITER_AGREE_BONUS - min(stats->jitter, TIME_ARBITER_AGREE_BONUS / 2);
+    stats->score = min(stats->score + bonus, TIME_ARBITER_MAX_SCORE);
+    stats->lastAgree = time->getMinutesOfCentury();
+
+    // Gibt es eine besser bewertete Quelle?
+    byte score = stats->score;
+    for (byte i = 0; i < TIME_SOURCES; i++) {
+        if ((i != source) && (getScore(i, rtc) > score)) {
+            stats->overruled++;
+            return false;
+        }
+    }
+    if (score < TIME_ARBITER_MIN_SCORE) {
+        return false;
+    }
+
+    stats->accepted++;
+    _lastSource = source;
+    _lastSync = time->getMinutesOfCentury();
+    return true;
+}
+
+/**
+ * Den Fehlerzaehler einer Quelle (Dekodier- bzw. Pruefsummenfehler) melden.
+ * Die neuen Fehler seit der letzten Meldung senken die Bewertung.
+ */
+void TimeArbiter::reportErrors(byte source, word errors) {
+    TimeSourceStats* stats = &_stats[source];
+    word delta = errors - stats->errorsReported;
+    stats->errorsReported = errors;
+    stats->errors += delta;
+    _decrease(source, min(delta, TIME_ARBITER_ERROR_MALUS));
+}
+
+/**
+ * Die Zeit wurde von Hand gestellt, sie gilt als Referenz fuer die Ausreisser.
+ */
+void TimeArbiter::setManual(TimeStamp* rtc) {
+    _lastSource = TIME_SOURCE_MANUAL;
+    _lastSync = rtc->getMinutesOfCentury();
+}
+
+/**
+ * Neu synchronisieren: Die RTC gilt nicht mehr als gestellt.
+ */
+void TimeArbiter::resync() {
+    _lastSource = TIME_SOURCE_NONE;
+}
+
+/**
+ * Ist eine Synchronisation faellig (lohnt es sich, einen Empfaenger einzuschalten)?
+ */
+boolean TimeArbiter::wantsSample(TimeStamp* rtc) {
+    long sinceSync = (long) rtc->getMinutesOfCentury() - (long) _lastSync;
+    boolean wanted = (_lastSource == TIME_SOURCE_NONE) || (sinceSync < 0) || (sinceSync >= TIME_ARBITER_RESYNC_MINUTES);
+    if (wanted && !_wanted) {
+        _wakeups++;
+    }
+    _wanted = wanted;
+    return wanted;
+}
+
+/**
+ * Die Bewertung einer Quelle, abzueglich des Alters des letzten passenden Samples.
+ */
+byte TimeArbiter::getScore(byte source, TimeStamp* rtc) {
+    TimeSourceStats* stats = &_stats[source];
+    long age = ((long) rtc->getMinutesOfCentury() - (long) stats->lastAgree) / TIME_ARBITER_AGE_MINUTES;
+    if (age <= 0) {
+        return stats->score;
+    }
+    if (age >= stats->score) {
+        return 0;
+    }
+    return stats->score - age;
+}
+
+/**
+ * Die Quelle der letzten Synchronisation (TIME_SOURCE_NONE: keine).
+ */
+byte TimeArbiter::getLastSource() {
+    return _lastSource;
+}
+
+void TimeArbiter::_decrease(byte source, byte malus) {
+    TimeSourceStats* stats = &_stats[source];
+    stats->score = (stats->score > malus) ? stats->score - malus : 0;
+}
+
+/**
+ * Die Zaehler ueber Serial ausgeben.
+ */
+void TimeArbiter::dump(TimeStamp* rtc) {
+    Serial.println(F("Time sources (score offers accepted disagree outliers overruled errors offset jitter):"));
+    for (byte i = 0; i < TIME_SOURCES; i++) {
+        TimeSourceStats* stats = &_stats[i];
+        Serial.print((const __FlashStringHelper*) timeSourceNames[i]);
+        Serial.print(' ');
+        Serial.print(getScore(i, rtc));
+        Serial.print(' ');
+        Serial.print(stats->offers);
+        Serial.print(' ');
+        Serial.print(stats->accepted);
+        Serial.print(' ');
+        Serial.print(stats->disagreements);
+        Serial.print(' ');
+        Serial.print(stats->outliers);
+        Serial.print(' ');
+        Serial.print(stats->overruled);
+        Serial.print(' ');
+        Serial.print(stats->errors);
+        Serial.print(' ');
+        Serial.print(stats->offset);
+        Serial.print(' ');
+        Serial.println(stats->jitter);
+    }
+    Serial.print(F("last source "));
+    Serial.print(_lastSource);
+    Serial.print(F(", sync min "));
+    Serial.print(rtc->getMinutesOfCentury() - _lastSync);
+    Serial.print(F(", wakeups "));
+    Serial.println(_wakeups);
+}
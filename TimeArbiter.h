@@ -0,0 +1,104 @@
+/**
+ * TimeArbiter
+ * Entscheidet, welche Zeitquelle (DCF77, GPS) die Echtzeituhr stellen darf.
+ * Jede Quelle hat eine Bewertung (0..100): Passt ein Sample zu den vorigen
+ * (DCF77Helper), steigt sie, abzueglich der Streuung des Abstands zur RTC
+ * (Jitter). Passt es nicht, und fuer jeden Dekodier- bzw. Pruefsummenfehler,
+ * sinkt sie. Ohne neue Samples verliert sie mit dem Alter an Wert.
+ * Uebernommen wird ein Sample nur von der am besten bewerteten Quelle. Wurde
+ * die RTC vor kurzem gestellt, gelten grosse Abweichungen als Ausreisser, bis
+ * sie sich mit kleinem Jitter ueber mehrere Samples wiederholen (z. B. nach
+ * der Sommerzeitumstellung).
+ * Die Entscheidungen werden nur gezaehlt (dump()), das kostet kaum Zeit.
+ *
+ * @mc       Arduino/RBBB
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.1
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ * V 1.1:  - Ausreisser erst nach TIME_ARBITER_CONFIRM_SAMPLES gleichen Abweichungen
+ *           uebernehmen, unabhaengig von der Bewertung.
+ */
+#ifndef TIMEARBITER_H
+#define TIMEARBITER_H
+
+#include "Arduino.h"
+#include "Configuration.h"
+#include "TimeStamp.h"
+
+// Die Quellen
+#define TIME_SOURCE_DCF77  0
+#define TIME_SOURCE_GPS    1
+#define TIME_SOURCES       2
+// Die Zeit wurde von Hand gestellt (nur fuer getLastSource())
+#define TIME_SOURCE_MANUAL 2
+#define TIME_SOURCE_NONE   0xFF
+
+// Die Bewertung
+#define TIME_ARBITER_MAX_SCORE      100
+#define TIME_ARBITER_MIN_SCORE      10
+#define TIME_ARBITER_AGREE_BONUS    20
+#define TIME_ARBITER_DISAGREE_MALUS 40
+#define TIME_ARBITER_ERROR_MALUS    10
+// So viele Minuten ohne passendes Sample kosten einen Punkt.
+#define TIME_ARBITER_AGE_MINUTES    5
+// Eine grosse Abweichung gilt erst, wenn sie so oft hintereinander mit
+// hoechstens TIME_ARBITER_CONFIRM_JITTER Sekunden Jitter kam.
+#define TIME_ARBITER_CONFIRM_SAMPLES 3
+#define TIME_ARBITER_CONFIRM_JITTER  2
+
+#ifndef TIME_ARBITER_TRUST_MINUTES
+    #define TIME_ARBITER_TRUST_MINUTES 1440
+#endif
+#ifndef TIME_ARBITER_MAX_OFFSET
+    #define TIME_ARBITER_MAX_OFFSET 90
+#endif
+#ifndef TIME_ARBITER_RESYNC_MINUTES
+    #define TIME_ARBITER_RESYNC_MINUTES 60
+#endif
+
+struct TimeSourceStats {
+    byte score;
+    word offers;
+    word accepted;
+    word disagreements;
+    word outliers;
+    word overruled;
+    word errors;
+    word errorsReported;
+    int offset;
+    word jitter;
+    byte repeats;
+    unsigned long lastAgree;
+};
+
+class TimeArbiter {
+public:
+    TimeArbiter();
+
+    boolean offer(byte source, boolean agree, TimeStamp* time, byte seconds, TimeStamp* rtc, byte rtcSeconds);
+    void reportErrors(byte source, word errors);
+    void setManual(TimeStamp* rtc);
+    void resync();
+
+    boolean wantsSample(TimeStamp* rtc);
+
+    byte getScore(byte source, TimeStamp* rtc);
+    byte getLastSource();
+
+    void dump(TimeStamp* rtc);
+
+private:
+    TimeSourceStats _stats[TIME_SOURCES];
+    byte _lastSource;
+    unsigned long _lastSync;
+    boolean _wanted;
+    word _wakeups;
+
+    void _decrease(byte source, byte malus);
+};
+
+#endif
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+#
+# gpssim.py
+# Spielt einen GPS-Empfaenger fuer GPS_ENABLE (MyGPS.cpp): Schickt jede Sekunde
+# einen $GPRMC- und einen $GPZDA-Satz mit der aktuellen Zeit (UTC) und richtiger
+# Pruefsumme. Zum Testen ohne Empfaenger bzw. ohne Empfang.
+#
+# Aufruf:
+#   gpssim.py /dev/ttyUSB0 [Optionen]   (braucht pyserial)
+#   gpssim.py - [Optionen]              (auf stdout)
+#
+# Optionen:
+#   --baud N       Geschwindigkeit (Default: 9600, siehe GPS_SERIAL_SPEED)
+#   --offset N     Sekunden, die zur Systemzeit addiert werden (z. B. um die
+#                  Sommerzeitumstellung zu testen)
+#   --invalid      RMC mit Status 'V' (kein Fix), die Uhr darf nichts uebernehmen
+#   --corrupt N    jeden N-ten Satz mit falscher Pruefsumme schicken
+#   --no-rmc       nur ZDA schicken (Empfaenger ohne RMC, braucht GPS_RMC_TIMEOUT)
+#
+# @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+# @version  1.1
+# @created  19.10.2026
+# @updated  19.10.2026
+#
+# Versionshistorie:
+# V 1.0:  - Erstellt.
+# V 1.1:  - Option --no-rmc.
+#
+import argparse
+import datetime
+import sys
+import time
+
+DEFAULT_BAUDRATE = 9600
+
+
+def sentence(body):
+    checksum = 0
+    for c in body.encode('ascii'):
+        checksum ^= c
+    return '$%s*%02X\r\n' % (body, checksum)
+
+
+def sentences(now, valid, rmc_enabled):
+    t = now.strftime('%H%M%S') + '.00'
+    rmc = 'GPRMC,%s,%s,4807.038,N,01131.000,E,0.0,0.0,%s,,,%s' % (
+        t, 'A' if valid else 'V', now.strftime('%d%m%y'), 'A' if valid else 'N')
+    zda = 'GPZDA,%s,%s,%s,%04d,00,00' % (t, now.strftime('%d'), now.strftime('%m'), now.year)
+    if not rmc_enabled:
+        return [sentence(zda)]
+    return [sentence(rmc), sentence(zda)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='NMEA-Saetze (RMC, ZDA) fuer GPS_ENABLE schicken.')
+    parser.add_argument('port', help='serieller Port oder - fuer stdout')
+    parser.add_argument('--baud', type=int, default=DEFAULT_BAUDRATE)
+    parser.add_argument('--offset', type=int, default=0)
+    parser.add_argument('--invalid', action='store_true')
+    parser.add_argument('--corrupt', type=int, default=0)
+    parser.add_argument('--no-rmc', action='store_true')
+    args = parser.parse_args()
+
+    if args.port == '-':
+        def write(s):
+            sys.stdout.write(s)
+            sys.stdout.flush()
+    else:
+        import serial
+        port = serial.Serial(args.port, args.baud)
+
+        def write(s):
+            port.write(s.encode('ascii'))
+
+    count = 0
+    try:
+        while True:
+            # Wie ein echter Empfaenger kurz nach dem Sekundenwechsel senden
+            time.sleep(1.0 - time.time() % 1.0 + 0.1)
+            now = datetime.datetime.now(datetime.timezone.utc) + datetime.timedelta(seconds=args.offset)
+            for s in sentences(now, not args.invalid, not args.no_rmc):
+                count += 1
+                if args.corrupt and count % args.corrupt == 0:
+                    s = s.replace('*', 'X*', 1)
+                write(s)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
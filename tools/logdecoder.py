@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+#
+# logdecoder.py
+# Macht aus den binaeren Log-Eintraegen (DEBUG_BINARY_LOG, BinaryLog.cpp)
+# wieder Text. Die Texte kommen aus LogMessages.h, Text-Ausgaben zwischen den
+# Eintraegen werden unveraendert durchgereicht.
+#
+# Aufruf:
+#   logdecoder.py /dev/ttyUSB0 [Baudrate]   (braucht pyserial)
+#   logdecoder.py mitschnitt.bin
+#   logdecoder.py - < mitschnitt.bin
+#
+# @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+# @version  1.0
+# @created  19.10.2026
+# @updated  19.10.2026
+#
+# Versionshistorie:
+# V 1.0:  - Erstellt.
+#
+import os
+import re
+import struct
+import sys
+
+LOG_SYNC = 0xFE
+DEFAULT_BAUDRATE = 57600
+
+
+def load_messages(path):
+    """Die Texte in der Reihenfolge von LogMessages.h (die Nummer ist die Position)."""
+    messages = []
+    with open(path, encoding='latin-1') as f:
+        for match in re.finditer(r'^LOG_MESSAGE\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', f.read(), re.M):
+            messages.append((match.group(1), match.group(2)))
+    return messages
+
+
+def format_message(text, data):
+    out = []
+    pos = 0
+    i = 0
+    while i < len(text):
+        c = text[i]
+        i += 1
+        if c != '%' or i >= len(text):
+            out.append(c)
+            continue
+        c = text[i]
+        i += 1
+        if c in 'dux':
+            value = struct.unpack_from('<h' if c == 'd' else '<H', data, pos)[0] if pos + 1 < len(data) else 0
+            pos += 2
+            out.append('%X' % value if c == 'x' else str(value))
+        elif c == 'W':
+            values = []
+            while pos + 1 < len(data):
+                values.append(str(struct.unpack_from('<H', data, pos)[0]))
+                pos += 2
+            out.append(' '.join(values))
+        elif c == 'B':
+            out.append(' '.join('%02X' % b for b in data[pos:]))
+            pos = len(data)
+        elif c == 'P':
+            out.append(''.join(str((b >> bit) & 1) for b in data[pos:] for bit in range(8)))
+            pos = len(data)
+        else:
+            out.append(c)
+    return ''.join(out)
+
+
+def decode(stream, messages, write):
+    time_base = 0
+    last_time = None
+    text = bytearray()
+    while True:
+        b = stream.read(1)
+        if not b:
+            break
+        if b[0] != LOG_SYNC:
+            text += b
+            if b == b'\n':
+                write(text.decode('latin-1'))
+                text = bytearray()
+            continue
+        header = stream.read(4)
+        if len(header) < 4:
+            break
+        msg_id, time, length = header[0], header[1] | (header[2] << 8), header[3]
+        data = stream.read(length)
+        if len(data) < length:
+            break
+        # Die Zeit sind die unteren 16 Bit von millis()
+        if last_time is not None and time < last_time:
+            time_base += 0x10000
+        last_time = time
+        if msg_id < len(messages):
+            line = format_message(messages[msg_id][1], data)
+        else:
+            line = 'Unbekannter Eintrag %d: %s' % (msg_id, data.hex())
+        if text:
+            write(text.decode('latin-1') + '\n')
+            text = bytearray()
+        write('[%10.3f] %s\n' % ((time_base + time) / 1000.0, line))
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.stderr.write(__doc__ or 'logdecoder.py <Port|Datei|-> [Baudrate]\n')
+        sys.exit(1)
+    messages = load_messages(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'LogMessages.h'))
+    source = sys.argv[1]
+    if source == '-':
+        stream = sys.stdin.buffer
+    elif os.path.isfile(source):
+        stream = open(source, 'rb')
+    else:
+        import serial
+        stream = serial.Serial(source, int(sys.argv[2]) if len(sys.argv) > 2 else DEFAULT_BAUDRATE)
+
+    def write(s):
+        sys.stdout.write(s)
+        sys.stdout.flush()
+
+    try:
+        decode(stream, messages, write)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
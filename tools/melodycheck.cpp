@@ -0,0 +1,65 @@
+/**
+ * melodycheck
+ * Spielt die Weckmelodien aus AlarmMelodies.h auf dem PC mit
+ * MelodyStream::render() ab und prueft sie. Fuer jede Melodie werden die Zahl
+ * der Schritte, die Dauer und die Tonzeit ausgegeben. Eine Melodie ohne Ton
+ * oder mit einem Schritt ohne Dauer ist ein Fehler (Rueckgabewert 1).
+ * Endlose Melodien werden nach MAX_STEPS Schritten abgebrochen und so markiert.
+ *
+ * Aufruf (im Verzeichnis tools):
+ *   g++ -I.. -o melodycheck melodycheck.cpp ../MelodyStream.cpp
+ *   ./melodycheck [-v]   (-v gibt zusaetzlich jeden Schritt aus)
+ *
+ * @autor    Christian Aschoff / caschoff _AT_ mac _DOT_ com
+ * @version  1.0
+ * @created  19.10.2026
+ * @updated  19.10.2026
+ *
+ * Versionshistorie:
+ * V 1.0:  - Erstellt.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "AlarmMelodies.h"
+
+#define MAX_STEPS 2000
+#define FREQUENCY 2000
+
+int main(int argc, char* argv[]) {
+    static MelodyTraceStep trace[MAX_STEPS];
+    bool verbose = (argc > 1) && !strcmp(argv[1], "-v");
+    int errors = 0;
+
+    for (unsigned int i = 0; i < sizeof(alarmMelodies) / sizeof(alarmMelodies[0]); i++) {
+        uint16_t steps = MelodyStream::render(alarmMelodies[i], FREQUENCY, trace, MAX_STEPS);
+        uint32_t toneTime = 0;
+        bool zeroDuration = false;
+        for (uint16_t s = 0; s < steps; s++) {
+            if (trace[s].event == MELODY_EVENT_TONE) {
+                toneTime += trace[s].duration;
+            }
+            if (trace[s].duration == 0) {
+                zeroDuration = true;
+            }
+            if (verbose) {
+                printf("  %8lu ms  %-4s %5u ms  %5u Hz\n", (unsigned long) trace[s].start,
+                        (trace[s].event == MELODY_EVENT_TONE) ? "Ton" : "Rest",
+                        trace[s].duration, trace[s].frequency);
+            }
+        }
+        uint32_t totalTime = steps ? trace[steps - 1].start + trace[steps - 1].duration : 0;
+        const char* result = "ok";
+        if (!toneTime) {
+            result = "FEHLER: kein Ton";
+            errors++;
+        } else if (zeroDuration) {
+            result = "FEHLER: Schritt ohne Dauer";
+            errors++;
+        }
+        printf("Melodie %u: %u Schritte%s, %lu ms, davon %lu ms Ton: %s\n", i, steps,
+                (steps == MAX_STEPS) ? " (endlos)" : "", (unsigned long) totalTime,
+                (unsigned long) toneTime, result);
+    }
+    return errors ? 1 : 0;
+}